@@ -231,6 +231,7 @@ export declare const enum EOutputCode {
     NoSpace = -7
 }
 export declare const Global: IGlobal;
+export declare const SceneCollection: ISceneCollection;
 export declare const OutputFactory: IOutputFactory;
 export declare const AudioEncoderFactory: IAudioEncoderFactory;
 export declare const VideoEncoderFactory: IVideoEncoderFactory;
@@ -272,6 +273,24 @@ export interface ICropInfo {
     readonly top: number;
     readonly bottom: number;
 }
+export interface ISceneItemTransform {
+    readonly item: ISceneItem;
+    readonly id: number;
+    readonly position: IVec2;
+    readonly rotation: number;
+    readonly scale: IVec2;
+    readonly alignment: EAlignment;
+    readonly boundsType: EBoundsType;
+    readonly boundsAlignment: number;
+    readonly bounds: IVec2;
+    readonly crop: ICropInfo;
+    readonly visible: boolean;
+    readonly selected: boolean;
+}
+export interface ISceneDuplicateResult {
+    readonly scene: IScene;
+    readonly items: ISceneItemTransform[];
+}
 export interface IVideoInfo {
     readonly graphicsModule: string;
     readonly fpsNum: number;
@@ -297,12 +316,19 @@ export interface IDisplayInit {
     format: EColorFormat;
     zsformat: EZStencilFormat;
 }
+export interface IBatchNumber {
+    type: 'int32' | 'uint32' | 'int64' | 'uint64' | 'float' | 'double';
+    value: number;
+}
+export declare type TBatchArgument = string | Uint8Array | IBatchNumber;
+export declare type TBatchCall = [string, string, TBatchArgument[]];
 export interface IIPC {
     setServerPath(binaryPath: string, workingDirectoryPath?: string): void;
     connect(uri: string): void;
     host(uri: string): void;
     connectOrHost(uri: string): void;
     disconnect(): void;
+    callBatch(calls: TBatchCall[]): (number | string | Uint8Array | null)[][];
 }
 export interface IGlobal {
     startup(locale: string, path?: string): void;
@@ -316,6 +342,35 @@ export interface IGlobal {
     locale: string;
     readonly version: number;
 }
+export interface ISceneCollection {
+    load(data: string, threads?: number): ISceneCollectionLoadResult;
+    save(): ISceneCollectionSaveResult;
+}
+export interface ISceneCollectionLoadResult {
+    readonly sources: {
+        [name: string]: ISource;
+    };
+    readonly filters: {
+        [name: string]: IFilter[];
+    };
+    readonly items: {
+        [scene: string]: ISceneItem[];
+    };
+    readonly timings: {
+        parse: number;
+        create: number;
+        load: number;
+        map: number;
+    };
+    readonly threads: number;
+}
+export interface ISceneCollectionSaveResult {
+    readonly data: string;
+    readonly timings: {
+        collect: number;
+        serialize: number;
+    };
+}
 export interface IBooleanProperty extends IProperty {
 }
 export interface IColorProperty extends IProperty {
@@ -473,9 +528,17 @@ export interface IFilter extends ISource {
 }
 export interface IInputFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
+    setFilterChain(inputs: IInput[], chain: IFilterLink[]): IFilter[][];
+}
+export interface IFilterLink {
+    readonly type: string;
+    readonly name: string;
+    readonly settings?: ISettings;
+    readonly enabled?: boolean;
 }
 export declare const enum EInteractionFlags {
     None = 0,
@@ -528,6 +591,7 @@ export interface IInput extends ISource {
     sendKeyClick(eventData: IKeyEvent, keyUp: boolean): void;
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
+    setFilterChain(chain: IFilterLink[]): IFilter[];
     readonly filters: IFilter[];
     readonly width: number;
     readonly height: number;
@@ -539,12 +603,16 @@ export interface ISceneFactory {
 }
 export interface IScene extends ISource {
     duplicate(name: string, type: ESceneDupType): IScene;
+    duplicateAsync(name: string, type: ESceneDupType): Promise<IScene>;
+    duplicateWithItems(name: string, type: ESceneDupType): ISceneDuplicateResult;
     add(source: IInput): ISceneItem;
     readonly source: IInput;
     moveItem(oldIndex: number, newIndex: number): void;
     findItem(id: string | number): ISceneItem;
     getItemAtIdx(idx: number): ISceneItem;
     getItems(): ISceneItem[];
+    getItemsTransforms(): ISceneItemTransform[];
+    setItemsTransforms(transforms: ISceneItemTransform[]): void;
     connect(sigType: ESceneSignalType, cb: (info: ISettings) => void): ICallbackData;
     disconnect(data: ICallbackData): void;
 }
@@ -621,7 +689,7 @@ export interface IVolmeter {
     updateInterval: number;
     attach(source: IInput): void;
     detach(): void;
-    addCallback(cb: (magnitude: number[], peak: number[], inputPeak: number[]) => void): ICallbackData;
+    addCallback(cb: (magnitude: Float32Array, peak: Float32Array, inputPeak: Float32Array) => void): ICallbackData;
     removeCallback(cbData: ICallbackData): void;
 }
 export interface ICallbackData {
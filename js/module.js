@@ -12,6 +12,7 @@ exports.DefaultPluginPath = path.resolve(__dirname, `obs-plugins`);
 exports.DefaultPluginDataPath = path.resolve(__dirname, `data/obs-plugins/%module%`);
 ;
 exports.Global = obs.Global;
+exports.SceneCollection = obs.SceneCollection;
 exports.OutputFactory = obs.Output;
 exports.AudioEncoderFactory = obs.AudioEncoder;
 exports.VideoEncoderFactory = obs.VideoEncoder;
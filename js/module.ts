@@ -313,6 +313,7 @@ export const enum EOutputCode {
 }
 
 export const Global: IGlobal = obs.Global;
+export const SceneCollection: ISceneCollection = obs.SceneCollection;
 export const OutputFactory: IOutputFactory = obs.Output;
 export const AudioEncoderFactory: IAudioEncoderFactory = obs.AudioEncoder;
 export const VideoEncoderFactory: IVideoEncoderFactory = obs.VideoEncoder;
@@ -377,6 +378,35 @@ export interface ICropInfo {
     readonly bottom: number;
 }
 
+/**
+ * Full transform state of a single scene item as returned by
+ * {@link IScene.getItemsTransforms} and accepted by
+ * {@link IScene.setItemsTransforms}.
+ */
+export interface ISceneItemTransform {
+    readonly item: ISceneItem;
+    readonly id: number;
+    readonly position: IVec2;
+    readonly rotation: number;
+    readonly scale: IVec2;
+    readonly alignment: EAlignment;
+    readonly boundsType: EBoundsType;
+    readonly boundsAlignment: number;
+    readonly bounds: IVec2;
+    readonly crop: ICropInfo;
+    readonly visible: boolean;
+    readonly selected: boolean;
+}
+
+/**
+ * Result of {@link IScene.duplicateWithItems}: the new scene together
+ * with the transforms of all of its items, in scene order.
+ */
+export interface ISceneDuplicateResult {
+    readonly scene: IScene;
+    readonly items: ISceneItemTransform[];
+}
+
 export interface IVideoInfo {
     readonly graphicsModule: string;
     readonly fpsNum: number;
@@ -405,6 +435,17 @@ export interface IDisplayInit {
     zsformat: EZStencilFormat;
 }
 
+/**
+ * Number argument of a batched call, the server selects functions by type.
+ */
+export interface IBatchNumber {
+    type: 'int32' | 'uint32' | 'int64' | 'uint64' | 'float' | 'double';
+    value: number;
+}
+
+export type TBatchArgument = string | Uint8Array | IBatchNumber;
+export type TBatchCall = [string, string, TBatchArgument[]];
+
 /** 
  * Namespace representing the global libobs functionality
  */
@@ -450,6 +491,16 @@ export interface IIPC {
      * Disconnect from a server.
      */
 	disconnect(): void;
+
+    /**
+     * Sends several calls to the server as a single request, they run in order.
+     * @param calls - Collection, function and arguments of each call.
+     * @returns The values each call returned, in the same order.
+	 * @throws SyntaxError if an invalid number of parameters is given.
+	 * @throws TypeError if a call or argument is of invalid type.
+	 * @throws Error if the batch failed.
+     */
+	callBatch(calls: TBatchCall[]): (number | string | Uint8Array | null)[][];
 }
  
 export interface IGlobal {
@@ -523,6 +574,48 @@ export interface IGlobal {
     readonly version: number;
 }
 
+/**
+ * Loads or saves a whole scene collection in a single call.
+ */
+export interface ISceneCollection {
+    /**
+     * Creates every source, filter, scene and scene item of a collection
+     * in one pass. The caller owns the returned sources and releases them
+     * like any other created source.
+     * @param data - Collection as produced by save(), a JSON object with a
+     * 'sources' array in the libobs save format
+     * @param threads - Threads creating inputs in parallel, capped at the
+     * core count and at 8. Only inputs whose type and filter types are known
+     * to be safe to create concurrently use them, 1 (the default) creates
+     * everything one by one
+     */
+    load(data: string, threads?: number): ISceneCollectionLoadResult;
+
+    /**
+     * Serializes every public source, with its filters and scene items.
+     */
+    save(): ISceneCollectionSaveResult;
+}
+
+export interface ISceneCollectionLoadResult {
+    /** Created inputs, scenes and transitions by name */
+    readonly sources: { [name: string]: ISource };
+    /** Filters by the name of the source they belong to */
+    readonly filters: { [name: string]: IFilter[] };
+    /** Scene items by the name of their scene */
+    readonly items: { [scene: string]: ISceneItem[] };
+    /** Milliseconds spent in each phase on the server */
+    readonly timings: { parse: number, create: number, load: number, map: number };
+    /** Threads the sources were created on */
+    readonly threads: number;
+}
+
+export interface ISceneCollectionSaveResult {
+    readonly data: string;
+    /** Milliseconds spent in each phase on the server */
+    readonly timings: { collect: number, serialize: number };
+}
+
 export interface IBooleanProperty extends IProperty {
 
 }
@@ -877,6 +970,13 @@ export interface IInputFactory extends IFactoryTypes {
      */
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
 
+    /**
+     * Same as {@link create} but does not block while the
+     * server instantiates the source
+     * @returns - Promise resolving to the created instance
+     */
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
+
     /**
      * Create a new instance of an ObsInput that's private
      * Private in this context means any function that returns an 
@@ -899,6 +999,29 @@ export interface IInputFactory extends IFactoryTypes {
      * Fetches a list of all public input sources available.
      */
     getPublicSources(): IInput[];
+
+    /**
+     * Apply the same filter chain to several inputs in one call,
+     * see {@link IInput.setFilterChain}
+     * @param inputs - Inputs to apply the chain to
+     * @param chain - Filters in the order they should be applied
+     * @returns - The resulting filters of every input, in input order
+     * @throws - If any filter cannot be created, in which case none of the
+     * inputs is changed
+     */
+    setFilterChain(inputs: IInput[], chain: IFilterLink[]): IFilter[][];
+}
+
+/**
+ * One entry of a filter chain passed to {@link IInput.setFilterChain}.
+ * Filters are matched by name; a filter of another type with the
+ * same name is replaced.
+ */
+export interface IFilterLink {
+    readonly type: string;
+    readonly name: string;
+    readonly settings?: ISettings;
+    readonly enabled?: boolean;
 }
 
 
@@ -1003,6 +1126,16 @@ export interface IInput extends ISource {
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
 
 
+    /**
+     * Make the filters of this input match the given chain. Matching
+     * filters are kept and updated, the rest are removed, created and
+     * reordered in a single call. Filters created this way are owned
+     * by the input.
+     * @param chain - Filters in the order they should be applied
+     * @returns - The resulting filters, in chain order
+     */
+    setFilterChain(chain: IFilterLink[]): IFilter[];
+
     /**
      * Obtain a list of all filters associated with the input source
      */
@@ -1053,6 +1186,23 @@ export interface IScene extends ISource {
      */
     duplicate(name: string, type: ESceneDupType): IScene;
 
+    /**
+     * Same as {@link duplicate} but does not block while the
+     * server copies the scene
+     * @returns - Promise resolving to the duplicated scene
+     */
+    duplicateAsync(name: string, type: ESceneDupType): Promise<IScene>;
+
+    /**
+     * Same as {@link duplicate} but also returns every item of the new
+     * scene with its transform, so no further calls are needed to look
+     * them up. Pair with {@link ESceneDupType.Refs} to share the sources
+     * of the original scene.
+     * @param name - New name of the duplicated scene
+     * @param type - Method of scene item duplication
+     */
+    duplicateWithItems(name: string, type: ESceneDupType): ISceneDuplicateResult;
+
     /**
      * Add an input source to the scene, creating a scene item.
      * @param source - Input source to add to the scene
@@ -1099,6 +1249,21 @@ export interface IScene extends ISource {
      */
     getItems(): ISceneItem[];
 
+    /**
+     * Fetch the transform, crop, visibility and selection state
+     * of every item within the scene in a single call
+     * @returns - The array of item transforms in scene order
+     */
+    getItemsTransforms(): ISceneItemTransform[];
+
+    /**
+     * Apply a batch of item transforms. All items are updated
+     * inside one deferred update so the scene is only
+     * recalculated once.
+     * @param transforms - Transforms of items within this scene
+     */
+    setItemsTransforms(transforms: ISceneItemTransform[]): void;
+
     /**
      * Connect a callback to a particular signal 
      * associated with this scene. 
@@ -1425,12 +1590,14 @@ export interface IVolmeter {
     /**
      * Add a callback to the volmeter. Callback will be called
      * each time volume associated with the attached source changes. 
+     * The arrays are views into a buffer shared by all meters updated
+     * in the same batch, copy them if they need to outlive the callback.
      * @param cb - A callback that occurs when volume changes.
      */
     addCallback(
-        cb: (magnitude: number[],
-             peak: number[],
-             inputPeak: number[]) => void): ICallbackData;
+        cb: (magnitude: Float32Array,
+             peak: Float32Array,
+             inputPeak: Float32Array) => void): ICallbackData;
 
     /**
      * Remove a callback to prevent events from occuring immediately. 
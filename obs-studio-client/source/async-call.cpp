@@ -0,0 +1,205 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "async-call.hpp"
+#include <map>
+#include <mutex>
+#include "controller.hpp"
+#include "error.hpp"
+#include "utility-v8.hpp"
+
+namespace utilv8
+{
+	struct AsyncCallRequest
+	{
+		Nan::Persistent<v8::Promise::Resolver> resolver;
+		async_converter_t                      converter;
+		std::vector<ipc::value>                response;
+		std::string                            cancelled;
+		Nan::AsyncResource*                    resource = nullptr;
+		managed_callback<AsyncCallRequest*>*   runner   = nullptr;
+	};
+
+	// Calls still waiting for the server, keyed by the id handed to the IPC
+	//  layer. A response for an id that is no longer here (because the call
+	//  was cancelled) is dropped without touching the request.
+	static std::mutex                             pending_lock;
+	static std::map<uintptr_t, AsyncCallRequest*> pending;
+	static uintptr_t                              pending_next = 1;
+
+	// Checks every second whether the server went away while calls are pending.
+	static uv_timer_t watchdog;
+	static bool       watchdog_initialized = false;
+
+	static void reject(v8::Local<v8::Promise::Resolver> resolver, ErrorCode error, const std::string& message)
+	{
+		v8::Local<v8::String> text = Nan::New<v8::String>(message).ToLocalChecked();
+		if (error == ErrorCode::InvalidReference) {
+			resolver->Reject(Nan::GetCurrentContext(), v8::Exception::ReferenceError(text));
+		} else {
+			resolver->Reject(Nan::GetCurrentContext(), v8::Exception::Error(text));
+		}
+	}
+
+	// Runs inside the async scope of the call, see settle().
+	static void settle_in_scope(const Nan::FunctionCallbackInfo<v8::Value>& info)
+	{
+		AsyncCallRequest* request = static_cast<AsyncCallRequest*>(info.Data().As<v8::External>()->Value());
+
+		v8::Local<v8::Promise::Resolver> resolver = Nan::New(request->resolver);
+		std::vector<ipc::value>&         response = request->response;
+
+		if (!request->cancelled.empty()) {
+			reject(resolver, ErrorCode::Error, request->cancelled);
+		} else if (response.size() == 0) {
+			reject(resolver, ErrorCode::Error, "Failed to make IPC call, verify IPC status.");
+		} else if ((response.size() == 1) && (response[0].type == ipc::type::Null)) {
+			reject(resolver, ErrorCode::Error, response[0].value_str);
+		} else if ((ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok) {
+			reject(
+			    resolver,
+			    (ErrorCode)response[0].value_union.ui64,
+			    response.size() > 1 ? response[1].value_str : "Unknown error.");
+		} else if (!request->converter) {
+			resolver->Resolve(Nan::GetCurrentContext(), Nan::Undefined());
+		} else {
+			Nan::TryCatch        try_catch;
+			v8::Local<v8::Value> value = request->converter(response);
+			if (try_catch.HasCaught()) {
+				resolver->Reject(Nan::GetCurrentContext(), try_catch.Exception());
+			} else {
+				resolver->Resolve(Nan::GetCurrentContext(), value);
+			}
+		}
+	}
+
+	// Runs on the libuv loop thread. Settling through MakeCallback restores the
+	//  async context of the caller and lets node drain the microtask queue once
+	//  the outermost callback returns, instead of running it re-entrantly.
+	static void settle(void* data, AsyncCallRequest* request)
+	{
+		Nan::HandleScope scope;
+
+		v8::Local<v8::Function> fn =
+		    Nan::GetFunction(Nan::New<v8::FunctionTemplate>(settle_in_scope, Nan::New<v8::External>(request)))
+		        .ToLocalChecked();
+		request->resource->runInAsyncScope(Nan::GetCurrentContext()->Global(), fn, 0, nullptr);
+
+		delete request->resource;
+		request->resolver.Reset();
+		request->runner->finalize();
+		delete request;
+	}
+
+	// Runs on the IPC thread.
+	static void on_response(const void* data, const std::vector<ipc::value>& rval)
+	{
+		AsyncCallRequest* request = nullptr;
+		{
+			std::unique_lock<std::mutex> ul(pending_lock);
+			auto iter = pending.find(reinterpret_cast<uintptr_t>(data));
+			if (iter == pending.end())
+				return;
+			request = iter->second;
+			pending.erase(iter);
+		}
+		request->response = rval;
+		request->runner->queue(request);
+	}
+
+	static void on_watchdog(uv_timer_t* handle)
+	{
+		bool idle;
+		{
+			std::unique_lock<std::mutex> ul(pending_lock);
+			idle = pending.empty();
+		}
+		if (idle) {
+			uv_timer_stop(handle);
+		} else if (!Controller::GetInstance().IsConnected()) {
+			RejectPendingCalls("Lost connection to the server.");
+		}
+	}
+
+	void RejectPendingCalls(const std::string& reason)
+	{
+		std::map<uintptr_t, AsyncCallRequest*> cancelled;
+		{
+			std::unique_lock<std::mutex> ul(pending_lock);
+			cancelled.swap(pending);
+		}
+		for (auto& kv : cancelled) {
+			kv.second->cancelled = reason;
+			kv.second->runner->queue(kv.second);
+		}
+	}
+
+	v8::Local<v8::Promise> CallAsync(
+	    const std::string&      cname,
+	    const std::string&      fname,
+	    std::vector<ipc::value> args,
+	    async_converter_t       converter)
+	{
+		Nan::EscapableHandleScope        scope;
+		v8::Local<v8::Promise::Resolver> resolver =
+		    v8::Promise::Resolver::New(Nan::GetCurrentContext()).ToLocalChecked();
+
+		auto conn = Controller::GetInstance().GetConnection();
+		if (!conn) {
+			reject(resolver, ErrorCode::Error, "Failed to obtain IPC connection.");
+			return scope.Escape(resolver->GetPromise());
+		}
+
+		if (!watchdog_initialized) {
+			uv_timer_init(uv_default_loop(), &watchdog);
+			uv_unref(reinterpret_cast<uv_handle_t*>(&watchdog));
+			watchdog_initialized = true;
+		}
+		if (!uv_is_active(reinterpret_cast<uv_handle_t*>(&watchdog)))
+			uv_timer_start(&watchdog, on_watchdog, 1000, 1000);
+
+		// One uv_async_t per call: it keeps the loop alive exactly as long as
+		//  the call is outstanding and is closed again once settled.
+		AsyncCallRequest* request = new AsyncCallRequest();
+		request->resolver.Reset(resolver);
+		request->converter = converter;
+		request->resource  = new Nan::AsyncResource("obs:CallAsync");
+		request->runner    = new managed_callback<AsyncCallRequest*>();
+		request->runner->set_handler(settle, nullptr);
+
+		uintptr_t id;
+		{
+			std::unique_lock<std::mutex> ul(pending_lock);
+			id          = pending_next++;
+			pending[id] = request;
+		}
+
+		if (!conn->call(cname, fname, std::move(args), on_response, reinterpret_cast<void*>(id))) {
+			{
+				std::unique_lock<std::mutex> ul(pending_lock);
+				pending.erase(id);
+			}
+			delete request->resource;
+			request->resolver.Reset();
+			request->runner->finalize();
+			delete request;
+			reject(resolver, ErrorCode::Error, "Failed to make IPC call, verify IPC status.");
+		}
+
+		return scope.Escape(resolver->GetPromise());
+	}
+} // namespace utilv8
@@ -0,0 +1,49 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <nan.h>
+#include "ipc-value.hpp"
+
+namespace utilv8
+{
+	// Converts a successful response into the value the promise resolves with.
+	//  Runs on the libuv loop thread, so it may create JavaScript objects. The
+	//  error code at index 0 has already been checked at this point.
+	typedef std::function<v8::Local<v8::Value>(const std::vector<ipc::value>& response)> async_converter_t;
+
+	// Issue an IPC call without blocking the calling thread.
+	//
+	// Returns a promise that is settled on the libuv loop once the server has
+	//  answered: it is rejected with the error message of the server (or a
+	//  ReferenceError for ErrorCode::InvalidReference) and otherwise resolved
+	//  with whatever 'converter' returns. Without a converter it resolves with
+	//  undefined. The promise is settled in the async context of the caller.
+	v8::Local<v8::Promise> CallAsync(
+	    const std::string&      cname,
+	    const std::string&      fname,
+	    std::vector<ipc::value> args,
+	    async_converter_t       converter = nullptr);
+
+	// Rejects every call that is still waiting for the server with 'reason'.
+	//  Called when the connection is closed; a lost server process is also
+	//  noticed by a watchdog while calls are pending.
+	void RejectPendingCalls(const std::string& reason);
+} // namespace utilv8
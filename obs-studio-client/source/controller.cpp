@@ -22,6 +22,7 @@
 #include <nan.h>
 #include <sstream>
 #include <string>
+#include "async-call.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -311,15 +312,21 @@ std::shared_ptr<ipc::client> Controller::connect(
 	}
 
 	cl->authenticate();
+	m_uri        = uri;
 	m_connection = cl;
 	return m_connection;
 }
 
 void Controller::disconnect()
 {
+	{
+		std::unique_lock<std::mutex> ul(m_subscription_lock);
+		m_subscription = nullptr;
+	}
+
 	if (m_isServer) {
 		// Attempt soft shut down.
-		m_connection->call_synchronous_helper("System", "Shutdown", {});
+		CallSynchronous(m_connection, "System", "Shutdown", {});
 
 		// Wait for process exit.
 		auto wait_begin = std::chrono::high_resolution_clock::now();
@@ -347,6 +354,8 @@ void Controller::disconnect()
 		m_isServer = false;
 	}
 	m_connection = nullptr;
+
+	utilv8::RejectPendingCalls("Disconnected from the server.");
 }
 
 std::shared_ptr<ipc::client> Controller::GetConnection()
@@ -354,6 +363,101 @@ std::shared_ptr<ipc::client> Controller::GetConnection()
 	return m_connection;
 }
 
+bool Controller::IsConnected()
+{
+	if (!m_connection)
+		return false;
+	return !m_isServer || is_process_alive(procId);
+}
+
+std::shared_ptr<ipc::client> Controller::GetSubscriptionConnection()
+{
+	std::unique_lock<std::mutex> ul(m_subscription_lock);
+	if (m_subscription)
+		return m_subscription;
+
+	if (!m_connection)
+		return nullptr;
+
+	try {
+		m_subscription = std::make_shared<ipc::client>(m_uri);
+	} catch (...) {
+		return nullptr;
+	}
+
+	m_subscription->authenticate();
+	return m_subscription;
+}
+
+std::vector<std::vector<ipc::value>> Controller::CallBatch(const std::vector<osn::batch::call>& calls)
+{
+	std::vector<std::vector<ipc::value>> results;
+	if (!m_connection || calls.empty())
+		return results;
+
+	std::vector<ipc::value> response = CallSynchronous(
+	    m_connection, "Batch", "Execute", std::vector<ipc::value>{ipc::value(osn::batch::serialize_calls(calls))});
+	if ((response.size() < 2) || ((ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok))
+		return results;
+
+	if (!osn::batch::deserialize_results(response[1].value_bin, results) || (results.size() != calls.size()))
+		results.clear();
+	return results;
+}
+
+osn::callstats::registry& Controller::GetCallStats()
+{
+	return m_call_stats;
+}
+
+static std::vector<ipc::value> MeasuredCall(
+    const std::shared_ptr<ipc::client>& conn,
+    osn::callstats::counters&           stats,
+    const std::string&                  cname,
+    const std::string&                  fname,
+    std::vector<ipc::value>             args)
+{
+	osn::callstats::registry& registry = Controller::GetInstance().GetCallStats();
+	uint64_t                  in       = osn::callstats::payload_size(args);
+
+	auto                    start    = std::chrono::steady_clock::now();
+	std::vector<ipc::value> response = conn->call_synchronous_helper(cname, fname, std::move(args));
+	auto                    end      = std::chrono::steady_clock::now();
+
+	bool error = response.empty() || (response[0].type != ipc::type::UInt64)
+	             || (response[0].value_union.ui64 != uint64_t(ErrorCode::Ok));
+	registry.record(
+	    stats,
+	    cname,
+	    fname,
+	    uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count()),
+	    uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()),
+	    in,
+	    osn::callstats::payload_size(response),
+	    error);
+	return response;
+}
+
+std::vector<ipc::value> CallSynchronous(
+    const std::shared_ptr<ipc::client>& conn,
+    const std::string&                  cname,
+    const std::string&                  fname,
+    std::vector<ipc::value>             args)
+{
+	osn::callstats::counters& stats = Controller::GetInstance().GetCallStats().find(cname, fname);
+	return MeasuredCall(conn, stats, cname, fname, std::move(args));
+}
+
+std::vector<ipc::value> CallSynchronous(
+    const std::shared_ptr<ipc::client>& conn,
+    const char*                         cname,
+    const char*                         fname,
+    std::vector<ipc::value>             args)
+{
+	osn::callstats::counters& stats = Controller::GetInstance().GetCallStats().find(cname, fname);
+	return MeasuredCall(conn, stats, cname, fname, std::move(args));
+}
+
 void js_setServerPath(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
 	auto isol = args.GetIsolate();
@@ -478,6 +582,130 @@ void js_disconnect(const v8::FunctionCallbackInfo<v8::Value>& args)
 	Controller::GetInstance().disconnect();
 }
 
+// Strings and Buffers are sent as they are. Numbers need their IPC type, the
+//  server picks the function by it: { type: 'uint64', value: 42 }.
+static bool ToBatchArgument(v8::Local<v8::Value> arg, ipc::value& value)
+{
+	if (arg->IsString()) {
+		value = ipc::value(std::string(*Nan::Utf8String(arg)));
+		return true;
+	}
+	if (node::Buffer::HasInstance(arg)) {
+		const char* data = node::Buffer::Data(arg);
+		value            = ipc::value(std::vector<char>(data, data + node::Buffer::Length(arg)));
+		return true;
+	}
+	if (!arg->IsObject())
+		return false;
+
+	v8::Local<v8::Object> obj = arg.As<v8::Object>();
+	v8::Local<v8::Value>  type, number;
+	if (!Nan::Get(obj, Nan::New("type").ToLocalChecked()).ToLocal(&type) || !type->IsString()
+	    || !Nan::Get(obj, Nan::New("value").ToLocalChecked()).ToLocal(&number) || !number->IsNumber())
+		return false;
+
+	std::string name = *Nan::Utf8String(type);
+	double      v    = Nan::To<double>(number).FromJust();
+	if (name == "int32")
+		value = ipc::value(int32_t(v));
+	else if (name == "uint32")
+		value = ipc::value(uint32_t(v));
+	else if (name == "int64")
+		value = ipc::value(int64_t(v));
+	else if (name == "uint64")
+		value = ipc::value(uint64_t(v));
+	else if (name == "float")
+		value = ipc::value(float(v));
+	else if (name == "double")
+		value = ipc::value(v);
+	else
+		return false;
+	return true;
+}
+
+static v8::Local<v8::Value> FromBatchResult(const ipc::value& value)
+{
+	switch (value.type) {
+	case ipc::type::Float:
+		return Nan::New<v8::Number>(value.value_union.fp32);
+	case ipc::type::Double:
+		return Nan::New<v8::Number>(value.value_union.fp64);
+	case ipc::type::Int32:
+		return Nan::New<v8::Number>(value.value_union.i32);
+	case ipc::type::UInt32:
+		return Nan::New<v8::Number>(value.value_union.ui32);
+	case ipc::type::Int64:
+		return Nan::New<v8::Number>(double(value.value_union.i64));
+	case ipc::type::UInt64:
+		return Nan::New<v8::Number>(double(value.value_union.ui64));
+	case ipc::type::String:
+		return Nan::New<v8::String>(value.value_str).ToLocalChecked();
+	case ipc::type::Binary:
+		return Nan::CopyBuffer(value.value_bin.data(), uint32_t(value.value_bin.size())).ToLocalChecked();
+	default:
+		return Nan::Null();
+	}
+}
+
+void js_callBatch(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto isol = args.GetIsolate();
+	if (args.Length() != 1) {
+		isol->ThrowException(v8::Exception::SyntaxError(
+		    Nan::New<v8::String>("Usage: callBatch(<Array> [collection, function, args][]).").ToLocalChecked()));
+		return;
+	} else if (!args[0]->IsArray()) {
+		isol->ThrowException(v8::Exception::TypeError(
+		    Nan::New<v8::String>("Argument 'calls' must be of type 'Array'.").ToLocalChecked()));
+		return;
+	}
+
+	v8::Local<v8::Array>          list = args[0].As<v8::Array>();
+	std::vector<osn::batch::call> calls(list->Length());
+	for (uint32_t idx = 0; idx < list->Length(); idx++) {
+		v8::Local<v8::Value> entry = Nan::Get(list, idx).ToLocalChecked();
+		v8::Local<v8::Array> call  = entry.As<v8::Array>();
+		if (!entry->IsArray() || (call->Length() != 3) || !Nan::Get(call, 0).ToLocalChecked()->IsString()
+		    || !Nan::Get(call, 1).ToLocalChecked()->IsString() || !Nan::Get(call, 2).ToLocalChecked()->IsArray()) {
+			isol->ThrowException(v8::Exception::TypeError(
+			    Nan::New<v8::String>("Each call must be [<string> collection, <string> function, <Array> args].")
+			        .ToLocalChecked()));
+			return;
+		}
+
+		calls[idx].collection = *Nan::Utf8String(Nan::Get(call, 0).ToLocalChecked());
+		calls[idx].function   = *Nan::Utf8String(Nan::Get(call, 1).ToLocalChecked());
+
+		v8::Local<v8::Array> call_args = Nan::Get(call, 2).ToLocalChecked().As<v8::Array>();
+		calls[idx].args.resize(call_args->Length());
+		for (uint32_t arg = 0; arg < call_args->Length(); arg++) {
+			if (!ToBatchArgument(Nan::Get(call_args, arg).ToLocalChecked(), calls[idx].args[arg])) {
+				isol->ThrowException(v8::Exception::TypeError(
+				    Nan::New<v8::String>(
+				        "Arguments must be a String, a Buffer or { type: 'int32' | 'uint32' | 'int64' | 'uint64' | "
+				        "'float' | 'double', value: number }.")
+				        .ToLocalChecked()));
+				return;
+			}
+		}
+	}
+
+	std::vector<std::vector<ipc::value>> results = Controller::GetInstance().CallBatch(calls);
+	if (results.size() != calls.size()) {
+		isol->ThrowException(v8::Exception::Error(Nan::New<v8::String>("Batch call failed.").ToLocalChecked()));
+		return;
+	}
+
+	v8::Local<v8::Array> rval = Nan::New<v8::Array>(uint32_t(results.size()));
+	for (uint32_t idx = 0; idx < results.size(); idx++) {
+		v8::Local<v8::Array> values = Nan::New<v8::Array>(uint32_t(results[idx].size()));
+		for (uint32_t value = 0; value < results[idx].size(); value++)
+			Nan::Set(values, value, FromBatchResult(results[idx][value]));
+		Nan::Set(rval, idx, values);
+	}
+	args.GetReturnValue().Set(rval);
+}
+
 INITIALIZER(js_ipc)
 {
 	initializerFunctions.push([](v8::Local<v8::Object>& exports) {
@@ -488,6 +716,7 @@ INITIALIZER(js_ipc)
 		NODE_SET_METHOD(obj, "host", js_host);
 		NODE_SET_METHOD(obj, "connectOrHost", js_connectOrHost);
 		NODE_SET_METHOD(obj, "disconnect", js_disconnect);
+		NODE_SET_METHOD(obj, "callBatch", js_callBatch);
 		// Temporary
 		NODE_SET_METHOD(obj, "ConnectOrHost", js_connectOrHost);
 		NODE_SET_METHOD(obj, "Disconnect", js_disconnect);
@@ -17,7 +17,11 @@
 
 #pragma once
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+#include "call-stats.hpp"
+#include "ipc-batch.hpp"
 #include "ipc-client.hpp"
 
 #ifdef _WIN32
@@ -71,8 +75,42 @@ class Controller
 
 	std::shared_ptr<ipc::client> GetConnection();
 
+	// False once disconnected or, for a hosted server, once its process died.
+	bool IsConnected();
+
+	// Secondary connection for calls that block on the server until data is
+	//  available, so that they never stall calls made on the main connection.
+	std::shared_ptr<ipc::client> GetSubscriptionConnection();
+
+	// Send several calls to the server as a single request, they are executed
+	//  in order and each result is in the same form call_synchronous_helper
+	//  would have returned. Returns an empty vector if the batch itself failed.
+	std::vector<std::vector<ipc::value>> CallBatch(const std::vector<osn::batch::call>& calls);
+
+	// Client side counters of every call made through CallSynchronous.
+	osn::callstats::registry& GetCallStats();
+
 	private:
 	bool                         m_isServer = false;
+	std::string                  m_uri;
 	std::shared_ptr<ipc::client> m_connection;
+	std::shared_ptr<ipc::client> m_subscription;
+	std::mutex                   m_subscription_lock;
 	ProcessInfo                  procId;
+	osn::callstats::registry     m_call_stats;
 };
+
+// Same as conn->call_synchronous_helper, but measured in the client side call
+//  statistics. Use this for every synchronous call.
+std::vector<ipc::value> CallSynchronous(
+    const std::shared_ptr<ipc::client>& conn,
+    const std::string&                  cname,
+    const std::string&                  fname,
+    std::vector<ipc::value>             args);
+// For string literals, which is most call sites: the statistics entry is
+//  cached per call site instead of looked up by name on every call.
+std::vector<ipc::value> CallSynchronous(
+    const std::shared_ptr<ipc::client>& conn,
+    const char*                         cname,
+    const char*                         fname,
+    std::vector<ipc::value>             args);
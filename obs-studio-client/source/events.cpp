@@ -0,0 +1,156 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "events.hpp"
+#include <chrono>
+#include <iterator>
+#include "controller.hpp"
+#include "error.hpp"
+#include "ipc-batch.hpp"
+
+// Maximum time the server holds a poll open when nothing happens. Anything
+//  published, Events.Interrupt and a server shutting down all end it early.
+#define EVENTS_POLL_TIMEOUT_MS 10000
+// Pause before polling again after the connection or the poll failed.
+#define EVENTS_RETRY_MS 50
+
+const std::chrono::seconds osn::Events::BacklogLifetime = std::chrono::seconds(30);
+
+std::map<EventType, osn::Events::handler_t>                 osn::Events::m_handlers;
+std::map<EventType, std::deque<osn::Events::pending_event>> osn::Events::m_backlog;
+std::mutex                                                  osn::Events::m_handlers_lock;
+std::thread                                                 osn::Events::m_worker;
+bool                                                        osn::Events::m_worker_stop     = true;
+uint64_t                                                    osn::Events::m_server_dropped  = 0;
+uint64_t                                                    osn::Events::m_backlog_dropped = 0;
+
+void osn::Events::Subscribe(EventType type, handler_t handler)
+{
+	{
+		std::unique_lock<std::mutex> ul(m_handlers_lock);
+		m_handlers[type] = handler;
+
+		expire_backlog();
+		auto backlog = m_backlog.find(type);
+		if (backlog != m_backlog.end()) {
+			for (pending_event& pending : backlog->second)
+				handler(pending.event);
+			m_backlog.erase(backlog);
+		}
+	}
+
+	if (!m_worker_stop)
+		return;
+
+	// Launch worker thread.
+	m_worker_stop = false;
+	m_worker      = std::thread(worker);
+}
+
+void osn::Events::Unsubscribe(EventType type)
+{
+	{
+		std::unique_lock<std::mutex> ul(m_handlers_lock);
+		m_handlers.erase(type);
+		if (!m_handlers.empty())
+			return;
+	}
+
+	if (m_worker_stop != false)
+		return;
+
+	// Stop worker thread, its poll would otherwise be held for the full timeout.
+	m_worker_stop = true;
+	auto conn     = Controller::GetInstance().GetConnection();
+	if (conn)
+		CallSynchronous(conn, "Events", "Interrupt", {});
+	if (m_worker.joinable()) {
+		m_worker.join();
+	}
+}
+
+uint64_t osn::Events::Dropped()
+{
+	std::unique_lock<std::mutex> ul(m_handlers_lock);
+	return m_server_dropped + m_backlog_dropped;
+}
+
+// Called with m_handlers_lock held.
+void osn::Events::expire_backlog()
+{
+	auto oldest = std::chrono::steady_clock::now() - BacklogLifetime;
+	for (auto iter = m_backlog.begin(); iter != m_backlog.end();) {
+		std::deque<pending_event>& queue = iter->second;
+		while (!queue.empty() && (queue.front().received < oldest)) {
+			queue.pop_front();
+			m_backlog_dropped++;
+		}
+		iter = queue.empty() ? m_backlog.erase(iter) : std::next(iter);
+	}
+}
+
+void osn::Events::worker()
+{
+	while (!m_worker_stop) {
+		// The poll blocks on the server, so it must not use the main connection.
+		auto conn = Controller::GetInstance().GetSubscriptionConnection();
+		if (!conn) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(EVENTS_RETRY_MS));
+			continue;
+		}
+
+		std::vector<ipc::value> response;
+		try {
+			response = CallSynchronous(conn, "Events", "Poll", {ipc::value((uint32_t)EVENTS_POLL_TIMEOUT_MS)});
+		} catch (...) {
+			response.clear();
+		}
+		if ((response.size() < 2) || (response[0].type == ipc::type::Null)
+		    || ((ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(EVENTS_RETRY_MS));
+			continue;
+		}
+
+		std::vector<std::vector<ipc::value>> events;
+		if (!osn::batch::deserialize_results(response[1].value_bin, events))
+			continue;
+
+		std::unique_lock<std::mutex> ul(m_handlers_lock);
+		if (response.size() > 2)
+			m_server_dropped = response[2].value_union.ui64;
+		expire_backlog();
+		for (std::vector<ipc::value>& event : events) {
+			if (event.empty())
+				continue;
+
+			EventType type = EventType(event[0].value_union.ui32);
+			event.erase(event.begin());
+
+			auto iter = m_handlers.find(type);
+			if (iter != m_handlers.end()) {
+				iter->second(event);
+			} else if (type != EventType::VolMeter) {
+				std::deque<pending_event>& queue = m_backlog[type];
+				if (queue.size() >= MaxBacklog) {
+					queue.pop_front();
+					m_backlog_dropped++;
+				}
+				queue.push_back(pending_event{std::chrono::steady_clock::now(), std::move(event)});
+			}
+		}
+	}
+}
@@ -0,0 +1,75 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "event-type.hpp"
+#include "ipc-value.hpp"
+
+namespace osn
+{
+	// Single dispatcher for everything the server publishes through Events.Poll.
+	//
+	// One thread long-polls the server on the subscription connection and hands
+	//  each event to the handler registered for its type. Handlers run on that
+	//  thread, not on the v8 thread, so they are expected to only queue the
+	//  data for their own managed_callback. The thread only runs while at least
+	//  one handler is registered; events nobody listens to yet are kept and
+	//  replayed on Subscribe, except for level frames which are only useful live.
+	//  That backlog is bounded per type and expires, dropping the oldest first.
+	class Events
+	{
+		public:
+		// 'event' is the payload without the leading type tag.
+		typedef std::function<void(std::vector<ipc::value>& event)> handler_t;
+
+		static const size_t               MaxBacklog = 256;
+		static const std::chrono::seconds BacklogLifetime;
+
+		static void Subscribe(EventType type, handler_t handler);
+
+		// Once this returns the handler is guaranteed to not be running anymore.
+		static void Unsubscribe(EventType type);
+
+		// Events dropped by the server queue plus those dropped from the backlog.
+		static uint64_t Dropped();
+
+		private:
+		struct pending_event
+		{
+			std::chrono::steady_clock::time_point received;
+			std::vector<ipc::value>               event;
+		};
+
+		static std::map<EventType, handler_t>                  m_handlers;
+		static std::map<EventType, std::deque<pending_event>> m_backlog;
+		static std::mutex                                      m_handlers_lock;
+		static std::thread                                     m_worker;
+		static bool                                            m_worker_stop;
+		static uint64_t                                        m_server_dropped;
+		static uint64_t                                        m_backlog_dropped;
+
+		static void expire_backlog();
+		static void worker();
+	};
+} // namespace osn
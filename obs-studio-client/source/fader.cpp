@@ -81,7 +81,8 @@ void osn::Fader::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper(
+	std::vector<ipc::value> rval = CallSynchronous(
+	    conn,
 	    "Fader",
 	    "Create",
 	    {
@@ -133,7 +134,8 @@ void osn::Fader::GetDeziBel(Nan::NAN_METHOD_ARGS_TYPE info)
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper(
+	std::vector<ipc::value> rval = CallSynchronous(
+	    conn,
 	    "Fader",
 	    "GetDeziBel",
 	    {
@@ -186,7 +188,7 @@ void osn::Fader::SetDezibel(Nan::NAN_METHOD_ARGS_TYPE info)
 
 	// Call
 	std::vector<ipc::value> rval =
-	    conn->call_synchronous_helper("Fader", "SetDeziBel", {ipc::value(fader->uid), ipc::value(dezibel)});
+	    CallSynchronous(conn, "Fader", "SetDeziBel", {ipc::value(fader->uid), ipc::value(dezibel)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -231,7 +233,8 @@ void osn::Fader::GetDeflection(Nan::NAN_METHOD_ARGS_TYPE info)
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper(
+	std::vector<ipc::value> rval = CallSynchronous(
+	    conn,
 	    "Fader",
 	    "GetDeflection",
 	    {
@@ -284,7 +287,7 @@ void osn::Fader::SetDeflection(Nan::NAN_METHOD_ARGS_TYPE info)
 
 	// Call
 	std::vector<ipc::value> rval =
-	    conn->call_synchronous_helper("Fader", "SetDeflection", {ipc::value(fader->uid), ipc::value(dezibel)});
+	    CallSynchronous(conn, "Fader", "SetDeflection", {ipc::value(fader->uid), ipc::value(dezibel)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -329,7 +332,8 @@ void osn::Fader::GetMultiplier(Nan::NAN_METHOD_ARGS_TYPE info)
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper(
+	std::vector<ipc::value> rval = CallSynchronous(
+	    conn,
 	    "Fader",
 	    "GetMultiplier",
 	    {
@@ -382,7 +386,7 @@ void osn::Fader::SetMultiplier(Nan::NAN_METHOD_ARGS_TYPE info)
 
 	// Call
 	std::vector<ipc::value> rval =
-	    conn->call_synchronous_helper("Fader", "SetMultiplier", {ipc::value(fader->uid), ipc::value(dezibel)});
+	    CallSynchronous(conn, "Fader", "SetMultiplier", {ipc::value(fader->uid), ipc::value(dezibel)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -435,7 +439,7 @@ void osn::Fader::Attach(Nan::NAN_METHOD_ARGS_TYPE info)
 
 	// Call
 	std::vector<ipc::value> rval =
-	    conn->call_synchronous_helper("Fader", "Attach", {ipc::value(fader->uid), ipc::value(source->sourceId)});
+	    CallSynchronous(conn, "Fader", "Attach", {ipc::value(fader->uid), ipc::value(source->sourceId)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -477,7 +481,7 @@ void osn::Fader::Detach(Nan::NAN_METHOD_ARGS_TYPE info)
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper("Fader", "Detach", {ipc::value(fader->uid)});
+	std::vector<ipc::value> rval = CallSynchronous(conn, "Fader", "Detach", {ipc::value(fader->uid)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -551,7 +555,8 @@ void osn::Fader::OBS_Fader_ReleaseFaders(const v8::FunctionCallbackInfo<v8::Valu
 	for (auto& fader : faders) {
 
 		// Call
-		std::vector<ipc::value> rval = conn->call_synchronous_helper(
+		std::vector<ipc::value> rval = CallSynchronous(
+		    conn,
 		    "Fader",
 		    "Destroy",
 		    {
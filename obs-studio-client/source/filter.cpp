@@ -57,7 +57,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Filter::Types(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Filter", "Types", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Filter", "Types", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -107,7 +107,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Filter::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 		}
 	}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Filter", "Create", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Filter", "Create", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -52,7 +52,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::getOutputSource(Nan::NAN_METHOD_ARGS_TY
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Global", "GetOutputSource", {ipc::value(channel)});
+	    CallSynchronous(conn, "Global", "GetOutputSource", {ipc::value(channel)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -92,8 +92,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::setOutputSource(Nan::NAN_METHOD_ARGS_TY
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Global", "SetOutputSource", {ipc::value(channel), ipc::value(source ? source->sourceId : UINT64_MAX)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Global", "SetOutputSource", {ipc::value(channel), ipc::value(source ? source->sourceId : UINT64_MAX)});
 
 	ValidateResponse(response);
 }
@@ -110,7 +110,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::getOutputFlagsFromId(Nan::NAN_METHOD_AR
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Global", "GetOutputFlagsFromId", {ipc::value(id)});
+	    CallSynchronous(conn, "Global", "GetOutputFlagsFromId", {ipc::value(id)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -124,7 +124,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::laggedFrames(Nan::NAN_METHOD_ARGS_TYPE
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "LaggedFrames", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Global", "LaggedFrames", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -138,7 +138,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::totalFrames(Nan::NAN_METHOD_ARGS_TYPE i
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "TotalFrames", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Global", "TotalFrames", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -152,7 +152,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::getLocale(Nan::NAN_METHOD_ARGS_TYPE inf
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "GetLocale", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Global", "GetLocale", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -171,7 +171,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Global::setLocale(Nan::NAN_METHOD_ARGS_TYPE inf
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "SetLocale", {ipc::value(locale)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Global", "SetLocale", {ipc::value(locale)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -17,8 +17,10 @@
 
 #include "input.hpp"
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "filter.hpp"
@@ -43,9 +45,11 @@ void osn::Input::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	// Function Template
 	utilv8::SetTemplateField(fnctemplate, "types", Types);
 	utilv8::SetTemplateField(fnctemplate, "create", Create);
+	utilv8::SetTemplateField(fnctemplate, "createAsync", CreateAsync);
 	utilv8::SetTemplateField(fnctemplate, "createPrivate", CreatePrivate);
 	utilv8::SetTemplateField(fnctemplate, "fromName", FromName);
 	utilv8::SetTemplateField(fnctemplate, "getPublicSources", GetPublicSources);
+	utilv8::SetTemplateField(fnctemplate, "setFilterChain", SetFilterChains);
 
 	// Prototype Template
 
@@ -70,6 +74,7 @@ void osn::Input::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	utilv8::SetTemplateField(objtemplate, "setFilterOrder", SetFilterOrder);
 	utilv8::SetTemplateField(objtemplate, "findFilter", FindFilter);
 	utilv8::SetTemplateField(objtemplate, "copyFilters", CopyFilters);
+	utilv8::SetTemplateField(objtemplate, "setFilterChain", SetFilterChain);
 
 	// Stuff
 	utilv8::SetObjectField(target, "Input", fnctemplate->GetFunction());
@@ -85,7 +90,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Types(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Types", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "Types", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -99,7 +104,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Types(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(utilv8::ToValue<std::string>(types));
 }
 
-Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
+// Shared by Create and CreateAsync, the latter returns a promise instead of blocking.
+static void CreateImpl(Nan::NAN_METHOD_ARGS_TYPE info, bool async)
 {
 	std::string           type;
 	std::string           name;
@@ -148,7 +154,16 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 		}
 	}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Create", {std::move(params)});
+	if (async) {
+		info.GetReturnValue().Set(
+		    utilv8::CallAsync("Input", "Create", std::move(params), [](const std::vector<ipc::value>& response) {
+			    osn::Input* obj = new osn::Input(response[1].value_union.ui64);
+			    return v8::Local<v8::Value>(osn::Input::Store(obj));
+		    }));
+		return;
+	}
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "Create", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -158,6 +173,16 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(osn::Input::Store(obj));
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::Create(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	CreateImpl(info, false);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreateAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	CreateImpl(info, true);
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	std::string           type;
@@ -192,7 +217,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE
 		}
 	}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "CreatePrivate", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "CreatePrivate", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -214,7 +239,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::FromName(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "FromName", {ipc::value(name)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "FromName", {ipc::value(name)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -230,7 +255,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetPublicSources(Nan::NAN_METHOD_ARGS_TY
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetPublicSources", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "GetPublicSources", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -281,7 +306,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Duplicate(Nan::NAN_METHOD_ARGS_TYPE info
 		params.push_back(ipc::value(is_private));
 	}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Duplicate", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "Duplicate", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -306,7 +331,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Active(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetActive", {ipc::value(obj->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "GetActive", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -332,7 +357,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Showing(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetShowing", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetShowing", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -357,7 +382,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Width(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetWidth", {ipc::value(obj->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "GetWidth", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -381,7 +406,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Height(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetHeight", {ipc::value(obj->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "GetHeight", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -405,7 +430,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetVolume(Nan::NAN_METHOD_ARGS_TYPE info
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetVolume", {ipc::value(obj->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Input", "GetVolume", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -434,7 +459,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetVolume(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "SetVolume", {ipc::value(obj->sourceId), ipc::value(volume)});
+	    CallSynchronous(conn, "Input", "SetVolume", {ipc::value(obj->sourceId), ipc::value(volume)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -460,7 +485,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetSyncOffset(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetSyncOffset", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetSyncOffset", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -501,7 +526,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetSyncOffset(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "SetSyncOffset", {ipc::value(obj->sourceId), ipc::value(syncoffset)});
+	    CallSynchronous(conn, "Input", "SetSyncOffset", {ipc::value(obj->sourceId), ipc::value(syncoffset)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -526,7 +551,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetAudioMixers(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetAudioMixers", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetAudioMixers", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -555,7 +580,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetAudioMixers(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "SetAudioMixers", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
+	    CallSynchronous(conn, "Input", "SetAudioMixers", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -580,7 +605,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetMonitoringType(Nan::NAN_METHOD_ARGS_T
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetMonitoringType", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetMonitoringType", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -608,8 +633,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetMonitoringType(Nan::NAN_METHOD_ARGS_T
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Input", "SetMonitoringType", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Input", "SetMonitoringType", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -634,7 +659,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetDeinterlaceFieldOrder(Nan::NAN_METHOD
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetDeInterlaceFieldOrder", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetDeInterlaceFieldOrder", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -662,8 +687,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetDeinterlaceFieldOrder(Nan::NAN_METHOD
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Input", "SetDeInterlaceFieldOrder", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Input", "SetDeInterlaceFieldOrder", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -689,7 +714,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::GetDeinterlaceMode(Nan::NAN_METHOD_ARGS_
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetDeInterlaceMode", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetDeInterlaceMode", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -718,8 +743,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetDeinterlaceMode(Nan::NAN_METHOD_ARGS_
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Input", "SetDeInterlaceMode", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Input", "SetDeInterlaceMode", {ipc::value(obj->sourceId), ipc::value(audiomixers)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -745,7 +770,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::Filters(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "GetFilters", {ipc::value(obj->sourceId)});
+	    CallSynchronous(conn, "Input", "GetFilters", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -794,7 +819,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::AddFilter(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "AddFilter", {ipc::value(obj->sourceId), ipc::value(filter->sourceId)});
+	    CallSynchronous(conn, "Input", "AddFilter", {ipc::value(obj->sourceId), ipc::value(filter->sourceId)});
 
 	ValidateResponse(response);
 }
@@ -826,8 +851,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::RemoveFilter(Nan::NAN_METHOD_ARGS_TYPE i
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Input", "RemoveFilter", {ipc::value(obj->sourceId), ipc::value(basefilter->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Input", "RemoveFilter", {ipc::value(obj->sourceId), ipc::value(basefilter->sourceId)});
 
 	ValidateResponse(response);
 }
@@ -861,8 +886,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetFilterOrder(Nan::NAN_METHOD_ARGS_TYPE
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Input", "MoveFilter", {ipc::value(obj->sourceId), ipc::value(basefilter->sourceId), ipc::value(movement)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
+	    "Input",
+	    "MoveFilter",
+	    {ipc::value(obj->sourceId), ipc::value(basefilter->sourceId), ipc::value(movement)});
 
 	ValidateResponse(response);
 }
@@ -889,7 +917,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::FindFilter(Nan::NAN_METHOD_ARGS_TYPE inf
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Input", "FindFilter", {ipc::value(obj->sourceId), ipc::value(name)});
+	    CallSynchronous(conn, "Input", "FindFilter", {ipc::value(obj->sourceId), ipc::value(name)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -934,8 +962,101 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Input::CopyFilters(Nan::NAN_METHOD_ARGS_TYPE in
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Input", "CopyFiltersTo", {ipc::value(obj->sourceId), ipc::value(input->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Input", "CopyFiltersTo", {ipc::value(obj->sourceId), ipc::value(input->sourceId)});
 
 	ValidateResponse(response);
 }
+
+// Shared by SetFilterChain and SetFilterChains. Sends the chain as JSON and
+//  returns the resulting filter ids, one row of the chain per input.
+static bool
+    CallSetFilterChain(ipc::value inputs, v8::Local<v8::Value> chain, size_t& length, std::vector<uint64_t>& ids)
+{
+	if (!chain->IsArray()) {
+		Nan::ThrowTypeError("Expected an array of filter descriptions.");
+		return false;
+	}
+	length = v8::Local<v8::Array>::Cast(chain)->Length();
+
+	std::string           json;
+	v8::Local<v8::String> str =
+	    v8::JSON::Stringify(Nan::GetCurrentContext(), v8::Local<v8::Object>::Cast(chain)).ToLocalChecked();
+	if (!utilv8::FromValue(str, json))
+		return false;
+
+	auto conn = GetConnection();
+	if (!conn)
+		return false;
+
+	std::vector<ipc::value> response =
+	    CallSynchronous(conn, "Input", "SetFilterChain", {std::move(inputs), ipc::value(json)});
+
+	if (!ValidateResponse(response))
+		return false;
+
+	const std::vector<char>& buffer = response[1].value_bin;
+	ids.resize(buffer.size() / sizeof(uint64_t));
+	std::memcpy(ids.data(), buffer.data(), ids.size() * sizeof(uint64_t));
+	return true;
+}
+
+static v8::Local<v8::Array> FilterRow(const std::vector<uint64_t>& ids, size_t offset, size_t length)
+{
+	auto arr = Nan::New<v8::Array>(int(length));
+	for (size_t idx = 0; idx < length; idx++) {
+		osn::Filter* obj = new osn::Filter(ids[offset + idx]);
+		Nan::Set(arr, uint32_t(idx), osn::Filter::Store(obj));
+	}
+	return arr;
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetFilterChain(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::Input* input = nullptr;
+	if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Input>(info.This(), input)) {
+		return;
+	}
+
+	ASSERT_INFO_LENGTH(info, 1);
+
+	size_t                length = 0;
+	std::vector<uint64_t> ids;
+	if (!CallSetFilterChain(ipc::value(input->sourceId), info[0], length, ids))
+		return;
+
+	info.GetReturnValue().Set(FilterRow(ids, 0, length));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Input::SetFilterChains(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	ASSERT_INFO_LENGTH(info, 2);
+	if (!info[0]->IsArray()) {
+		Nan::ThrowTypeError("Expected an array of inputs.");
+		return;
+	}
+	v8::Local<v8::Array> inputs = v8::Local<v8::Array>::Cast(info[0]);
+
+	std::vector<char> packed(inputs->Length() * sizeof(uint64_t));
+	for (uint32_t idx = 0; idx < inputs->Length(); idx++) {
+		v8::Local<v8::Object> obj;
+		ASSERT_GET_VALUE(Nan::Get(inputs, idx).ToLocalChecked(), obj);
+
+		osn::Input* input = nullptr;
+		if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Input>(obj, input)) {
+			return;
+		}
+		std::memcpy(packed.data() + idx * sizeof(uint64_t), &input->sourceId, sizeof(uint64_t));
+	}
+
+	size_t                length = 0;
+	std::vector<uint64_t> ids;
+	if (!CallSetFilterChain(ipc::value(packed), info[1], length, ids))
+		return;
+
+	auto arr = Nan::New<v8::Array>(int(inputs->Length()));
+	for (uint32_t idx = 0; idx < inputs->Length(); idx++) {
+		Nan::Set(arr, idx, FilterRow(ids, idx * length, length));
+	}
+	info.GetReturnValue().Set(arr);
+}
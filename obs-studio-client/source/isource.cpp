@@ -18,9 +18,13 @@
 #include "isource.hpp"
 #include <error.hpp>
 #include <functional>
+#include <map>
+#include <math.h>
 #include "controller.hpp"
+#include "events.hpp"
 #include "obs-property.hpp"
 #include "properties.hpp"
+#include "settings-delta.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
@@ -28,9 +32,17 @@
 Nan::Persistent<v8::FunctionTemplate> osn::ISource::prototype = Nan::Persistent<v8::FunctionTemplate>();
 osn::ISource*                         sourceObject;
 
+// Last property schema seen for each source type, see osn::Properties::Schema on the server.
+struct PropertySchema
+{
+	uint64_t                                    id = 0;
+	std::vector<std::shared_ptr<obs::Property>> properties;
+};
+static std::map<std::string, PropertySchema> schemas;
+
 osn::ISource::~ISource()
 {
-	stop_worker();
+	unsubscribe();
 	stop_async_runner();
 }
 
@@ -85,24 +97,36 @@ void osn::ISource::callback_handler(void* data, std::shared_ptr<std::vector<Sour
 	}
 }
 
-void osn::ISource::start_worker()
+void osn::ISource::subscribe()
 {
-	if (!m_worker_stop)
+	if (m_subscribed)
 		return;
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&osn::ISource::worker, this));
+
+	m_subscribed = true;
+	osn::Events::Subscribe(EventType::SourceHotkeys, [this](std::vector<ipc::value>& event) {
+		// Source name followed by (name, description, id) for each hotkey.
+		if (event.empty() || ((event.size() - 1) % 3) != 0)
+			return;
+
+		std::shared_ptr<std::vector<SourceHotkeyInfo>> data = std::make_shared<std::vector<SourceHotkeyInfo>>();
+		for (size_t i = 1; i < event.size(); i += 3) {
+			data->push_back(
+			    {event[0].value_str, event[i].value_str, event[i + 1].value_str, event[i + 2].value_union.ui64});
+		}
+
+		std::unique_lock<std::mutex> ul(m_worker_lock);
+		if (m_async_callback)
+			m_async_callback->queue(std::move(data));
+	});
 }
 
-void osn::ISource::stop_worker()
+void osn::ISource::unsubscribe()
 {
-	if (m_worker_stop != false)
+	if (!m_subscribed)
 		return;
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
+
+	m_subscribed = false;
+	osn::Events::Unsubscribe(EventType::SourceHotkeys);
 }
 
 void osn::ISource::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
@@ -146,7 +170,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Release(Nan::NAN_METHOD_ARGS_TYPE info
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Release", {ipc::value(obj->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "Release", {ipc::value(obj->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -163,7 +187,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Remove(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Remove", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "Remove", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -184,7 +208,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::IsConfigurable(Nan::NAN_METHOD_ARGS_TY
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "IsConfigurable", {ipc::value(is->sourceId)});
+	    CallSynchronous(conn, "Source", "IsConfigurable", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -193,6 +217,125 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::IsConfigurable(Nan::NAN_METHOD_ARGS_TY
 	return;
 }
 
+static std::shared_ptr<osn::Property> ConvertProperty(const std::shared_ptr<obs::Property>& raw_property)
+{
+	std::shared_ptr<osn::Property> pr;
+
+	switch (raw_property->type()) {
+	case obs::Property::Type::Integer: {
+		std::shared_ptr<obs::IntegerProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::IntegerProperty>(raw_property);
+		std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
+		pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
+		pr2->int_value.min                       = cast_property->minimum;
+		pr2->int_value.max                       = cast_property->maximum;
+		pr2->int_value.step                      = cast_property->step;
+		pr                                       = std::static_pointer_cast<osn::Property>(pr2);
+		break;
+	}
+	case obs::Property::Type::Float: {
+		std::shared_ptr<obs::FloatProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::FloatProperty>(raw_property);
+		std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
+		pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
+		pr2->float_value.min                     = cast_property->minimum;
+		pr2->float_value.max                     = cast_property->maximum;
+		pr2->float_value.step                    = cast_property->step;
+		pr                                       = std::static_pointer_cast<osn::Property>(pr2);
+		break;
+	}
+	case obs::Property::Type::Text: {
+		std::shared_ptr<obs::TextProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::TextProperty>(raw_property);
+		std::shared_ptr<osn::TextProperty> pr2 = std::make_shared<osn::TextProperty>();
+		pr2->field_type                        = osn::TextProperty::Type(cast_property->field_type);
+		pr                                     = std::static_pointer_cast<osn::Property>(pr2);
+		break;
+	}
+	case obs::Property::Type::Path: {
+		std::shared_ptr<obs::PathProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::PathProperty>(raw_property);
+		std::shared_ptr<osn::PathProperty> pr2 = std::make_shared<osn::PathProperty>();
+		pr2->field_type                        = osn::PathProperty::Type(cast_property->field_type);
+		pr2->filter                            = cast_property->filter;
+		pr2->default_path                      = cast_property->default_path;
+		pr                                     = std::static_pointer_cast<osn::Property>(pr2);
+		break;
+	}
+	case obs::Property::Type::List: {
+		std::shared_ptr<obs::ListProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::ListProperty>(raw_property);
+		std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
+		pr2->field_type                        = osn::ListProperty::Type(cast_property->field_type);
+		pr2->item_format                       = osn::ListProperty::Format(cast_property->format);
+		for (auto& item : cast_property->items) {
+			osn::ListProperty::Item item2;
+			item2.name     = item.name;
+			item2.disabled = !item.enabled;
+			switch (cast_property->format) {
+			case obs::ListProperty::Format::Integer:
+				item2.value_int = item.value_int;
+				break;
+			case obs::ListProperty::Format::Float:
+				item2.value_float = item.value_float;
+				break;
+			case obs::ListProperty::Format::String:
+				item2.value_str = item.value_string;
+				break;
+			}
+			pr2->items.push_back(std::move(item2));
+		}
+		pr = std::static_pointer_cast<osn::Property>(pr2);
+		break;
+	}
+	case obs::Property::Type::EditableList: {
+		std::shared_ptr<obs::EditableListProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::EditableListProperty>(raw_property);
+		std::shared_ptr<osn::EditableListProperty> pr2 = std::make_shared<osn::EditableListProperty>();
+		pr2->field_type                                = osn::EditableListProperty::Type(cast_property->field_type);
+		pr2->filter                                    = cast_property->filter;
+		pr2->default_path                              = cast_property->default_path;
+		pr                                             = std::static_pointer_cast<osn::Property>(pr2);
+		break;
+	}
+	case obs::Property::Type::FrameRate: {
+		std::shared_ptr<obs::FrameRateProperty> cast_property =
+		    std::dynamic_pointer_cast<obs::FrameRateProperty>(raw_property);
+		std::shared_ptr<osn::FrameRateProperty> pr2 = std::make_shared<osn::FrameRateProperty>();
+		for (auto& option : cast_property->ranges) {
+			std::pair<osn::FrameRateProperty::FrameRate, osn::FrameRateProperty::FrameRate> range2;
+			range2.first.numerator    = option.minimum.first;
+			range2.first.denominator  = option.minimum.second;
+			range2.second.numerator   = option.maximum.first;
+			range2.second.denominator = option.maximum.second;
+			pr2->ranges.push_back(std::move(range2));
+		}
+		for (auto& option : cast_property->options) {
+			osn::FrameRateProperty::Option option2;
+			option2.name        = option.name;
+			option2.description = option.description;
+			pr2->options.push_back(std::move(option2));
+		}
+
+		break;
+	}
+	default: {
+		pr = std::make_shared<osn::Property>();
+		break;
+	}
+	}
+
+	if (pr) {
+		pr->name             = raw_property->name;
+		pr->description      = raw_property->description;
+		pr->long_description = raw_property->long_description;
+		pr->type             = osn::Property::Type(raw_property->type());
+		pr->enabled          = raw_property->enabled;
+		pr->visible          = raw_property->visible;
+	}
+	return pr;
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetProperties(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	osn::ISource* hndl = nullptr;
@@ -204,139 +347,59 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetProperties(Nan::NAN_METHOD_ARGS_TYP
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(hndl->sourceId)});
+	if (hndl->m_type_id.empty()) {
+		std::vector<ipc::value> response =
+		    CallSynchronous(conn, "Source", "GetId", {ipc::value(hndl->sourceId)});
+
+		if (!ValidateResponse(response))
+			return;
+
+		hndl->m_type_id = response[1].value_str;
+	}
+
+	// The server answers with the full schema only if the one we know is stale,
+	// otherwise it sends just the list properties since their items are dynamic.
+	PropertySchema& schema = schemas[hndl->m_type_id];
+
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Source", "GetProperties", {ipc::value(hndl->sourceId), ipc::value(schema.id)});
 
 	if (!ValidateResponse(response))
 		return;
 
-	if (response.size() == 1) {
+	std::vector<std::shared_ptr<obs::Property>> properties;
+	if (response[2].value_union.i32) {
+		schema.id = response[1].value_union.ui64;
+		schema.properties.clear();
+		for (size_t idx = 3; idx < response.size(); ++idx) {
+			schema.properties.push_back(obs::Property::deserialize(response[idx].value_bin));
+		}
+		properties = schema.properties;
+	} else {
+		properties  = schema.properties;
+		size_t list = 3;
+		for (auto& prop : properties) {
+			if (!prop || prop->type() != obs::Property::Type::List)
+				continue;
+			if (list < response.size() && response[list].value_bin.size())
+				prop = obs::Property::deserialize(response[list].value_bin);
+			list++;
+		}
+	}
+
+	if (properties.empty()) {
 		info.GetReturnValue().Set(Nan::Null());
 		return;
 	}
 
-	// Parse the massive structure of properties we were just sent.
 	osn::property_map_t pmap;
-	for (size_t idx = 1; idx < response.size(); ++idx) {
-		// !FIXME! Use the already existing obs::Property object instead of copying data.
-		auto raw_property = obs::Property::deserialize(response[idx].value_bin);
-
-		std::shared_ptr<osn::Property> pr;
-
-		switch (raw_property->type()) {
-		case obs::Property::Type::Integer: {
-			std::shared_ptr<obs::IntegerProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::IntegerProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.min                       = cast_property->minimum;
-			pr2->int_value.max                       = cast_property->maximum;
-			pr2->int_value.step                      = cast_property->step;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Float: {
-			std::shared_ptr<obs::FloatProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FloatProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->float_value.min                     = cast_property->minimum;
-			pr2->float_value.max                     = cast_property->maximum;
-			pr2->float_value.step                    = cast_property->step;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Text: {
-			std::shared_ptr<obs::TextProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::TextProperty>(raw_property);
-			std::shared_ptr<osn::TextProperty> pr2 = std::make_shared<osn::TextProperty>();
-			pr2->field_type                        = osn::TextProperty::Type(cast_property->field_type);
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Path: {
-			std::shared_ptr<obs::PathProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::PathProperty>(raw_property);
-			std::shared_ptr<osn::PathProperty> pr2 = std::make_shared<osn::PathProperty>();
-			pr2->field_type                        = osn::PathProperty::Type(cast_property->field_type);
-			pr2->filter                            = cast_property->filter;
-			pr2->default_path                      = cast_property->default_path;
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::List: {
-			std::shared_ptr<obs::ListProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::ListProperty>(raw_property);
-			std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
-			pr2->field_type                        = osn::ListProperty::Type(cast_property->field_type);
-			pr2->item_format                       = osn::ListProperty::Format(cast_property->format);
-			for (auto& item : cast_property->items) {
-				osn::ListProperty::Item item2;
-				item2.name     = item.name;
-				item2.disabled = !item.enabled;
-				switch (cast_property->format) {
-				case obs::ListProperty::Format::Integer:
-					item2.value_int = item.value_int;
-					break;
-				case obs::ListProperty::Format::Float:
-					item2.value_float = item.value_float;
-					break;
-				case obs::ListProperty::Format::String:
-					item2.value_str = item.value_string;
-					break;
-				}
-				pr2->items.push_back(std::move(item2));
-			}
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::EditableList: {
-			std::shared_ptr<obs::EditableListProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::EditableListProperty>(raw_property);
-			std::shared_ptr<osn::EditableListProperty> pr2 = std::make_shared<osn::EditableListProperty>();
-			pr2->field_type                                = osn::EditableListProperty::Type(cast_property->field_type);
-			pr2->filter                                    = cast_property->filter;
-			pr2->default_path                              = cast_property->default_path;
-			pr                                             = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::FrameRate: {
-			std::shared_ptr<obs::FrameRateProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FrameRateProperty>(raw_property);
-			std::shared_ptr<osn::FrameRateProperty> pr2 = std::make_shared<osn::FrameRateProperty>();
-			for (auto& option : cast_property->ranges) {
-				std::pair<osn::FrameRateProperty::FrameRate, osn::FrameRateProperty::FrameRate> range2;
-				range2.first.numerator    = option.minimum.first;
-				range2.first.denominator  = option.minimum.second;
-				range2.second.numerator   = option.maximum.first;
-				range2.second.denominator = option.maximum.second;
-				pr2->ranges.push_back(std::move(range2));
-			}
-			for (auto& option : cast_property->options) {
-				osn::FrameRateProperty::Option option2;
-				option2.name        = option.name;
-				option2.description = option.description;
-				pr2->options.push_back(std::move(option2));
-			}
+	for (size_t idx = 0; idx < properties.size(); ++idx) {
+		if (!properties[idx])
+			continue;
 
-			break;
-		}
-		default: {
-			pr = std::make_shared<osn::Property>();
-			break;
-		}
-		}
-
-		if (pr) {
-			pr->name             = raw_property->name;
-			pr->description      = raw_property->description;
-			pr->long_description = raw_property->long_description;
-			pr->type             = osn::Property::Type(raw_property->type());
-			pr->enabled          = raw_property->enabled;
-			pr->visible          = raw_property->visible;
-
-			pmap.emplace(idx - 1, pr);
-		}
+		std::shared_ptr<osn::Property> pr = ConvertProperty(properties[idx]);
+		if (pr)
+			pmap.emplace(idx, pr);
 	}
 
 	// obj = std::move(pmap);
@@ -357,7 +420,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetSettings(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetSettings", {ipc::value(hndl->sourceId)});
+	    CallSynchronous(conn, "Source", "GetSettings", {ipc::value(hndl->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -384,13 +447,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::ConnectHotkeyCallback(const v8::Functi
 	sourceObject->m_callback_function.Reset(callback);
 	sourceObject->start_async_runner();
 	sourceObject->set_keepalive(args.This());
-	sourceObject->start_worker();
+	sourceObject->subscribe();
 	args.GetReturnValue().Set(true);
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::ISource::DisconnectHotkeyCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
-	sourceObject->stop_worker();
+	sourceObject->unsubscribe();
 	sourceObject->stop_async_runner();
 }
 
@@ -408,58 +471,13 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::ProcessHotkeyStatus(const v8::Function
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Source", "ProcessHotkeyStatus", {ipc::value(hotkeyId), ipc::value(press), ipc::value(sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Source", "ProcessHotkeyStatus", {ipc::value(hotkeyId), ipc::value(press), ipc::value(sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
 }
 
-void osn::ISource::worker()
-{
-	size_t totalSleepMS = 0;
-
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Grab IPC Connection
-		std::shared_ptr<ipc::client> conn = nullptr;
-		if (!(conn = GetConnection())) {
-			goto do_sleep;
-		}
-
-		// Call
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok && (response.size() - 1) % 4 == 0) /* Each entry has 4 results */ {
-				std::shared_ptr<std::vector<SourceHotkeyInfo>> data = std::make_shared<std::vector<SourceHotkeyInfo>>();
-
-				// For each hotkey pair
-				for (int i = 1; i < response.size(); i += 4) {
-					data->push_back({response[i].value_str,
-					                 response[i + 1].value_str,
-					                 response[i + 2].value_str,
-					                 response[i + 3].value_union.ui64});
-				}
-
-				m_async_callback->queue(std::move(data));
-			}
-		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = m_sleep_interval - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
-}
-
 void osn::ISource::set_keepalive(v8::Local<v8::Object> obj)
 {
 	if (!m_async_callback)
@@ -467,6 +485,56 @@ void osn::ISource::set_keepalive(v8::Local<v8::Object> obj)
 	m_async_callback->set_keepalive(obj);
 }
 
+// Writes the own properties of 'object' as delta entries. Returns false for
+//  anything the delta can not express (arrays, null, non-finite numbers, ...),
+//  the caller then sends JSON instead.
+static bool EncodeSettingsDelta(
+    v8::Local<v8::Object>        object,
+    osn::settings_delta::writer& w,
+    uint32_t&                    count,
+    uint32_t                     depth)
+{
+	if (depth >= osn::settings_delta::max_depth)
+		return false;
+
+	v8::Local<v8::Array> keys = Nan::GetOwnPropertyNames(object).ToLocalChecked();
+	for (uint32_t idx = 0; idx < keys->Length(); idx++) {
+		v8::Local<v8::Value> key   = Nan::Get(keys, idx).ToLocalChecked();
+		v8::Local<v8::Value> value = Nan::Get(object, key).ToLocalChecked();
+		Nan::Utf8String      name(key);
+		std::string          keystr(*name, size_t(name.length()));
+
+		if (value->IsUndefined() || value->IsFunction()) {
+			// JSON.stringify drops these as well.
+			continue;
+		} else if (value->IsBoolean()) {
+			w.put_bool(keystr, Nan::To<bool>(value).FromJust());
+		} else if (value->IsNumber()) {
+			// Integral values are integers in JSON too, anything else is a double.
+			double v = Nan::To<double>(value).FromJust();
+			if (!isfinite(v))
+				return false;
+			if ((v == floor(v)) && (fabs(v) <= 9007199254740992.0))
+				w.put_int(keystr, int64_t(v));
+			else
+				w.put_double(keystr, v);
+		} else if (value->IsString()) {
+			Nan::Utf8String str(value);
+			w.put_string(keystr, *str, size_t(str.length()));
+		} else if (value->IsObject() && !value->IsArray() && !value->IsDate()) {
+			size_t   offset   = w.begin_object(keystr);
+			uint32_t children = 0;
+			if (!EncodeSettingsDelta(value.As<v8::Object>(), w, children, depth + 1))
+				return false;
+			w.end_object(offset, children);
+		} else {
+			return false;
+		}
+		count++;
+	}
+	return true;
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Update(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	v8::Local<v8::Object> json;
@@ -478,18 +546,34 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Update(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 	}
 
-	// Turn json into string
-	v8::Local<v8::String> jsondata = v8::JSON::Stringify(info.GetIsolate()->GetCurrentContext(), json).ToLocalChecked();
-	v8::String::Utf8Value jsondatautf8(jsondata);
-
 	auto conn = GetConnection();
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Source",
-	    "Update",
-	    {ipc::value(hndl->sourceId), ipc::value(std::string(*jsondatautf8, (size_t)jsondatautf8.length()))});
+	// Prefer the binary delta, the server applies it key by key and merges
+	//  rapid updates instead of reparsing the whole object every time.
+	std::vector<char>           delta;
+	osn::settings_delta::writer w(delta);
+	w.put_header();
+	size_t   offset = w.begin_object();
+	uint32_t count  = 0;
+
+	std::vector<ipc::value> response;
+	if (EncodeSettingsDelta(json, w, count, 0)) {
+		w.end_object(offset, count);
+		response = CallSynchronous(conn, "Source", "UpdateDelta", {ipc::value(hndl->sourceId), ipc::value(delta)});
+	} else {
+		// Turn json into string
+		v8::Local<v8::String> jsondata =
+		    v8::JSON::Stringify(info.GetIsolate()->GetCurrentContext(), json).ToLocalChecked();
+		v8::String::Utf8Value jsondatautf8(jsondata);
+
+		response = CallSynchronous(
+		    conn,
+		    "Source",
+		    "Update",
+		    {ipc::value(hndl->sourceId), ipc::value(std::string(*jsondatautf8, (size_t)jsondatautf8.length()))});
+	}
 
 	if (!ValidateResponse(response))
 		return;
@@ -509,7 +593,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Load(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Load", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "Load", {ipc::value(is->sourceId)});
 
 	ValidateResponse(response);
 }
@@ -525,7 +609,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::Save(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Save", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "Save", {ipc::value(is->sourceId)});
 
 	ValidateResponse(response);
 }
@@ -541,7 +625,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetType(Nan::NAN_METHOD_ARGS_TYPE info
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetType", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "GetType", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -560,7 +644,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetName(Nan::NAN_METHOD_ARGS_TYPE info
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetName", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "GetName", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -583,7 +667,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::SetName(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "SetName", {ipc::value(is->sourceId), ipc::value(name)});
+	    CallSynchronous(conn, "Source", "SetName", {ipc::value(is->sourceId), ipc::value(name)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -603,7 +687,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetOutputFlags(Nan::NAN_METHOD_ARGS_TY
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetOutputFlags", {ipc::value(is->sourceId)});
+	    CallSynchronous(conn, "Source", "GetOutputFlags", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -622,7 +706,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetFlags(Nan::NAN_METHOD_ARGS_TYPE inf
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetFlags", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "GetFlags", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -645,7 +729,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::SetFlags(Nan::NAN_METHOD_ARGS_TYPE inf
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "SetFlags", {ipc::value(is->sourceId), ipc::value(flags)});
+	    CallSynchronous(conn, "Source", "SetFlags", {ipc::value(is->sourceId), ipc::value(flags)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -664,7 +748,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetStatus(Nan::NAN_METHOD_ARGS_TYPE in
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetStatus", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "GetStatus", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -683,7 +767,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetId(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetId", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "GetId", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -702,7 +786,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetMuted(Nan::NAN_METHOD_ARGS_TYPE inf
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetMuted", {ipc::value(is->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Source", "GetMuted", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -727,7 +811,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::SetMuted(Nan::NAN_METHOD_ARGS_TYPE inf
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "SetMuted", {ipc::value(is->sourceId), ipc::value(muted)});
+	    CallSynchronous(conn, "Source", "SetMuted", {ipc::value(is->sourceId), ipc::value(muted)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -747,7 +831,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::GetEnabled(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetEnabled", {ipc::value(is->sourceId)});
+	    CallSynchronous(conn, "Source", "GetEnabled", {ipc::value(is->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -771,7 +855,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::ISource::SetEnabled(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "SetEnabled", {ipc::value(is->sourceId), ipc::value(enabled)});
+	    CallSynchronous(conn, "Source", "SetEnabled", {ipc::value(is->sourceId), ipc::value(enabled)});
 
 	if (!ValidateResponse(response))
 		return;
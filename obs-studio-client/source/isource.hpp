@@ -44,12 +44,11 @@ namespace osn
 		virtual ~ISource();
 
 		private:
-		uint64_t m_uid;
-		uint32_t m_sleep_interval = 33;
+		uint64_t    m_uid;
+		std::string m_type_id;
 
-		std::thread m_worker;
-		bool        m_worker_stop = true;
-		std::mutex  m_worker_lock;
+		bool       m_subscribed = false;
+		std::mutex m_worker_lock;
 
 		osn::SourceCallback*	m_async_callback = nullptr;
 		Nan::Callback			m_callback_function;
@@ -59,9 +58,8 @@ namespace osn
 		void stop_async_runner();
 		void callback_handler(void* data, std::shared_ptr<std::vector<SourceHotkeyInfo>> item);
 
-		void start_worker();
-		void stop_worker();
-		void worker();
+		void subscribe();
+		void unsubscribe();
 		void set_keepalive(v8::Local<v8::Object>);
 
 		public:
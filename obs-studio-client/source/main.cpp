@@ -24,6 +24,7 @@
 #include "nodeobs_api.hpp"
 #include "properties.hpp"
 #include "scene.hpp"
+#include "scene-collection.hpp"
 #include "sceneitem.hpp"
 #include "shared.hpp"
 #include "transition.hpp"
@@ -43,6 +44,7 @@ void main(v8::Local<v8::Object> exports, v8::Local<v8::Value> module, void* priv
 	osn::Transition::Register(exports);
 	osn::Scene::Register(exports);
 	osn::SceneItem::Register(exports);
+	osn::SceneCollection::Register(exports);
 	osn::Properties::Register(exports);
 	osn::PropertyObject::Register(exports);
 	osn::Fader::Register(exports);
@@ -66,7 +66,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::Open(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Module", "Open", {ipc::value(bin_path), ipc::value(data_path)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Module", "Open", {ipc::value(bin_path), ipc::value(data_path)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -87,7 +87,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::Initialize(Nan::NAN_METHOD_ARGS_TYPE in
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "Initialize", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "Initialize", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -107,7 +107,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::Name(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetName", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "GetName", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -127,7 +127,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::FileName(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetFileName", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "GetFileName", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -147,7 +147,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::Description(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetDescription", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "GetDescription", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -167,7 +167,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::Author(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetAuthor", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "GetAuthor", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -187,7 +187,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::BinaryPath(Nan::NAN_METHOD_ARGS_TYPE in
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetBinaryPath", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "GetBinaryPath", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -207,7 +207,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Module::DataPath(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Module", "GetDataPath", {ipc::value(module->moduleId)});
+	    CallSynchronous(conn, "Module", "GetDataPath", {ipc::value(module->moduleId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -3,9 +3,12 @@
 #include "nodeobs_api.hpp"
 #include "utility-v8.hpp"
 
+#include <cstring>
 #include <node.h>
 #include <sstream>
 #include <string>
+#include "performance-series.hpp"
+#include "sceneitem.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -17,12 +20,45 @@ void api::OBS_API_initAPI(const v8::FunctionCallbackInfo<v8::Value>& args)
 	ASSERT_GET_VALUE(args[0], language);
 	ASSERT_GET_VALUE(args[1], path);
 
+	std::vector<ipc::value> params = {ipc::value(path), ipc::value(language)};
+
+	// Optional logger options, anything left out keeps the server default.
+	if (args.Length() > 2 && args[2]->IsObject()) {
+		v8::Local<v8::Object> options = args[2].As<v8::Object>();
+
+		uint32_t    capacity      = 0;
+		std::string overflow;
+		double      max_file_size = 0;
+		uint32_t    max_files     = 0;
+		uint32_t    overflow_mode = 0;
+
+		if (Nan::Has(options, utilv8::ToValue("capacity")).FromMaybe(false))
+			ASSERT_GET_OBJECT_FIELD(options, "capacity", capacity);
+		if (Nan::Has(options, utilv8::ToValue("overflow")).FromMaybe(false)) {
+			ASSERT_GET_OBJECT_FIELD(options, "overflow", overflow);
+			if (overflow == "block") {
+				overflow_mode = 1;
+			} else if (overflow != "drop") {
+				Nan::ThrowTypeError("Expected 'drop' or 'block' for the overflow policy.");
+				return;
+			}
+		}
+		if (Nan::Has(options, utilv8::ToValue("maxFileSize")).FromMaybe(false))
+			ASSERT_GET_OBJECT_FIELD(options, "maxFileSize", max_file_size);
+		if (Nan::Has(options, utilv8::ToValue("maxFiles")).FromMaybe(false))
+			ASSERT_GET_OBJECT_FIELD(options, "maxFiles", max_files);
+
+		params.push_back(ipc::value(capacity));
+		params.push_back(ipc::value(overflow_mode));
+		params.push_back(ipc::value(uint64_t(max_file_size < 0 ? 0 : max_file_size)));
+		params.push_back(ipc::value(max_files));
+	}
+
 	auto conn = GetConnection();
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("API", "OBS_API_initAPI", {ipc::value(path), ipc::value(language)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "OBS_API_initAPI", params);
 
 	ValidateResponse(response);
 }
@@ -33,7 +69,7 @@ void api::OBS_API_destroyOBS_API(const v8::FunctionCallbackInfo<v8::Value>& args
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_destroyOBS_API", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "OBS_API_destroyOBS_API", {});
 
 	ValidateResponse(response);
 }
@@ -44,7 +80,7 @@ void api::OBS_API_getPerformanceStatistics(const v8::FunctionCallbackInfo<v8::Va
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_getPerformanceStatistics", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "OBS_API_getPerformanceStatistics", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -71,6 +107,405 @@ void api::OBS_API_getPerformanceStatistics(const v8::FunctionCallbackInfo<v8::Va
 	return;
 }
 
+void api::OBS_API_getPerformanceSeries(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	// Window in milliseconds, 0 or none for everything the server still has.
+	uint32_t window = 0;
+	if (args.Length() > 0) {
+		ASSERT_GET_VALUE(args[0], window);
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response =
+	    CallSynchronous(conn, "Performance", "Query", {ipc::value(window)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	v8::Isolate*             isolate = args.GetIsolate();
+	const std::vector<char>& buf     = response[1].value_bin;
+
+	osn::PerformanceSeriesHeader header;
+	if (buf.size() < sizeof(header))
+		return;
+	memcpy(&header, buf.data(), sizeof(header));
+	if (buf.size() < osn::PerformanceSeriesSize(header.metrics, header.samples))
+		return;
+
+	// Metrics the server sends that this module does not know yet are skipped.
+	static const char* names[] = {"CPU",
+	                              "numberDroppedFrames",
+	                              "percentageDroppedFrames",
+	                              "bandwidth",
+	                              "frameRate",
+	                              "laggedFrames",
+	                              "skippedFrames",
+	                              "recordingBytes",
+	                              "streamingCongestion",
+	                              "recordingCongestion"};
+
+	const char*           ptr        = buf.data() + sizeof(header);
+	v8::Local<v8::Object> series     = v8::Object::New(isolate);
+	v8::Local<v8::Array>  timestamps = v8::Array::New(isolate, header.samples);
+	v8::Local<v8::Object> metrics    = v8::Object::New(isolate);
+	for (uint32_t idx = 0; idx < header.samples; idx++, ptr += sizeof(uint64_t)) {
+		uint64_t timestamp;
+		memcpy(&timestamp, ptr, sizeof(timestamp));
+		timestamps->Set(idx, v8::Number::New(isolate, double(timestamp)));
+	}
+
+	for (uint32_t metric = 0; metric < header.metrics; metric++) {
+		osn::PerformanceSummary summary;
+		memcpy(&summary, ptr, sizeof(summary));
+		ptr += sizeof(summary);
+
+		v8::Local<v8::Array> values = v8::Array::New(isolate, header.samples);
+		for (uint32_t idx = 0; idx < header.samples; idx++, ptr += sizeof(double)) {
+			double value;
+			memcpy(&value, ptr, sizeof(value));
+			values->Set(idx, v8::Number::New(isolate, value));
+		}
+
+		if (metric >= sizeof(names) / sizeof(names[0]))
+			continue;
+
+		v8::Local<v8::Object> entry = v8::Object::New(isolate);
+		entry->Set(v8::String::NewFromUtf8(isolate, "min"), v8::Number::New(isolate, summary.min));
+		entry->Set(v8::String::NewFromUtf8(isolate, "avg"), v8::Number::New(isolate, summary.avg));
+		entry->Set(v8::String::NewFromUtf8(isolate, "p95"), v8::Number::New(isolate, summary.p95));
+		entry->Set(v8::String::NewFromUtf8(isolate, "p99"), v8::Number::New(isolate, summary.p99));
+		entry->Set(v8::String::NewFromUtf8(isolate, "max"), v8::Number::New(isolate, summary.max));
+		entry->Set(v8::String::NewFromUtf8(isolate, "series"), values);
+		metrics->Set(v8::String::NewFromUtf8(isolate, names[metric]), entry);
+	}
+
+	series->Set(v8::String::NewFromUtf8(isolate, "interval"), v8::Number::New(isolate, header.interval));
+	series->Set(v8::String::NewFromUtf8(isolate, "timestamps"), timestamps);
+	series->Set(v8::String::NewFromUtf8(isolate, "metrics"), metrics);
+
+	args.GetReturnValue().Set(series);
+	return;
+}
+
+void api::OBS_API_getModuleTimings(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "OBS_API_getModuleTimings", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	v8::Isolate*         isolate = args.GetIsolate();
+	v8::Local<v8::Array> modules = v8::Array::New(isolate);
+
+	for (size_t idx = 1; idx + 4 < response.size(); idx += 5) {
+		v8::Local<v8::Object> module = v8::Object::New(isolate);
+		module->Set(
+		    v8::String::NewFromUtf8(isolate, "name"),
+		    v8::String::NewFromUtf8(isolate, response[idx].value_str.c_str()));
+		module->Set(
+		    v8::String::NewFromUtf8(isolate, "result"),
+		    v8::Integer::New(isolate, response[idx + 1].value_union.i32));
+		module->Set(
+		    v8::String::NewFromUtf8(isolate, "cached"),
+		    v8::Boolean::New(isolate, response[idx + 2].value_union.ui32 != 0));
+		module->Set(
+		    v8::String::NewFromUtf8(isolate, "loadTime"),
+		    v8::Number::New(isolate, response[idx + 3].value_union.fp64));
+		module->Set(
+		    v8::String::NewFromUtf8(isolate, "initTime"),
+		    v8::Number::New(isolate, response[idx + 4].value_union.fp64));
+		modules->Set((uint32_t)(idx / 5), module);
+	}
+
+	args.GetReturnValue().Set(modules);
+	return;
+}
+
+void api::OBS_API_getFrameLatency(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "FrameTrace", "GetHistograms", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	v8::Isolate*          isolate = args.GetIsolate();
+	v8::Local<v8::Object> stages  = v8::Object::New(isolate);
+
+	// Durations are reported in milliseconds, bucket n holds [2^n, 2^(n+1)) us.
+	for (size_t idx = 2; idx + 4 < response.size(); idx += 5) {
+		uint64_t count = response[idx + 1].value_union.ui64;
+		uint64_t total = response[idx + 2].value_union.ui64;
+
+		const std::vector<char>& buf     = response[idx + 4].value_bin;
+		v8::Local<v8::Array>     buckets = v8::Array::New(isolate);
+		for (size_t bucket = 0; bucket < buf.size() / sizeof(uint64_t); bucket++) {
+			uint64_t value;
+			memcpy(&value, buf.data() + bucket * sizeof(uint64_t), sizeof(uint64_t));
+			buckets->Set(uint32_t(bucket), v8::Number::New(isolate, double(value)));
+		}
+
+		v8::Local<v8::Object> stage = v8::Object::New(isolate);
+		stage->Set(v8::String::NewFromUtf8(isolate, "count"), v8::Number::New(isolate, double(count)));
+		stage->Set(
+		    v8::String::NewFromUtf8(isolate, "average"),
+		    v8::Number::New(isolate, count ? double(total) / double(count) / 1000000.0 : 0.0));
+		stage->Set(
+		    v8::String::NewFromUtf8(isolate, "max"),
+		    v8::Number::New(isolate, double(response[idx + 3].value_union.ui64) / 1000000.0));
+		stage->Set(v8::String::NewFromUtf8(isolate, "buckets"), buckets);
+		stages->Set(v8::String::NewFromUtf8(isolate, response[idx].value_str.c_str()), stage);
+	}
+
+	args.GetReturnValue().Set(stages);
+	return;
+}
+
+void api::OBS_API_getFrameTrace(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "FrameTrace", "GetTrace", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	args.GetReturnValue().Set(v8::String::NewFromUtf8(args.GetIsolate(), response[1].value_str.c_str()));
+	return;
+}
+
+void api::OBS_API_resetFrameLatency(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "FrameTrace", "Reset", {});
+
+	ValidateResponse(response);
+}
+
+void api::OBS_API_setFrameTraceOutput(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	bool enabled;
+	ASSERT_GET_VALUE(args[0], enabled);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response =
+	    CallSynchronous(conn, "FrameTrace", "SetOutputTracing", {ipc::value(uint32_t(enabled))});
+
+	ValidateResponse(response);
+}
+
+static v8::Local<v8::Array> CallStatsToArray(v8::Isolate* isolate, const std::vector<osn::callstats::snapshot>& stats)
+{
+	v8::Local<v8::Array> result = v8::Array::New(isolate);
+	for (size_t idx = 0; idx < stats.size(); idx++) {
+		const osn::callstats::snapshot& s = stats[idx];
+
+		v8::Local<v8::Array> latency = v8::Array::New(isolate);
+		v8::Local<v8::Array> size    = v8::Array::New(isolate);
+		for (uint32_t bucket = 0; bucket < osn::callstats::buckets; bucket++) {
+			latency->Set(bucket, v8::Number::New(isolate, double(s.latency[bucket])));
+			size->Set(bucket, v8::Number::New(isolate, double(s.size[bucket])));
+		}
+
+		// Times are in milliseconds.
+		v8::Local<v8::Object> entry = v8::Object::New(isolate);
+		entry->Set(
+		    v8::String::NewFromUtf8(isolate, "collection"), v8::String::NewFromUtf8(isolate, s.collection.c_str()));
+		entry->Set(v8::String::NewFromUtf8(isolate, "function"), v8::String::NewFromUtf8(isolate, s.function.c_str()));
+		entry->Set(v8::String::NewFromUtf8(isolate, "calls"), v8::Number::New(isolate, double(s.calls)));
+		entry->Set(v8::String::NewFromUtf8(isolate, "errors"), v8::Number::New(isolate, double(s.errors)));
+		entry->Set(
+		    v8::String::NewFromUtf8(isolate, "average"),
+		    v8::Number::New(isolate, s.calls ? double(s.total_ns) / double(s.calls) / 1000000.0 : 0.0));
+		entry->Set(v8::String::NewFromUtf8(isolate, "max"), v8::Number::New(isolate, double(s.max_ns) / 1000000.0));
+		entry->Set(v8::String::NewFromUtf8(isolate, "bytesIn"), v8::Number::New(isolate, double(s.bytes_in)));
+		entry->Set(v8::String::NewFromUtf8(isolate, "bytesOut"), v8::Number::New(isolate, double(s.bytes_out)));
+		entry->Set(v8::String::NewFromUtf8(isolate, "latency"), latency);
+		entry->Set(v8::String::NewFromUtf8(isolate, "size"), size);
+		result->Set(uint32_t(idx), entry);
+	}
+	return result;
+}
+
+static v8::Local<v8::Array> CallSamplesToArray(v8::Isolate* isolate, const std::vector<osn::callstats::sample>& samples)
+{
+	v8::Local<v8::Array> result = v8::Array::New(isolate);
+	for (size_t idx = 0; idx < samples.size(); idx++) {
+		const osn::callstats::sample& s = samples[idx];
+
+		v8::Local<v8::Object> entry = v8::Object::New(isolate);
+		entry->Set(
+		    v8::String::NewFromUtf8(isolate, "timestamp"), v8::Number::New(isolate, double(s.timestamp) / 1000000.0));
+		entry->Set(
+		    v8::String::NewFromUtf8(isolate, "collection"), v8::String::NewFromUtf8(isolate, s.collection.c_str()));
+		entry->Set(v8::String::NewFromUtf8(isolate, "function"), v8::String::NewFromUtf8(isolate, s.function.c_str()));
+		entry->Set(
+		    v8::String::NewFromUtf8(isolate, "duration"), v8::Number::New(isolate, double(s.duration_ns) / 1000000.0));
+		entry->Set(v8::String::NewFromUtf8(isolate, "bytesIn"), v8::Number::New(isolate, double(s.bytes_in)));
+		entry->Set(v8::String::NewFromUtf8(isolate, "bytesOut"), v8::Number::New(isolate, double(s.bytes_out)));
+		result->Set(uint32_t(idx), entry);
+	}
+	return result;
+}
+
+void api::OBS_API_getCallStatistics(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "CallStats", "Query", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	std::vector<osn::callstats::snapshot> server;
+	if (!osn::callstats::deserialize_snapshots(response[1].value_bin, server)) {
+		Nan::ThrowError("Malformed call statistics.");
+		return;
+	}
+
+	v8::Isolate*          isolate = args.GetIsolate();
+	v8::Local<v8::Object> result  = v8::Object::New(isolate);
+	result->Set(
+	    v8::String::NewFromUtf8(isolate, "client"),
+	    CallStatsToArray(isolate, Controller::GetInstance().GetCallStats().collect()));
+	result->Set(v8::String::NewFromUtf8(isolate, "server"), CallStatsToArray(isolate, server));
+
+	args.GetReturnValue().Set(result);
+	return;
+}
+
+void api::OBS_API_getCallTrace(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "CallStats", "GetTrace", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	std::vector<osn::callstats::sample> server;
+	if (!osn::callstats::deserialize_samples(response[1].value_bin, server)) {
+		Nan::ThrowError("Malformed call trace.");
+		return;
+	}
+
+	v8::Isolate*          isolate = args.GetIsolate();
+	v8::Local<v8::Object> result  = v8::Object::New(isolate);
+	result->Set(
+	    v8::String::NewFromUtf8(isolate, "client"),
+	    CallSamplesToArray(isolate, Controller::GetInstance().GetCallStats().samples()));
+	result->Set(v8::String::NewFromUtf8(isolate, "server"), CallSamplesToArray(isolate, server));
+
+	args.GetReturnValue().Set(result);
+	return;
+}
+
+void api::OBS_API_setCallSampling(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	uint32_t every;
+	ASSERT_GET_VALUE(args[0], every);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	Controller::GetInstance().GetCallStats().set_sample_every(every);
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "CallStats", "SetSampling", {ipc::value(every)});
+
+	ValidateResponse(response);
+}
+
+void api::OBS_API_resetCallStatistics(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	Controller::GetInstance().GetCallStats().reset();
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "CallStats", "Reset", {});
+
+	ValidateResponse(response);
+}
+
+void api::OBS_API_getHandleCounters(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	// Send whatever is queued first so that the counters are not skewed by
+	//  releases still waiting for the loop.
+	osn::SceneItem::FlushLeases();
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "SceneItem", "GetLeaseCounters", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	osn::SceneItem::LeaseCounters client = osn::SceneItem::GetLeaseCounters();
+
+	v8::Isolate*          isolate = args.GetIsolate();
+	v8::Local<v8::Object> result  = v8::Object::New(isolate);
+	const char*           names[] = {"live", "outstanding", "granted", "returned", "recycled", "revoked", "stale"};
+	for (size_t idx = 0; idx < sizeof(names) / sizeof(names[0]); idx++) {
+		result->Set(
+		    v8::String::NewFromUtf8(isolate, names[idx]),
+		    v8::Number::New(isolate, double(response[1 + idx].value_union.ui64)));
+	}
+	result->Set(v8::String::NewFromUtf8(isolate, "collected"), v8::Number::New(isolate, double(client.collected)));
+	result->Set(v8::String::NewFromUtf8(isolate, "pending"), v8::Number::New(isolate, double(client.pending)));
+	result->Set(v8::String::NewFromUtf8(isolate, "flushes"), v8::Number::New(isolate, double(client.flushes)));
+
+	args.GetReturnValue().Set(result);
+	return;
+}
+
+void api::OBS_API_getLogStatistics(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "OBS_API_getLogStatistics", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	v8::Isolate*          isolate = args.GetIsolate();
+	v8::Local<v8::Object> result  = v8::Object::New(isolate);
+	result->Set(
+	    v8::String::NewFromUtf8(isolate, "dropped"), v8::Number::New(isolate, double(response[1].value_union.ui64)));
+	result->Set(
+	    v8::String::NewFromUtf8(isolate, "written"), v8::Number::New(isolate, double(response[2].value_union.ui64)));
+
+	args.GetReturnValue().Set(result);
+	return;
+}
+
 void api::SetWorkingDirectory(const v8::FunctionCallbackInfo<v8::Value>& args) {
 	Nan::Utf8String param0(args[0]);
 	std::string     path = *param0;
@@ -79,7 +514,7 @@ void api::SetWorkingDirectory(const v8::FunctionCallbackInfo<v8::Value>& args) {
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "SetWorkingDirectory", {ipc::value(path)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "SetWorkingDirectory", {ipc::value(path)});
 
 	ValidateResponse(response);
 }
@@ -90,7 +525,7 @@ void api::StopCrashHandler(const v8::FunctionCallbackInfo<v8::Value>& args)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "StopCrashHandler", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "API", "StopCrashHandler", {});
 
 	ValidateResponse(response);
 }
@@ -101,6 +536,18 @@ INITIALIZER(nodeobs_api)
 		NODE_SET_METHOD(exports, "OBS_API_initAPI", api::OBS_API_initAPI);
 		NODE_SET_METHOD(exports, "OBS_API_destroyOBS_API", api::OBS_API_destroyOBS_API);
 		NODE_SET_METHOD(exports, "OBS_API_getPerformanceStatistics", api::OBS_API_getPerformanceStatistics);
+		NODE_SET_METHOD(exports, "OBS_API_getPerformanceSeries", api::OBS_API_getPerformanceSeries);
+		NODE_SET_METHOD(exports, "OBS_API_getModuleTimings", api::OBS_API_getModuleTimings);
+		NODE_SET_METHOD(exports, "OBS_API_getFrameLatency", api::OBS_API_getFrameLatency);
+		NODE_SET_METHOD(exports, "OBS_API_getFrameTrace", api::OBS_API_getFrameTrace);
+		NODE_SET_METHOD(exports, "OBS_API_setFrameTraceOutput", api::OBS_API_setFrameTraceOutput);
+		NODE_SET_METHOD(exports, "OBS_API_resetFrameLatency", api::OBS_API_resetFrameLatency);
+		NODE_SET_METHOD(exports, "OBS_API_getCallStatistics", api::OBS_API_getCallStatistics);
+		NODE_SET_METHOD(exports, "OBS_API_getCallTrace", api::OBS_API_getCallTrace);
+		NODE_SET_METHOD(exports, "OBS_API_setCallSampling", api::OBS_API_setCallSampling);
+		NODE_SET_METHOD(exports, "OBS_API_resetCallStatistics", api::OBS_API_resetCallStatistics);
+		NODE_SET_METHOD(exports, "OBS_API_getHandleCounters", api::OBS_API_getHandleCounters);
+		NODE_SET_METHOD(exports, "OBS_API_getLogStatistics", api::OBS_API_getLogStatistics);
 		NODE_SET_METHOD(exports, "SetWorkingDirectory", api::SetWorkingDirectory);
 		NODE_SET_METHOD(exports, "StopCrashHandler", api::StopCrashHandler);
 	});
@@ -7,6 +7,18 @@ namespace api
 	static void OBS_API_initAPI(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_API_destroyOBS_API(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void OBS_API_getPerformanceStatistics(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getPerformanceSeries(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getModuleTimings(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getFrameLatency(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getFrameTrace(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_setFrameTraceOutput(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_resetFrameLatency(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getCallStatistics(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getCallTrace(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_setCallSampling(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_resetCallStatistics(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getHandleCounters(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void OBS_API_getLogStatistics(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void SetWorkingDirectory(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void StopCrashHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
 } // namespace api
@@ -1,11 +1,12 @@
 #include "nodeobs_autoconfig.hpp"
+#include "events.hpp"
 #include "shared.hpp"
 
 using namespace std::placeholders;
 
 AutoConfig::~AutoConfig()
 {
-	stop_worker();
+	unsubscribe();
 	stop_async_runner();
 }
 
@@ -51,24 +52,36 @@ void AutoConfig::callback_handler(void* data, std::shared_ptr<AutoConfigInfo> it
 	Nan::Call(m_callback_function, 1, args);
 }
 
-void AutoConfig::start_worker()
+void AutoConfig::subscribe()
 {
-	if (!m_worker_stop)
+	if (m_subscribed)
 		return;
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&AutoConfig::worker, this));
+
+	m_subscribed = true;
+	osn::Events::Subscribe(EventType::AutoConfig, [this](std::vector<ipc::value>& event) {
+		if (event.size() < 3)
+			return;
+
+		std::shared_ptr<AutoConfigInfo> data = std::make_shared<AutoConfigInfo>();
+
+		data->event       = event[0].value_str;
+		data->description = event[1].value_str;
+		data->percentage  = event[2].value_union.fp64;
+		data->param       = this;
+
+		std::unique_lock<std::mutex> ul(m_worker_lock);
+		if (m_async_callback)
+			m_async_callback->queue(std::move(data));
+	});
 }
 
-void AutoConfig::stop_worker()
+void AutoConfig::unsubscribe()
 {
-	if (m_worker_stop != false)
+	if (!m_subscribed)
 		return;
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
+
+	m_subscribed = false;
+	osn::Events::Unsubscribe(EventType::AutoConfig);
 }
 
 void AutoConfig::set_keepalive(v8::Local<v8::Object> obj)
@@ -78,48 +91,6 @@ void AutoConfig::set_keepalive(v8::Local<v8::Object> obj)
 	m_async_callback->set_keepalive(obj);
 }
 
-void AutoConfig::worker()
-{
-	size_t totalSleepMS = 0;
-
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
-		}
-
-		// Call
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<AutoConfigInfo> data = std::make_shared<AutoConfigInfo>();
-
-				data->event       = response[1].value_str;
-				data->description = response[2].value_str;
-				data->percentage  = response[3].value_union.fp64;
-				data->param       = this;
-
-				m_async_callback->queue(std::move(data));
-			}
-		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
-}
-
 void autoConfig::GetListServer(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
 	std::string service, continent;
@@ -132,7 +103,7 @@ void autoConfig::GetListServer(const v8::FunctionCallbackInfo<v8::Value>& args)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("AutoConfig", "GetListServer", {service, continent});
+	    CallSynchronous(conn, "AutoConfig", "GetListServer", {service, continent});
 
 	ValidateResponse(response);
 
@@ -178,7 +149,7 @@ void autoConfig::InitializeAutoConfig(const v8::FunctionCallbackInfo<v8::Value>&
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("AutoConfig", "InitializeAutoConfig", {continent, service});
+	    CallSynchronous(conn, "AutoConfig", "InitializeAutoConfig", {continent, service});
 
 	ValidateResponse(response);
 
@@ -187,7 +158,7 @@ void autoConfig::InitializeAutoConfig(const v8::FunctionCallbackInfo<v8::Value>&
 	autoConfigObject->m_callback_function.Reset(callback);
 	autoConfigObject->start_async_runner();
 	autoConfigObject->set_keepalive(args.This());
-	autoConfigObject->start_worker();
+	autoConfigObject->subscribe();
 	args.GetReturnValue().Set(true);
 }
 
@@ -197,7 +168,34 @@ void autoConfig::StartBandwidthTest(const v8::FunctionCallbackInfo<v8::Value>& a
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartBandwidthTest", {});
+	std::vector<ipc::value> arguments;
+
+	// Optional { parallel: boolean, candidates: number, servers: string[] }, the
+	//  servers replace the ingest list of the service, e.g. to test against a
+	//  local RTMP sink.
+	if (args.Length() > 0 && args[0]->IsObject()) {
+		v8::Isolate*          isolate = args.GetIsolate();
+		v8::Local<v8::Object> options = args[0].As<v8::Object>();
+
+		v8::Local<v8::Value> parallel   = options->Get(v8::String::NewFromUtf8(isolate, "parallel"));
+		v8::Local<v8::Value> candidates = options->Get(v8::String::NewFromUtf8(isolate, "candidates"));
+		v8::Local<v8::Value> servers    = options->Get(v8::String::NewFromUtf8(isolate, "servers"));
+
+		std::string urls;
+		if (servers->IsArray()) {
+			v8::Local<v8::Array> list = servers.As<v8::Array>();
+			for (uint32_t idx = 0; idx < list->Length(); idx++) {
+				v8::String::Utf8Value url(list->Get(idx));
+				urls += std::string(*url) + "\n";
+			}
+		}
+
+		arguments.push_back(ipc::value(uint32_t(parallel->IsUndefined() ? true : parallel->BooleanValue())));
+		arguments.push_back(ipc::value(uint32_t(candidates->IsNumber() ? candidates->Uint32Value() : 3)));
+		arguments.push_back(ipc::value(urls));
+	}
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartBandwidthTest", arguments);
 
 	ValidateResponse(response);
 }
@@ -208,7 +206,7 @@ void autoConfig::StartStreamEncoderTest(const v8::FunctionCallbackInfo<v8::Value
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartStreamEncoderTest", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartStreamEncoderTest", {});
 
 	ValidateResponse(response);
 }
@@ -219,7 +217,7 @@ void autoConfig::StartRecordingEncoderTest(const v8::FunctionCallbackInfo<v8::Va
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartRecordingEncoderTest", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartRecordingEncoderTest", {});
 
 	ValidateResponse(response);
 }
@@ -237,7 +235,7 @@ void autoConfig::StartCheckSettings(const v8::FunctionCallbackInfo<v8::Value>& a
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartCheckSettings", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartCheckSettings", {});
 
 	ValidateResponse(response);
 
@@ -262,7 +260,7 @@ void autoConfig::StartSetDefaultSettings(const v8::FunctionCallbackInfo<v8::Valu
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartSetDefaultSettings", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartSetDefaultSettings", {});
 
 	ValidateResponse(response);
 }
@@ -273,7 +271,7 @@ void autoConfig::StartSaveStreamSettings(const v8::FunctionCallbackInfo<v8::Valu
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartSaveStreamSettings", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartSaveStreamSettings", {});
 
 	ValidateResponse(response);
 }
@@ -284,7 +282,7 @@ void autoConfig::StartSaveSettings(const v8::FunctionCallbackInfo<v8::Value>& ar
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartSaveSettings", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "StartSaveSettings", {});
 
 	ValidateResponse(response);
 }
@@ -295,11 +293,11 @@ void autoConfig::TerminateAutoConfig(const v8::FunctionCallbackInfo<v8::Value>&
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "TerminateAutoConfig", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "AutoConfig", "TerminateAutoConfig", {});
 
 	ValidateResponse(response);
 
-	autoConfigObject->stop_worker();
+	autoConfigObject->unsubscribe();
 	autoConfigObject->stop_async_runner();
 	delete autoConfigObject;
 }
@@ -22,12 +22,9 @@ class AutoConfig : public Nan::ObjectWrap,
 	friend utilv8::ManagedObject<AutoConfig>;
 	friend utilv8::CallbackData<AutoConfigInfo, AutoConfig>;
 
-	uint32_t sleepIntervalMS = 33;
-
 	public:
-	std::thread m_worker;
-	bool        m_worker_stop = true;
-	std::mutex  m_worker_lock;
+	bool       m_subscribed = false;
+	std::mutex m_worker_lock;
 
 	AutoConfigCallback* m_async_callback = nullptr;
 	Nan::Callback       m_callback_function;
@@ -38,9 +35,8 @@ class AutoConfig : public Nan::ObjectWrap,
 	void start_async_runner();
 	void stop_async_runner();
 	void callback_handler(void* data, std::shared_ptr<AutoConfigInfo> item);
-	void start_worker();
-	void stop_worker();
-	void worker();
+	void subscribe();
+	void unsubscribe();
 	void set_keepalive(v8::Local<v8::Object>);
 
 	std::list<AutoConfigCallback*> callbacks;
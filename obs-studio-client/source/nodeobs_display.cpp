@@ -50,8 +50,8 @@ void display::OBS_content_createDisplay(const v8::FunctionCallbackInfo<v8::Value
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Display", "OBS_content_createDisplay", {ipc::value(windowHandle), ipc::value(key)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Display", "OBS_content_createDisplay", {ipc::value(windowHandle), ipc::value(key)});
 
 	ValidateResponse(response);
 }
@@ -67,7 +67,7 @@ void display::OBS_content_destroyDisplay(const v8::FunctionCallbackInfo<v8::Valu
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_destroyDisplay", {ipc::value(key)});
+	    CallSynchronous(conn, "Display", "OBS_content_destroyDisplay", {ipc::value(key)});
 
 	ValidateResponse(response);
 }
@@ -83,7 +83,7 @@ void display::OBS_content_getDisplayPreviewOffset(const v8::FunctionCallbackInfo
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_getDisplayPreviewOffset", {ipc::value(key)});
+	    CallSynchronous(conn, "Display", "OBS_content_getDisplayPreviewOffset", {ipc::value(key)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -109,7 +109,7 @@ void display::OBS_content_getDisplayPreviewSize(const v8::FunctionCallbackInfo<v
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_getDisplayPreviewSize", {ipc::value(key)});
+	    CallSynchronous(conn, "Display", "OBS_content_getDisplayPreviewSize", {ipc::value(key)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -143,7 +143,8 @@ void display::OBS_content_createSourcePreviewDisplay(const v8::FunctionCallbackI
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Display",
 	    "OBS_content_createSourcePreviewDisplay",
 	    {ipc::value(windowHandle), ipc::value(sourceName), ipc::value(key)});
@@ -168,8 +169,8 @@ void display::OBS_content_resizeDisplay(const v8::FunctionCallbackInfo<v8::Value
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Display", "OBS_content_resizeDisplay", {ipc::value(key), ipc::value(width), ipc::value(height)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Display", "OBS_content_resizeDisplay", {ipc::value(key), ipc::value(width), ipc::value(height)});
 
 	ValidateResponse(response);
 }
@@ -191,8 +192,8 @@ void display::OBS_content_moveDisplay(const v8::FunctionCallbackInfo<v8::Value>&
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Display", "OBS_content_moveDisplay", {ipc::value(key), ipc::value(x), ipc::value(y)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Display", "OBS_content_moveDisplay", {ipc::value(key), ipc::value(x), ipc::value(y)});
 
 	ValidateResponse(response);
 }
@@ -209,8 +210,8 @@ void display::OBS_content_setPaddingSize(const v8::FunctionCallbackInfo<v8::Valu
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Display", "OBS_content_setPaddingSize", {ipc::value(key), ipc::value(paddingSize)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Display", "OBS_content_setPaddingSize", {ipc::value(key), ipc::value(paddingSize)});
 
 	ValidateResponse(response);
 }
@@ -232,7 +233,8 @@ void display::OBS_content_setPaddingColor(const v8::FunctionCallbackInfo<v8::Val
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Display",
 	    "OBS_content_setPaddingColor",
 	    {ipc::value(key), ipc::value(r), ipc::value(g), ipc::value(b), ipc::value(a)});
@@ -257,7 +259,8 @@ void display::OBS_content_setOutlineColor(const v8::FunctionCallbackInfo<v8::Val
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Display",
 	    "OBS_content_setOutlineColor",
 	    {ipc::value(key), ipc::value(r), ipc::value(g), ipc::value(b), ipc::value(a)});
@@ -282,7 +285,8 @@ void display::OBS_content_setGuidelineColor(const v8::FunctionCallbackInfo<v8::V
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Display",
 	    "OBS_content_setGuidelineColor",
 	    {ipc::value(key), ipc::value(r), ipc::value(g), ipc::value(b), ipc::value(a)});
@@ -307,7 +311,8 @@ void display::OBS_content_setResizeBoxInnerColor(const v8::FunctionCallbackInfo<
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Display",
 	    "OBS_content_setResizeBoxInnerColor",
 	    {ipc::value(key), ipc::value(r), ipc::value(g), ipc::value(b), ipc::value(a)});
@@ -332,7 +337,8 @@ void display::OBS_content_setResizeBoxOuterColor(const v8::FunctionCallbackInfo<
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Display",
 	    "OBS_content_setResizeBoxOuterColor",
 	    {ipc::value(key), ipc::value(r), ipc::value(g), ipc::value(b), ipc::value(a)});
@@ -353,7 +359,7 @@ void display::OBS_content_setShouldDrawUI(const v8::FunctionCallbackInfo<v8::Val
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_setShouldDrawUI", {ipc::value(key), ipc::value(drawUI)});
+	    CallSynchronous(conn, "Display", "OBS_content_setShouldDrawUI", {ipc::value(key), ipc::value(drawUI)});
 
 	ValidateResponse(response);
 }
@@ -370,7 +376,7 @@ void display::OBS_content_selectSource(const v8::FunctionCallbackInfo<v8::Value>
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_selectSource", {ipc::value(x), ipc::value(y)});
+	    CallSynchronous(conn, "Display", "OBS_content_selectSource", {ipc::value(x), ipc::value(y)});
 
 	ValidateResponse(response);
 }
@@ -462,7 +468,7 @@ void display::OBS_content_dragSelectedSource(const v8::FunctionCallbackInfo<v8::
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_dragSelectedSource", {ipc::value(x), ipc::value(y)});
+	    CallSynchronous(conn, "Display", "OBS_content_dragSelectedSource", {ipc::value(x), ipc::value(y)});
 
 	ValidateResponse(response);
 }
@@ -478,7 +484,7 @@ void display::OBS_content_getDrawGuideLines(const v8::FunctionCallbackInfo<v8::V
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Display", "OBS_content_getDrawGuideLines", {ipc::value(key)});
+	    CallSynchronous(conn, "Display", "OBS_content_getDrawGuideLines", {ipc::value(key)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -498,8 +504,8 @@ void display::OBS_content_setDrawGuideLines(const v8::FunctionCallbackInfo<v8::V
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Display", "OBS_content_setDrawGuideLines", {ipc::value(key), ipc::value(drawGuideLines)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Display", "OBS_content_setDrawGuideLines", {ipc::value(key), ipc::value(drawGuideLines)});
 
 	ValidateResponse(response);
 }
@@ -1,6 +1,7 @@
 #include "nodeobs_service.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "events.hpp"
 #include "utility-v8.hpp"
 
 #include <node.h>
@@ -52,23 +53,36 @@ void Service::callback_handler(void* data, std::shared_ptr<SignalInfo> item)
 
 	Nan::Call(m_callback_function, 1, args);
 }
-void Service::start_worker()
+void Service::subscribe()
 {
-	if (!m_worker_stop)
+	if (m_subscribed)
 		return;
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&Service::worker, this));
+
+	m_subscribed = true;
+	osn::Events::Subscribe(EventType::OutputSignal, [this](std::vector<ipc::value>& event) {
+		if (event.size() < 4)
+			return;
+
+		std::shared_ptr<SignalInfo> data = std::make_shared<SignalInfo>();
+
+		data->outputType   = event[0].value_str;
+		data->signal       = event[1].value_str;
+		data->code         = event[2].value_union.i32;
+		data->errorMessage = event[3].value_str;
+		data->param        = this;
+
+		std::unique_lock<std::mutex> ul(m_worker_lock);
+		if (m_async_callback)
+			m_async_callback->queue(std::move(data));
+	});
 }
-void Service::stop_worker()
+void Service::unsubscribe()
 {
-	if (m_worker_stop != false)
+	if (!m_subscribed)
 		return;
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
+
+	m_subscribed = false;
+	osn::Events::Unsubscribe(EventType::OutputSignal);
 }
 
 void service::OBS_service_resetAudioContext(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -77,7 +91,7 @@ void service::OBS_service_resetAudioContext(const v8::FunctionCallbackInfo<v8::V
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_resetAudioContext", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_resetAudioContext", {});
 
 	ValidateResponse(response);
 }
@@ -88,7 +102,7 @@ void service::OBS_service_resetVideoContext(const v8::FunctionCallbackInfo<v8::V
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_resetVideoContext", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_resetVideoContext", {});
 
 	ValidateResponse(response);
 }
@@ -99,7 +113,7 @@ void service::OBS_service_createAudioEncoder(const v8::FunctionCallbackInfo<v8::
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_createAudioEncoder", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_createAudioEncoder", {});
 
 	ValidateResponse(response);
 }
@@ -111,7 +125,7 @@ void service::OBS_service_createVideoStreamingEncoder(const v8::FunctionCallback
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_createVideoStreamingEncoder", {});
+	    CallSynchronous(conn, "Service", "OBS_service_createVideoStreamingEncoder", {});
 
 	ValidateResponse(response);
 }
@@ -123,7 +137,7 @@ void service::OBS_service_createVideoRecordingEncoder(const v8::FunctionCallback
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_createVideoRecordingEncoder", {});
+	    CallSynchronous(conn, "Service", "OBS_service_createVideoRecordingEncoder", {});
 
 	ValidateResponse(response);
 }
@@ -134,7 +148,7 @@ void service::OBS_service_createService(const v8::FunctionCallbackInfo<v8::Value
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_createService", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_createService", {});
 
 	ValidateResponse(response);
 }
@@ -146,7 +160,7 @@ void service::OBS_service_createRecordingSettings(const v8::FunctionCallbackInfo
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_createRecordingSettings", {});
+	    CallSynchronous(conn, "Service", "OBS_service_createRecordingSettings", {});
 
 	ValidateResponse(response);
 }
@@ -158,7 +172,7 @@ void service::OBS_service_createStreamingOutput(const v8::FunctionCallbackInfo<v
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_createStreamingOutput", {});
+	    CallSynchronous(conn, "Service", "OBS_service_createStreamingOutput", {});
 
 	ValidateResponse(response);
 }
@@ -170,7 +184,7 @@ void service::OBS_service_createRecordingOutput(const v8::FunctionCallbackInfo<v
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_createRecordingOutput", {});
+	    CallSynchronous(conn, "Service", "OBS_service_createRecordingOutput", {});
 
 	ValidateResponse(response);
 }
@@ -181,7 +195,7 @@ void service::OBS_service_startStreaming(const v8::FunctionCallbackInfo<v8::Valu
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_startStreaming", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_startStreaming", {});
 
 	ValidateResponse(response);
 }
@@ -192,7 +206,7 @@ void service::OBS_service_startRecording(const v8::FunctionCallbackInfo<v8::Valu
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_startRecording", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_startRecording", {});
 
 	ValidateResponse(response);
 }
@@ -207,7 +221,7 @@ void service::OBS_service_stopStreaming(const v8::FunctionCallbackInfo<v8::Value
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_stopStreaming", {ipc::value(forceStop)});
+	    CallSynchronous(conn, "Service", "OBS_service_stopStreaming", {ipc::value(forceStop)});
 
 	ValidateResponse(response);
 }
@@ -218,7 +232,7 @@ void service::OBS_service_stopRecording(const v8::FunctionCallbackInfo<v8::Value
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_stopRecording", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_stopRecording", {});
 
 	ValidateResponse(response);
 }
@@ -231,7 +245,7 @@ void service::OBS_service_associateAudioAndVideoToTheCurrentStreamingContext(
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_associateAudioAndVideoToTheCurrentStreamingContext", {});
+	    CallSynchronous(conn, "Service", "OBS_service_associateAudioAndVideoToTheCurrentStreamingContext", {});
 
 	ValidateResponse(response);
 }
@@ -244,7 +258,7 @@ void service::OBS_service_associateAudioAndVideoToTheCurrentRecordingContext(
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_associateAudioAndVideoToTheCurrentRecordingContext", {});
+	    CallSynchronous(conn, "Service", "OBS_service_associateAudioAndVideoToTheCurrentRecordingContext", {});
 
 	ValidateResponse(response);
 }
@@ -256,8 +270,8 @@ void service::OBS_service_associateAudioAndVideoEncodersToTheCurrentStreamingOut
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Service", "OBS_service_associateAudioAndVideoEncodersToTheCurrentStreamingOutput", {});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Service", "OBS_service_associateAudioAndVideoEncodersToTheCurrentStreamingOutput", {});
 
 	ValidateResponse(response);
 }
@@ -269,8 +283,8 @@ void service::OBS_service_associateAudioAndVideoEncodersToTheCurrentRecordingOut
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Service", "OBS_service_associateAudioAndVideoEncodersToTheCurrentRecordingOutput", {});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Service", "OBS_service_associateAudioAndVideoEncodersToTheCurrentRecordingOutput", {});
 
 	ValidateResponse(response);
 }
@@ -282,7 +296,7 @@ void service::OBS_service_setServiceToTheStreamingOutput(const v8::FunctionCallb
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Service", "OBS_service_setServiceToTheStreamingOutput", {});
+	    CallSynchronous(conn, "Service", "OBS_service_setServiceToTheStreamingOutput", {});
 
 	ValidateResponse(response);
 }
@@ -293,7 +307,7 @@ void service::OBS_service_setRecordingSettings(const v8::FunctionCallbackInfo<v8
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "OBS_service_setRecordingSettings", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Service", "OBS_service_setRecordingSettings", {});
 
 	ValidateResponse(response);
 }
@@ -312,7 +326,7 @@ void service::OBS_service_connectOutputSignals(const v8::FunctionCallbackInfo<v8
 	}
 
 	// Send request
-	std::vector<ipc::value> rval = conn->call_synchronous_helper("Service", "OBS_service_connectOutputSignals", {});
+	std::vector<ipc::value> rval = CallSynchronous(conn, "Service", "OBS_service_connectOutputSignals", {});
 	if (!ValidateResponse(rval)) {
 		return;
 	}
@@ -328,7 +342,7 @@ void service::OBS_service_connectOutputSignals(const v8::FunctionCallbackInfo<v8
 	serviceObject->m_callback_function.Reset(callback);
 	serviceObject->start_async_runner();
 	serviceObject->set_keepalive(args.This());
-	serviceObject->start_worker();
+	serviceObject->subscribe();
 	args.GetReturnValue().Set(true);
 }
 
@@ -370,49 +384,6 @@ void service::OBS_service_connectOutputSignals(const v8::FunctionCallbackInfo<v8
 	Nan::Call(cb_binding->cb, 1, args);
 }*/
 
-void Service::worker()
-{
-	size_t totalSleepMS = 0;
-
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
-		}
-
-		// Call
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<SignalInfo> data = std::make_shared<SignalInfo>();
-
-				data->outputType   = response[1].value_str;
-				data->signal       = response[2].value_str;
-				data->code         = response[3].value_union.i32;
-				data->errorMessage = response[4].value_str;
-				data->param        = this;
-
-				m_async_callback->queue(std::move(data));
-			}
-		}
-
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
-}
-
 void Service::set_keepalive(v8::Local<v8::Object> obj)
 {
 	if (!m_async_callback)
@@ -422,7 +393,7 @@ void Service::set_keepalive(v8::Local<v8::Object> obj)
 
 void service::OBS_service_removeCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
-	serviceObject->stop_worker();
+	serviceObject->unsubscribe();
 	serviceObject->stop_async_runner();
 }
 
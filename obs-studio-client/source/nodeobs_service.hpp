@@ -23,12 +23,9 @@ class Service : public Nan::ObjectWrap, public utilv8::InterfaceObject<Service>,
 	friend utilv8::ManagedObject<Service>;
 	friend utilv8::CallbackData<SignalInfo, Service>;
 
-	uint32_t sleepIntervalMS = 33;
-
 	public:
-	std::thread m_worker;
-	bool        m_worker_stop = true;
-	std::mutex  m_worker_lock;
+	bool       m_subscribed = false;
+	std::mutex m_worker_lock;
 
 	ServiceCallback* m_async_callback = nullptr;
 	Nan::Callback    m_callback_function;
@@ -39,9 +36,8 @@ class Service : public Nan::ObjectWrap, public utilv8::InterfaceObject<Service>,
 	void start_async_runner();
 	void stop_async_runner();
 	void callback_handler(void* data, std::shared_ptr<SignalInfo> item);
-	void start_worker();
-	void stop_worker();
-	void worker();
+	void subscribe();
+	void unsubscribe();
 	void set_keepalive(v8::Local<v8::Object>);
 
 	std::list<ServiceCallback*> callbacks;
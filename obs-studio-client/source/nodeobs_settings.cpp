@@ -1,6 +1,7 @@
 #include "nodeobs_settings.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "settings-wire.hpp"
 #include "utility-v8.hpp"
 
 #include <node.h>
@@ -9,96 +10,74 @@
 #include "shared.hpp"
 #include "utility.hpp"
 
-std::vector<settings::SubCategory>
-    serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+static v8::Local<v8::Value> CurrentValueToV8(v8::Isolate* isolate, const osn::settings_wire::parameter_view& param)
 {
-	std::vector<settings::SubCategory> category;
-
-	uint32_t indexData = 0;
-	for (int i = 0; i < int(subCategoriesCount); i++) {
-		settings::SubCategory sc;
-
-		size_t* sizeMessage = reinterpret_cast<size_t*>(buffer.data() + indexData);
-		indexData += sizeof(size_t);
-
-		std::string name(buffer.data() + indexData, *sizeMessage);
-		indexData += uint32_t(*sizeMessage);
-
-		size_t* paramsCount = reinterpret_cast<size_t*>(buffer.data() + indexData);
-		indexData += sizeof(size_t);
-
-		settings::Parameter param;
-		for (size_t j = 0; j < *paramsCount; j++) {
-			size_t* sizeName = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string name(buffer.data() + indexData, *sizeName);
-			indexData += uint32_t(*sizeName);
-
-			size_t* sizeDescription = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string description(buffer.data() + indexData, *sizeDescription);
-			indexData += uint32_t(*sizeDescription);
-
-			size_t* sizeType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string type(buffer.data() + indexData, *sizeType);
-			indexData += uint32_t(*sizeType);
-
-			size_t* sizeSubType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string subType(buffer.data() + indexData, *sizeSubType);
-			indexData += uint32_t(*sizeSubType);
-
-			bool* enabled = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* masked = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* visible = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			size_t* sizeOfCurrentValue = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> currentValue;
-			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
-			indexData += uint32_t(*sizeOfCurrentValue);
-
-			size_t* sizeOfValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			size_t* countValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> values;
-			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
-			indexData += uint32_t(*sizeOfValues);
-
-			param.name         = name;
-			param.description  = description;
-			param.type         = type;
-			param.subType      = subType;
-			param.enabled      = *enabled;
-			param.masked       = *masked;
-			param.visible      = *visible;
-			param.currentValue = currentValue;
-			param.values       = values;
-			param.countValues  = *countValues;
+	osn::settings_wire::reader r(param.currentValue);
+
+	if (param.type == "OBS_PROPERTY_EDIT_TEXT" || param.type == "OBS_PROPERTY_PATH" || param.type == "OBS_PROPERTY_TEXT"
+	    || param.type == "OBS_INPUT_RESOLUTION_LIST"
+	    || (param.type == "OBS_PROPERTY_LIST" && param.subType == "OBS_COMBO_FORMAT_STRING")) {
+		return v8::String::NewFromUtf8(
+		    isolate, param.currentValue.data, v8::NewStringType::kNormal, int(param.currentValue.size))
+		    .ToLocalChecked();
+	} else if (
+	    param.type == "OBS_PROPERTY_INT" || param.type == "OBS_PROPERTY_UINT"
+	    || (param.type == "OBS_PROPERTY_LIST" && param.subType == "OBS_COMBO_FORMAT_INT")) {
+		int64_t value = 0;
+		if (r.get_i64(value))
+			return v8::Integer::New(isolate, int32_t(value));
+	} else if (param.type == "OBS_PROPERTY_BOOL") {
+		uint8_t value = 0;
+		if (r.get_u8(value))
+			return v8::Boolean::New(isolate, value != 0);
+	} else if (
+	    param.type == "OBS_PROPERTY_DOUBLE"
+	    || (param.type == "OBS_PROPERTY_LIST" && param.subType == "OBS_COMBO_FORMAT_FLOAT")) {
+		double value = 0;
+		if (r.get_f64(value))
+			return v8::Number::New(isolate, value);
+	}
+	return v8::Undefined(isolate);
+}
 
-			sc.params.push_back(param);
+static v8::Local<v8::Array> ValuesToV8(v8::Isolate* isolate, const osn::settings_wire::parameter_view& param)
+{
+	v8::Local<v8::Array>       values = v8::Array::New(isolate);
+	osn::settings_wire::reader r(param.values);
+
+	for (uint32_t k = 0; k < param.countValues; k++) {
+		v8::Local<v8::Object>    valueObject = v8::Object::New(isolate);
+		osn::settings_wire::view name;
+		uint64_t                 sizeName = 0;
+		if (!r.get_u64(sizeName) || !r.get_view(name, sizeName))
+			break;
+
+		v8::Local<v8::String> key =
+		    v8::String::NewFromUtf8(isolate, name.data, v8::NewStringType::kNormal, int(name.size)).ToLocalChecked();
+
+		if (param.subType == "OBS_COMBO_FORMAT_INT") {
+			int64_t value = 0;
+			if (!r.get_i64(value))
+				break;
+			valueObject->Set(key, v8::Integer::New(isolate, int32_t(value)));
+		} else if (param.subType == "OBS_COMBO_FORMAT_FLOAT") {
+			double value = 0;
+			if (!r.get_f64(value))
+				break;
+			valueObject->Set(key, v8::Number::New(isolate, value));
+		} else {
+			osn::settings_wire::view value;
+			uint64_t                 sizeValue = 0;
+			if (!r.get_u64(sizeValue) || !r.get_view(value, sizeValue))
+				break;
+			valueObject->Set(
+			    key,
+			    v8::String::NewFromUtf8(isolate, value.data, v8::NewStringType::kNormal, int(value.size))
+			        .ToLocalChecked());
 		}
-		sc.name        = name;
-		sc.paramsCount = uint32_t(*paramsCount);
-		category.push_back(sc);
+		values->Set(k, valueObject);
 	}
-	return category;
+	return values;
 }
 
 void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -111,7 +90,7 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Settings", "OBS_settings_getSettings", {ipc::value(category)});
+	    CallSynchronous(conn, "Settings", "OBS_settings_getSettings", {ipc::value(category)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -119,157 +98,84 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 	v8::Isolate*         isolate = v8::Isolate::GetCurrent();
 	v8::Local<v8::Array> rval    = v8::Array::New(isolate);
 
-	std::vector<settings::SubCategory> categorySettings = serializeCategory(
-	    uint32_t(response[1].value_union.ui64), uint32_t(response[2].value_union.ui64), response[3].value_bin);
+	// Build the objects straight from the response buffer, strings are only
+	//  copied once into v8.
+	const std::vector<char>&   buffer = response[1].value_bin;
+	osn::settings_wire::reader r(buffer.data(), buffer.size());
+	uint32_t                   subCategoriesCount = 0;
+	if (!osn::settings_wire::read_header(r, subCategoriesCount)) {
+		isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8(isolate, "Invalid settings buffer.")));
+		return;
+	}
+
+	for (uint32_t i = 0; i < subCategoriesCount; i++) {
+		osn::settings_wire::view name;
+		uint32_t                 paramsCount = 0;
+		if (!osn::settings_wire::read_subcategory(r, name, paramsCount))
+			break;
 
-	for (int i = 0; i < categorySettings.size(); i++) {
 		v8::Local<v8::Object> subCategory           = v8::Object::New(isolate);
 		v8::Local<v8::Array>  subCategoryParameters = v8::Array::New(isolate);
 
-		std::vector<settings::Parameter> params = categorySettings.at(i).params;
+		for (uint32_t j = 0; j < paramsCount; j++) {
+			osn::settings_wire::parameter_view param;
+			if (!osn::settings_wire::read_parameter(r, param))
+				break;
 
-		for (int j = 0; j < params.size(); j++) {
 			v8::Local<v8::Object> parameter = v8::Object::New(isolate);
 
 			parameter->Set(
-			    v8::String::NewFromUtf8(isolate, "name"), v8::String::NewFromUtf8(isolate, params.at(j).name.c_str()));
+			    v8::String::NewFromUtf8(isolate, "name"),
+			    v8::String::NewFromUtf8(isolate, param.name.data, v8::NewStringType::kNormal, int(param.name.size))
+			        .ToLocalChecked());
 
 			parameter->Set(
-			    v8::String::NewFromUtf8(isolate, "type"), v8::String::NewFromUtf8(isolate, params.at(j).type.c_str()));
+			    v8::String::NewFromUtf8(isolate, "type"),
+			    v8::String::NewFromUtf8(isolate, param.type.data, v8::NewStringType::kNormal, int(param.type.size))
+			        .ToLocalChecked());
 
 			parameter->Set(
 			    v8::String::NewFromUtf8(isolate, "description"),
-			    v8::String::NewFromUtf8(isolate, params.at(j).description.c_str()));
+			    v8::String::NewFromUtf8(
+			        isolate, param.description.data, v8::NewStringType::kNormal, int(param.description.size))
+			        .ToLocalChecked());
 
 			parameter->Set(
 			    v8::String::NewFromUtf8(isolate, "subType"),
-			    v8::String::NewFromUtf8(isolate, params.at(j).subType.c_str()));
+			    v8::String::NewFromUtf8(
+			        isolate, param.subType.data, v8::NewStringType::kNormal, int(param.subType.size))
+			        .ToLocalChecked());
 
 			// Current value
-			if (params.at(j).currentValue.size() > 0) {
-				if (params.at(j).type.compare("OBS_PROPERTY_EDIT_TEXT") == 0 ||
-					params.at(j).type.compare("OBS_PROPERTY_PATH") == 0 ||
-					params.at(j).type.compare("OBS_PROPERTY_TEXT") == 0 ||
-					params.at(j).type.compare("OBS_INPUT_RESOLUTION_LIST") == 0) {
-
-					std::string value(params.at(j).currentValue.begin(), 
-						params.at(j).currentValue.end());
-
-					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-						v8::String::NewFromUtf8(isolate, value.c_str()));
-				}
-				else if (params.at(j).type.compare("OBS_PROPERTY_INT") == 0) {
-					int64_t *value = reinterpret_cast<int64_t*>(params.at(j).currentValue.data());
-					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-						v8::Integer::New(isolate, int32_t(*value)));
-				}
-				else if (params.at(j).type.compare("OBS_PROPERTY_UINT") == 0) {
-					uint64_t *value = reinterpret_cast<uint64_t*>(params.at(j).currentValue.data());
-					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-						v8::Integer::New(isolate, int32_t(*value)));
-				}
-				else if (params.at(j).type.compare("OBS_PROPERTY_BOOL") == 0) {
-					bool *value = reinterpret_cast<bool*>(params.at(j).currentValue.data());
-					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-						v8::Boolean::New(isolate, (*value)));
-				}
-				else if (params.at(j).type.compare("OBS_PROPERTY_DOUBLE") == 0) {
-					double *value = reinterpret_cast<double*>(params.at(j).currentValue.data());
-					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-						v8::Number::New(isolate, *value));
-				}
-				else if (params.at(j).type.compare("OBS_PROPERTY_LIST") == 0) {
-					if (params.at(j).subType.compare("OBS_COMBO_FORMAT_INT") == 0) {
-						int64_t *value = reinterpret_cast<int64_t*>(params.at(j).currentValue.data());
-						parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-							v8::Integer::New(isolate, int32_t(*value)));
-					}
-					else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_FLOAT") == 0) {
-						double *value = reinterpret_cast<double*>(params.at(j).currentValue.data());
-						parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-							v8::Number::New(isolate, *value));
-					}
-					else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_STRING") == 0) {
-					std::string value(params.at(j).currentValue.begin(),
-						params.at(j).currentValue.end());
-
-					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"),
-						v8::String::NewFromUtf8(isolate, value.c_str()));
-					}
-				}
+			if (param.currentValue.size > 0) {
+				v8::Local<v8::Value> value = CurrentValueToV8(isolate, param);
+				if (!value->IsUndefined())
+					parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"), value);
 			} else {
 				parameter->Set(v8::String::NewFromUtf8(isolate, "currentValue"), v8::String::NewFromUtf8(isolate, ""));
 			}
 
 			// Values
-			v8::Local<v8::Array> values    = v8::Array::New(isolate);
-			uint32_t             indexData = 0;
-
-			for (int k = 0; k < params.at(j).countValues; k++) {
-				v8::Local<v8::Object> valueObject = v8::Object::New(isolate);
-
-				if (params.at(j).subType.compare("OBS_COMBO_FORMAT_INT") == 0) {
-					size_t* sizeName = reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
-					indexData += sizeof(size_t);
-					std::string name(params.at(j).values.data() + indexData, *sizeName);
-					indexData += uint32_t(*sizeName);
-
-					int64_t* value = reinterpret_cast<int64_t*>(params.at(j).values.data() + indexData);
-
-					indexData += sizeof(int64_t);
-
-					valueObject->Set(v8::String::NewFromUtf8(isolate, name.c_str()),
-						v8::Integer::New(isolate, int32_t(*value)));
-				}
-				else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_FLOAT") == 0) {
-					size_t *sizeName =
-						reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
-					indexData += sizeof(size_t);
-					std::string name(params.at(j).values.data() + indexData, *sizeName);
-					indexData += uint32_t(*sizeName);
-
-					double* value = reinterpret_cast<double*>(params.at(j).values.data() + indexData);
-
-					indexData += sizeof(double);
-
-					valueObject->Set(v8::String::NewFromUtf8(isolate, name.c_str()),
-						v8::Number::New(isolate, *value));
-				}
-				else {
-					size_t *sizeName =
-						reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
-					indexData += sizeof(size_t);
-					std::string name(params.at(j).values.data() + indexData, *sizeName);
-					indexData += uint32_t(*sizeName);
-
-					size_t* sizeValue = reinterpret_cast<std::size_t*>(params.at(j).values.data() + indexData);
-					indexData += sizeof(size_t);
-					std::string value(params.at(j).values.data() + indexData, *sizeValue);
-					indexData += uint32_t(*sizeValue);
-
-					valueObject->Set(
-					    v8::String::NewFromUtf8(isolate, name.c_str()),
-					    v8::String::NewFromUtf8(isolate, value.c_str()));
-				}
-				values->Set(k, valueObject);
-			}
-
-			parameter->Set(v8::String::NewFromUtf8(isolate, "values"), values);
+			parameter->Set(v8::String::NewFromUtf8(isolate, "values"), ValuesToV8(isolate, param));
 
 			parameter->Set(
-			    v8::String::NewFromUtf8(isolate, "visible"), v8::Boolean::New(isolate, params.at(j).visible));
+			    v8::String::NewFromUtf8(isolate, "visible"),
+			    v8::Boolean::New(isolate, (param.flags & osn::settings_wire::flags::Visible) != 0));
 
 			parameter->Set(
-			    v8::String::NewFromUtf8(isolate, "enabled"), v8::Boolean::New(isolate, params.at(j).enabled));
+			    v8::String::NewFromUtf8(isolate, "enabled"),
+			    v8::Boolean::New(isolate, (param.flags & osn::settings_wire::flags::Enabled) != 0));
 
-			parameter->Set(v8::String::NewFromUtf8(isolate, "masked"), v8::Boolean::New(isolate, params.at(j).masked));
+			parameter->Set(
+			    v8::String::NewFromUtf8(isolate, "masked"),
+			    v8::Boolean::New(isolate, (param.flags & osn::settings_wire::flags::Masked) != 0));
 
 			subCategoryParameters->Set(j, parameter);
 		}
 
 		subCategory->Set(
 		    v8::String::NewFromUtf8(isolate, "nameSubCategory"),
-		    v8::String::NewFromUtf8(isolate, categorySettings.at(i).name.c_str()));
+		    v8::String::NewFromUtf8(isolate, name.data, v8::NewStringType::kNormal, int(name.size)).ToLocalChecked());
 
 		subCategory->Set(v8::String::NewFromUtf8(isolate, "parameters"), subCategoryParameters);
 
@@ -280,7 +186,7 @@ void settings::OBS_settings_getSettings(const v8::FunctionCallbackInfo<v8::Value
 	return;
 }
 
-std::vector<char> deserializeCategory(uint32_t* subCategoriesCount, uint32_t* sizeStruct, v8::Local<v8::Array> settings)
+std::vector<char> deserializeCategory(v8::Local<v8::Array> settings)
 {
 	v8::Isolate*      isolate = v8::Isolate::GetCurrent();
 	std::vector<char> buffer;
@@ -379,15 +285,7 @@ std::vector<char> deserializeCategory(uint32_t* subCategoriesCount, uint32_t* si
 		sucCategories.push_back(sc);
 	}
 
-	for (int i = 0; i < sucCategories.size(); i++) {
-		std::vector<char> serializedBuf = sucCategories.at(i).serialize();
-
-		buffer.insert(buffer.end(), serializedBuf.begin(), serializedBuf.end());
-	}
-
-	*subCategoriesCount = uint32_t(sucCategories.size());
-	*sizeStruct         = uint32_t(buffer.size());
-
+	osn::settings_wire::encode(sucCategories, buffer);
 	return buffer;
 }
 
@@ -396,30 +294,65 @@ void settings::OBS_settings_saveSettings(const v8::FunctionCallbackInfo<v8::Valu
 	std::string category;
 	ASSERT_GET_VALUE(args[0], category);
 
-	uint32_t             subCategoriesCount, sizeStruct;
 	v8::Local<v8::Array> settings = v8::Local<v8::Array>::Cast(args[1]);
 
-	std::vector<char> buffer = deserializeCategory(&subCategoriesCount, &sizeStruct, settings);
+	std::vector<char> buffer = deserializeCategory(settings);
 
 	auto conn = GetConnection();
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Settings",
-	    "OBS_settings_saveSettings",
-	    {ipc::value(category), ipc::value(subCategoriesCount), ipc::value(sizeStruct), ipc::value(buffer)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Settings", "OBS_settings_saveSettings", {ipc::value(category), ipc::value(buffer)});
 
 	ValidateResponse(response);
 }
 
+// Takes the same layout as OBS_settings_saveSettings but with only the changed
+//  parameters, returns the names of the subsystems the server had to reset.
+void settings::OBS_settings_saveSettingsPatch(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	std::string category;
+	ASSERT_GET_VALUE(args[0], category);
+
+	v8::Local<v8::Array> patch = v8::Local<v8::Array>::Cast(args[1]);
+
+	std::vector<char> buffer = deserializeCategory(patch);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Settings", "OBS_settings_saveSettingsPatch", {ipc::value(category), ipc::value(buffer)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	static const std::pair<uint32_t, const char*> names[] = {{osn::settings_wire::reset::Video, "video"},
+	                                                         {osn::settings_wire::reset::Audio, "audio"},
+	                                                         {osn::settings_wire::reset::Encoder, "encoder"},
+	                                                         {osn::settings_wire::reset::Service, "service"}};
+
+	v8::Isolate*         isolate = v8::Isolate::GetCurrent();
+	v8::Local<v8::Array> rval    = v8::Array::New(isolate);
+	uint32_t             reset   = response[1].value_union.ui32;
+	uint32_t             index   = 0;
+	for (auto& name : names) {
+		if (reset & name.first)
+			rval->Set(index++, v8::String::NewFromUtf8(isolate, name.second));
+	}
+
+	args.GetReturnValue().Set(rval);
+}
+
 void settings::OBS_settings_getListCategories(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
 	auto conn = GetConnection();
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Settings", "OBS_settings_getListCategories", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Settings", "OBS_settings_getListCategories", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -441,6 +374,7 @@ INITIALIZER(nodeobs_settings)
 	initializerFunctions.push([](v8::Local<v8::Object> exports) {
 		NODE_SET_METHOD(exports, "OBS_settings_getSettings", settings::OBS_settings_getSettings);
 		NODE_SET_METHOD(exports, "OBS_settings_saveSettings", settings::OBS_settings_saveSettings);
+		NODE_SET_METHOD(exports, "OBS_settings_saveSettingsPatch", settings::OBS_settings_saveSettingsPatch);
 		NODE_SET_METHOD(exports, "OBS_settings_getListCategories", settings::OBS_settings_getListCategories);
 	});
 }
\ No newline at end of file
@@ -606,7 +606,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::PropertyObject::Modified(Nan::NAN_METHOD_ARGS_T
 	if (!conn) {
 		return;
 	}
-	auto rval = conn->call_synchronous_helper(
+	auto rval = CallSynchronous(
+	    conn,
 	    "Properties",
 	    "Modified",
 	    {ipc::value(parent_source->sourceId), ipc::value(iter->second->name), ipc::value(value)});
@@ -668,8 +669,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::PropertyObject::ButtonClicked(Nan::NAN_METHOD_A
 	if (!conn) {
 		return;
 	}
-	auto rval = conn->call_synchronous_helper(
-	    "Properties", "Clicked", {ipc::value(parent_source->sourceId), ipc::value(iter->second->name)});
+	auto rval = CallSynchronous(
+	    conn, "Properties", "Clicked", {ipc::value(parent_source->sourceId), ipc::value(iter->second->name)});
 	if (rval.size() == 0) {
 		Nan::Error("Call failed, verify IPC status.");
 		return;
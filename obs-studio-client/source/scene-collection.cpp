@@ -0,0 +1,179 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "scene-collection.hpp"
+#include <ipc-value.hpp>
+#include <map>
+#include <string>
+#include "controller.hpp"
+#include "error.hpp"
+#include "filter.hpp"
+#include "input.hpp"
+#include "ipc-batch.hpp"
+#include "scene-collection-map.hpp"
+#include "scene.hpp"
+#include "sceneitem.hpp"
+#include "shared.hpp"
+#include "transition.hpp"
+#include "utility-v8.hpp"
+
+void osn::SceneCollection::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
+{
+	auto ObsSceneCollection = Nan::New<v8::Object>();
+
+	utilv8::SetObjectField(ObsSceneCollection, "load", Load);
+	utilv8::SetObjectField(ObsSceneCollection, "save", Save);
+
+	Nan::Set(target, FIELD_NAME("SceneCollection"), ObsSceneCollection);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::SceneCollection::Load(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	ASSERT_INFO_LENGTH_AT_LEAST(info, 1);
+	std::string json;
+	ASSERT_GET_VALUE(info[0], json);
+
+	// Creation threads on the server, only used for audited source types.
+	uint32_t threads = 1;
+	if (info.Length() > 1) {
+		ASSERT_GET_VALUE(info[1], threads);
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response =
+	    CallSynchronous(conn, "SceneCollection", "Load", {ipc::value(json), ipc::value(threads)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	auto sources = Nan::New<v8::Object>();
+	auto filters = Nan::New<v8::Object>();
+	auto items   = Nan::New<v8::Object>();
+
+	// Names by uid, scene items only reference their scene and source by uid.
+	std::map<uint64_t, std::string> names;
+
+	osn::batch::reader r(response[1].value_bin);
+	uint32_t           count = 0;
+	bool               valid = r.get_count(count, sizeof(osn::SceneCollectionSource));
+	for (uint32_t idx = 0; valid && (idx < count); idx++) {
+		osn::SceneCollectionSource record;
+		std::string                name;
+		if (!r.get(&record, sizeof(record))) {
+			valid = false;
+			break;
+		}
+		if (record.name_size > r.remaining()) {
+			valid = false;
+			break;
+		}
+		name.resize(record.name_size);
+		if (!r.get(&name[0], record.name_size)) {
+			valid = false;
+			break;
+		}
+		names[record.uid] = name;
+
+		v8::Local<v8::Object> object;
+		switch (record.type) {
+		case 0: // OBS_SOURCE_TYPE_INPUT
+			object = osn::Input::Store(new osn::Input(record.uid));
+			break;
+		case 1: { // OBS_SOURCE_TYPE_FILTER
+			const std::string& parent = names[record.parent_uid];
+			auto               list   = Nan::Get(filters, utilv8::ToValue(parent)).ToLocalChecked();
+			if (!list->IsArray()) {
+				list = Nan::New<v8::Array>();
+				utilv8::SetObjectField(filters, parent.c_str(), list);
+			}
+			auto array = list.As<v8::Array>();
+			Nan::Set(array, array->Length(), osn::Filter::Store(new osn::Filter(record.uid)));
+			continue;
+		}
+		case 2: // OBS_SOURCE_TYPE_TRANSITION
+			object = osn::Transition::Store(new osn::Transition(record.uid));
+			break;
+		case 3: // OBS_SOURCE_TYPE_SCENE
+			object = osn::Scene::Store(new osn::Scene(record.uid));
+			break;
+		default:
+			continue;
+		}
+		utilv8::SetObjectField(sources, name.c_str(), object);
+	}
+
+	valid = valid && r.get_count(count, sizeof(osn::SceneCollectionItem));
+	for (uint32_t idx = 0; valid && (idx < count); idx++) {
+		osn::SceneCollectionItem record;
+		if (!r.get(&record, sizeof(record))) {
+			valid = false;
+			break;
+		}
+
+		const std::string& scene = names[record.scene_uid];
+		auto               list  = Nan::Get(items, utilv8::ToValue(scene)).ToLocalChecked();
+		if (!list->IsArray()) {
+			list = Nan::New<v8::Array>();
+			utilv8::SetObjectField(items, scene.c_str(), list);
+		}
+		auto array = list.As<v8::Array>();
+		Nan::Set(array, array->Length(), osn::SceneItem::Store(new osn::SceneItem(record.uid)));
+	}
+
+	if (!valid) {
+		Nan::ThrowError("Malformed scene collection id map.");
+		return;
+	}
+
+	auto timings = Nan::New<v8::Object>();
+	utilv8::SetObjectField(timings, "parse", response[2].value_union.fp64);
+	utilv8::SetObjectField(timings, "create", response[3].value_union.fp64);
+	utilv8::SetObjectField(timings, "load", response[4].value_union.fp64);
+	utilv8::SetObjectField(timings, "map", response[5].value_union.fp64);
+
+	auto result = Nan::New<v8::Object>();
+	utilv8::SetObjectField(result, "sources", sources);
+	utilv8::SetObjectField(result, "filters", filters);
+	utilv8::SetObjectField(result, "items", items);
+	utilv8::SetObjectField(result, "timings", timings);
+	utilv8::SetObjectField(result, "threads", response[6].value_union.ui32);
+	info.GetReturnValue().Set(result);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::SceneCollection::Save(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(conn, "SceneCollection", "Save", {});
+
+	if (!ValidateResponse(response))
+		return;
+
+	auto timings = Nan::New<v8::Object>();
+	utilv8::SetObjectField(timings, "collect", response[2].value_union.fp64);
+	utilv8::SetObjectField(timings, "serialize", response[3].value_union.fp64);
+
+	auto result = Nan::New<v8::Object>();
+	utilv8::SetObjectField(result, "data", response[1].value_str);
+	utilv8::SetObjectField(result, "timings", timings);
+	info.GetReturnValue().Set(result);
+}
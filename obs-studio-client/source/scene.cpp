@@ -17,13 +17,16 @@
 
 #include "scene.hpp"
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "input.hpp"
 #include "ipc-value.hpp"
 #include "sceneitem.hpp"
+#include "sceneitem-transform.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -53,12 +56,16 @@ void osn::Scene::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 
 	utilv8::SetTemplateAccessorProperty(objtemplate, "source", AsSource);
 	utilv8::SetTemplateField(objtemplate, "duplicate", Duplicate);
+	utilv8::SetTemplateField(objtemplate, "duplicateAsync", DuplicateAsync);
+	utilv8::SetTemplateField(objtemplate, "duplicateWithItems", DuplicateWithItems);
 	utilv8::SetTemplateField(objtemplate, "add", AddSource);
 	utilv8::SetTemplateField(objtemplate, "findItem", FindItem);
 	utilv8::SetTemplateField(objtemplate, "moveItem", MoveItem);
 	utilv8::SetTemplateField(objtemplate, "getItemAtIdx", GetItemAtIndex);
 	utilv8::SetTemplateField(objtemplate, "getItems", GetItems);
 	utilv8::SetTemplateField(objtemplate, "getItemsInRange", GetItemsInRange);
+	utilv8::SetTemplateField(objtemplate, "getItemsTransforms", GetItemsTransforms);
+	utilv8::SetTemplateField(objtemplate, "setItemsTransforms", SetItemsTransforms);
 	utilv8::SetTemplateField(objtemplate, "connect", Connect);
 	utilv8::SetTemplateField(objtemplate, "disconnect", Disconnect);
 
@@ -79,7 +86,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Create(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "Create", std::vector<ipc::value>{ipc::value(name)});
+	    CallSynchronous(conn, "Scene", "Create", std::vector<ipc::value>{ipc::value(name)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -103,7 +110,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::CreatePrivate(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "CreatePrivate", std::vector<ipc::value>{ipc::value(name)});
+	    CallSynchronous(conn, "Scene", "CreatePrivate", std::vector<ipc::value>{ipc::value(name)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -125,7 +132,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::FromName(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "FromName", {ipc::value(name)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Scene", "FromName", {ipc::value(name)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -148,7 +155,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Release(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "Release", std::vector<ipc::value>{ipc::value(source->sourceId)});
+	    CallSynchronous(conn, "Scene", "Release", std::vector<ipc::value>{ipc::value(source->sourceId)});
 
 	ValidateResponse(response);
 }
@@ -165,7 +172,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Remove(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "Remove", std::vector<ipc::value>{ipc::value(source->sourceId)});
+	    CallSynchronous(conn, "Scene", "Remove", std::vector<ipc::value>{ipc::value(source->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -183,7 +190,60 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::AsSource(Nan::NAN_METHOD_ARGS_TYPE info)
 	info.GetReturnValue().Set(osn::Input::Store(obj));
 }
 
-Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Duplicate(Nan::NAN_METHOD_ARGS_TYPE info)
+// Builds the JS view of a packed transform record, wrapping its scene item.
+static v8::Local<v8::Object> TransformToObject(const osn::SceneItemTransform& record)
+{
+	auto positionObj = Nan::New<v8::Object>();
+	utilv8::SetObjectField(positionObj, "x", record.pos_x);
+	utilv8::SetObjectField(positionObj, "y", record.pos_y);
+
+	auto scaleObj = Nan::New<v8::Object>();
+	utilv8::SetObjectField(scaleObj, "x", record.scale_x);
+	utilv8::SetObjectField(scaleObj, "y", record.scale_y);
+
+	auto boundsObj = Nan::New<v8::Object>();
+	utilv8::SetObjectField(boundsObj, "x", record.bounds_x);
+	utilv8::SetObjectField(boundsObj, "y", record.bounds_y);
+
+	auto cropObj = Nan::New<v8::Object>();
+	utilv8::SetObjectField(cropObj, "left", record.crop_left);
+	utilv8::SetObjectField(cropObj, "top", record.crop_top);
+	utilv8::SetObjectField(cropObj, "right", record.crop_right);
+	utilv8::SetObjectField(cropObj, "bottom", record.crop_bottom);
+
+	osn::SceneItem* item = new osn::SceneItem(record.uid);
+
+	auto obj = Nan::New<v8::Object>();
+	utilv8::SetObjectField(obj, "item", osn::SceneItem::Store(item));
+	utilv8::SetObjectField(obj, "id", record.item_id);
+	utilv8::SetObjectField(obj, "position", positionObj);
+	utilv8::SetObjectField(obj, "rotation", record.rot);
+	utilv8::SetObjectField(obj, "scale", scaleObj);
+	utilv8::SetObjectField(obj, "alignment", record.alignment);
+	utilv8::SetObjectField(obj, "boundsType", record.bounds_type);
+	utilv8::SetObjectField(obj, "boundsAlignment", record.bounds_alignment);
+	utilv8::SetObjectField(obj, "bounds", boundsObj);
+	utilv8::SetObjectField(obj, "crop", cropObj);
+	utilv8::SetObjectField(obj, "visible", record.visible != 0);
+	utilv8::SetObjectField(obj, "selected", record.selected != 0);
+	return obj;
+}
+
+static v8::Local<v8::Array> TransformsToArray(const std::vector<char>& buffer)
+{
+	size_t count = buffer.size() / sizeof(osn::SceneItemTransform);
+
+	auto arr = Nan::New<v8::Array>(int(count));
+	for (size_t idx = 0; idx < count; idx++) {
+		osn::SceneItemTransform record;
+		std::memcpy(&record, buffer.data() + idx * sizeof(osn::SceneItemTransform), sizeof(osn::SceneItemTransform));
+		Nan::Set(arr, uint32_t(idx), TransformToObject(record));
+	}
+	return arr;
+}
+
+// Shared by Duplicate and DuplicateAsync, the latter returns a promise instead of blocking.
+static void DuplicateImpl(Nan::NAN_METHOD_ARGS_TYPE info, bool async)
 {
 	std::string name;
 	int         duplicate_type;
@@ -197,11 +257,24 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Duplicate(Nan::NAN_METHOD_ARGS_TYPE info
 	ASSERT_GET_VALUE(info[0], name);
 	ASSERT_GET_VALUE(info[1], duplicate_type);
 
+	if (async) {
+		info.GetReturnValue().Set(utilv8::CallAsync(
+		    "Scene",
+		    "Duplicate",
+		    std::vector<ipc::value>{ipc::value(source->sourceId), ipc::value(name), ipc::value(duplicate_type)},
+		    [](const std::vector<ipc::value>& response) {
+			    osn::Scene* obj = new osn::Scene(response[1].value_union.ui64);
+			    return v8::Local<v8::Value>(osn::Scene::Store(obj));
+		    }));
+		return;
+	}
+
 	auto conn = GetConnection();
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Scene",
 	    "Duplicate",
 	    std::vector<ipc::value>{ipc::value(source->sourceId), ipc::value(name), ipc::value(duplicate_type)});
@@ -215,6 +288,51 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Duplicate(Nan::NAN_METHOD_ARGS_TYPE info
 	info.GetReturnValue().Set(osn::Scene::Store(obj));
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::Duplicate(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	DuplicateImpl(info, false);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::DuplicateAsync(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	DuplicateImpl(info, true);
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::DuplicateWithItems(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	std::string name;
+	int         duplicate_type;
+	osn::Scene* source = nullptr;
+
+	if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Scene>(info.This(), source)) {
+		return;
+	}
+
+	ASSERT_INFO_LENGTH(info, 2);
+	ASSERT_GET_VALUE(info[0], name);
+	ASSERT_GET_VALUE(info[1], duplicate_type);
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
+	    "Scene",
+	    "DuplicateWithItems",
+	    std::vector<ipc::value>{ipc::value(source->sourceId), ipc::value(name), ipc::value(duplicate_type)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	osn::Scene* obj = new osn::Scene(response[1].value_union.ui64);
+
+	auto result = Nan::New<v8::Object>();
+	utilv8::SetObjectField(result, "scene", osn::Scene::Store(obj));
+	utilv8::SetObjectField(result, "items", TransformsToArray(response[2].value_bin));
+	info.GetReturnValue().Set(result);
+}
+
 Nan::NAN_METHOD_RETURN_TYPE osn::Scene::AddSource(Nan::NAN_METHOD_ARGS_TYPE info)
 {
 	osn::Scene* scene = nullptr;
@@ -232,8 +350,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::AddSource(Nan::NAN_METHOD_ARGS_TYPE info
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Scene", "AddSource", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(input->sourceId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Scene", "AddSource", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(input->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -272,7 +390,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::FindItem(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Scene",
 	    "FindItem",
 	    std::vector<ipc::value>{ipc::value(scene->sourceId), (haveName ? ipc::value(name) : ipc::value(position))});
@@ -302,8 +421,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::MoveItem(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Scene", "MoveItem", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(from), ipc::value(to)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
+	    "Scene",
+	    "MoveItem",
+	    std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(from), ipc::value(to)});
 
 	ValidateResponse(response);
 }
@@ -324,8 +446,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItemAtIndex(Nan::NAN_METHOD_ARGS_TYPE
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "Scene", "GetItem", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(index)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Scene", "GetItem", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(index)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -348,7 +470,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItems(Nan::NAN_METHOD_ARGS_TYPE info)
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "GetItems", std::vector<ipc::value>{ipc::value(scene->sourceId)});
+	    CallSynchronous(conn, "Scene", "GetItems", std::vector<ipc::value>{ipc::value(scene->sourceId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -379,7 +501,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItemsInRange(Nan::NAN_METHOD_ARGS_TYP
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "Scene",
 	    "GetItemsInRange",
 	    std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(from), ipc::value(to)});
@@ -397,6 +520,90 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItemsInRange(Nan::NAN_METHOD_ARGS_TYP
 	info.GetReturnValue().Set(arr);
 }
 
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::GetItemsTransforms(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::Scene* scene = nullptr;
+	if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Scene>(info.This(), scene)) {
+		return;
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Scene", "GetItemsTransforms", std::vector<ipc::value>{ipc::value(scene->sourceId)});
+
+	if (!ValidateResponse(response))
+		return;
+
+	info.GetReturnValue().Set(TransformsToArray(response[1].value_bin));
+}
+
+Nan::NAN_METHOD_RETURN_TYPE osn::Scene::SetItemsTransforms(Nan::NAN_METHOD_ARGS_TYPE info)
+{
+	osn::Scene* scene = nullptr;
+	if (!utilv8::RetrieveDynamicCast<osn::ISource, osn::Scene>(info.This(), scene)) {
+		return;
+	}
+
+	ASSERT_INFO_LENGTH(info, 1);
+	if (!info[0]->IsArray()) {
+		Nan::ThrowTypeError("Expected an array of scene item transforms.");
+		return;
+	}
+	v8::Local<v8::Array> transforms = v8::Local<v8::Array>::Cast(info[0]);
+
+	std::vector<char> buffer(transforms->Length() * sizeof(osn::SceneItemTransform));
+	for (uint32_t idx = 0; idx < transforms->Length(); idx++) {
+		v8::Local<v8::Object> obj, itemObj, positionObj, scaleObj, boundsObj, cropObj;
+		osn::SceneItemTransform record = {};
+		bool                    visible, selected;
+
+		ASSERT_GET_VALUE(Nan::Get(transforms, idx).ToLocalChecked(), obj);
+		ASSERT_GET_OBJECT_FIELD(obj, "item", itemObj);
+		ASSERT_GET_OBJECT_FIELD(obj, "position", positionObj);
+		ASSERT_GET_OBJECT_FIELD(positionObj, "x", record.pos_x);
+		ASSERT_GET_OBJECT_FIELD(positionObj, "y", record.pos_y);
+		ASSERT_GET_OBJECT_FIELD(obj, "rotation", record.rot);
+		ASSERT_GET_OBJECT_FIELD(obj, "scale", scaleObj);
+		ASSERT_GET_OBJECT_FIELD(scaleObj, "x", record.scale_x);
+		ASSERT_GET_OBJECT_FIELD(scaleObj, "y", record.scale_y);
+		ASSERT_GET_OBJECT_FIELD(obj, "alignment", record.alignment);
+		ASSERT_GET_OBJECT_FIELD(obj, "boundsType", record.bounds_type);
+		ASSERT_GET_OBJECT_FIELD(obj, "boundsAlignment", record.bounds_alignment);
+		ASSERT_GET_OBJECT_FIELD(obj, "bounds", boundsObj);
+		ASSERT_GET_OBJECT_FIELD(boundsObj, "x", record.bounds_x);
+		ASSERT_GET_OBJECT_FIELD(boundsObj, "y", record.bounds_y);
+		ASSERT_GET_OBJECT_FIELD(obj, "crop", cropObj);
+		ASSERT_GET_OBJECT_FIELD(cropObj, "left", record.crop_left);
+		ASSERT_GET_OBJECT_FIELD(cropObj, "top", record.crop_top);
+		ASSERT_GET_OBJECT_FIELD(cropObj, "right", record.crop_right);
+		ASSERT_GET_OBJECT_FIELD(cropObj, "bottom", record.crop_bottom);
+		ASSERT_GET_OBJECT_FIELD(obj, "visible", visible);
+		ASSERT_GET_OBJECT_FIELD(obj, "selected", selected);
+
+		osn::SceneItem* item = nullptr;
+		if (!osn::SceneItem::Retrieve(itemObj, item)) {
+			return;
+		}
+		record.uid      = item->itemId;
+		record.visible  = visible ? 1 : 0;
+		record.selected = selected ? 1 : 0;
+
+		std::memcpy(buffer.data() + idx * sizeof(osn::SceneItemTransform), &record, sizeof(osn::SceneItemTransform));
+	}
+
+	auto conn = GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "Scene", "SetItemsTransforms", std::vector<ipc::value>{ipc::value(scene->sourceId), ipc::value(buffer)});
+
+	ValidateResponse(response);
+}
+
 /**
 If libobs allowed us the ability to parse
 or obtain info about the signals associated with
@@ -16,8 +16,11 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
 
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <string>
+#include <uv.h>
+#include <vector>
 
 #include "controller.hpp"
 #include "error.hpp"
@@ -28,11 +31,61 @@
 #include "shared.hpp"
 #include "utility.hpp"
 
+static std::vector<uint64_t>         pending_leases;
+static osn::SceneItem::LeaseCounters lease_counters;
+static uv_async_t                    lease_flush_async;
+static bool                          lease_flush_ready = false;
+
 osn::SceneItem::SceneItem(uint64_t id)
 {
 	this->itemId = id;
 }
 
+osn::SceneItem::~SceneItem()
+{
+	// Runs from the weak callback of the wrapper while V8 collects garbage,
+	//  which is no place for IPC. Defer the actual release to the loop.
+	lease_counters.collected++;
+	pending_leases.push_back(itemId);
+	if (lease_flush_ready && (pending_leases.size() == 1)) {
+		uv_async_send(&lease_flush_async);
+	}
+}
+
+osn::SceneItem::LeaseCounters osn::SceneItem::GetLeaseCounters()
+{
+	LeaseCounters counters = lease_counters;
+	counters.pending       = pending_leases.size();
+	return counters;
+}
+
+void osn::SceneItem::FlushLeases()
+{
+	if (pending_leases.empty()) {
+		return;
+	}
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn) {
+		// The server and every id it handed out are gone already.
+		pending_leases.clear();
+		return;
+	}
+
+	std::vector<char> buffer(pending_leases.size() * sizeof(uint64_t));
+	std::memcpy(buffer.data(), pending_leases.data(), buffer.size());
+	pending_leases.clear();
+
+	// Nobody waits for the answer, stale ids are only counted by the server.
+	lease_counters.flushes++;
+	conn->call(
+	    "SceneItem",
+	    "ReleaseLeases",
+	    std::vector<ipc::value>{ipc::value(buffer)},
+	    [](const void* data, const std::vector<ipc::value>& rval) {},
+	    nullptr);
+}
+
 Nan::Persistent<v8::FunctionTemplate> osn::SceneItem::prototype = Nan::Persistent<v8::FunctionTemplate>();
 
 void osn::SceneItem::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
@@ -70,6 +123,11 @@ void osn::SceneItem::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
 	// Stuff
 	utilv8::SetObjectField(target, "SceneItem", fnctemplate->GetFunction());
 	prototype.Reset(fnctemplate);
+
+	// Unreferenced so that pending releases never keep the process alive.
+	uv_async_init(uv_default_loop(), &lease_flush_async, [](uv_async_t* handle) { FlushLeases(); });
+	uv_unref(reinterpret_cast<uv_handle_t*>(&lease_flush_async));
+	lease_flush_ready = true;
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetSource(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -85,7 +143,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetSource(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetSource", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetSource", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -107,7 +165,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScene(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetScene", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetScene", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -129,7 +187,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::Remove(Nan::NAN_METHOD_ARGS_TYPE inf
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "Remove", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "Remove", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -148,7 +206,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::IsVisible(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "IsVisible", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "IsVisible", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -172,8 +230,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetVisible(Nan::NAN_METHOD_ARGS_TYPE
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetVisible", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetVisible", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
 	ValidateResponse(response);
 }
@@ -190,7 +248,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::IsSelected(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "IsSelected", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "IsSelected", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -214,8 +272,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetSelected(Nan::NAN_METHOD_ARGS_TYP
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetSelected", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetSelected", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
 	ValidateResponse(response);
 }
@@ -232,7 +290,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetPosition(Nan::NAN_METHOD_ARGS_TYP
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetPosition", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetPosition", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -265,8 +323,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetPosition(Nan::NAN_METHOD_ARGS_TYP
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetPosition", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
+	    "SceneItem",
+	    "SetPosition",
+	    std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
 
 	ValidateResponse(response);
 }
@@ -283,7 +344,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetRotation(Nan::NAN_METHOD_ARGS_TYP
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetRotation", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetRotation", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -308,8 +369,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetRotation(Nan::NAN_METHOD_ARGS_TYP
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(vector)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(vector)});
 
 	ValidateResponse(response);
 }
@@ -326,7 +387,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScale(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetScale", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetScale", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -359,8 +420,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetScale(Nan::NAN_METHOD_ARGS_TYPE i
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
 
 	ValidateResponse(response);
 }
@@ -377,7 +438,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetScaleFilter(Nan::NAN_METHOD_ARGS_
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetScaleFilter", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetScaleFilter", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -401,8 +462,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetScaleFilter(Nan::NAN_METHOD_ARGS_
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetScaleFilter", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetScaleFilter", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
 	ValidateResponse(response);
 }
@@ -419,7 +480,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetAlignment(Nan::NAN_METHOD_ARGS_TY
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetAlignment", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetAlignment", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -444,8 +505,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetAlignment(Nan::NAN_METHOD_ARGS_TY
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetAlignment", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetAlignment", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
 	ValidateResponse(response);
 }
@@ -462,7 +523,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBounds(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetBounds", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetBounds", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -495,8 +556,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBounds(Nan::NAN_METHOD_ARGS_TYPE
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetBounds", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
+	    "SceneItem",
+	    "SetBounds",
+	    std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(x), ipc::value(y)});
 
 	ValidateResponse(response);
 }
@@ -512,8 +576,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBoundsAlignment(Nan::NAN_METHOD_A
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "GetBoundsAlignment", std::vector<ipc::value>{ipc::value(item->itemId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "GetBoundsAlignment", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -537,8 +601,11 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBoundsAlignment(Nan::NAN_METHOD_A
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetBoundsAlignment", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
+	    "SceneItem",
+	    "SetBoundsAlignment",
+	    std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
 	ValidateResponse(response);
 }
@@ -555,7 +622,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetBoundsType(Nan::NAN_METHOD_ARGS_T
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetBoundsType", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetBoundsType", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -579,8 +646,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetBoundsType(Nan::NAN_METHOD_ARGS_T
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "SetBoundsType", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "SetBoundsType", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(visible)});
 
 	ValidateResponse(response);
 }
@@ -597,7 +664,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetCrop(Nan::NAN_METHOD_ARGS_TYPE in
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetCrop", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetCrop", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -639,7 +706,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::SetCrop(Nan::NAN_METHOD_ARGS_TYPE in
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn,
 	    "SceneItem",
 	    "SetCrop",
 	    std::vector<ipc::value>{
@@ -659,8 +727,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetTransformInfo(Nan::NAN_METHOD_ARG
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "GetTransformInfo", std::vector<ipc::value>{ipc::value(item->itemId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "GetTransformInfo", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -732,7 +800,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::GetId(Nan::NAN_METHOD_ARGS_TYPE info
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "GetId", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "GetId", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -754,7 +822,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::MoveUp(Nan::NAN_METHOD_ARGS_TYPE inf
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "MoveUp", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "MoveUp", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -772,7 +840,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::MoveDown(Nan::NAN_METHOD_ARGS_TYPE i
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "MoveDown", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "MoveDown", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	ValidateResponse(response);
 }
@@ -789,7 +857,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::MoveTop(Nan::NAN_METHOD_ARGS_TYPE in
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "MoveTop", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "MoveTop", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	ValidateResponse(response);
 }
@@ -806,7 +874,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::MoveBottom(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "MoveBottom", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "MoveBottom", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	ValidateResponse(response);
 }
@@ -826,8 +894,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::Move(Nan::NAN_METHOD_ARGS_TYPE info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "Move", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(position)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "Move", std::vector<ipc::value>{ipc::value(item->itemId), ipc::value(position)});
 
 	ValidateResponse(response);
 }
@@ -843,8 +911,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::DeferUpdateBegin(Nan::NAN_METHOD_ARG
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "DeferUpdateBegin", std::vector<ipc::value>{ipc::value(item->itemId)});
+	std::vector<ipc::value> response = CallSynchronous(
+	    conn, "SceneItem", "DeferUpdateBegin", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	ValidateResponse(response);
 }
@@ -861,7 +929,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::SceneItem::DeferUpdateEnd(Nan::NAN_METHOD_ARGS_
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(item->itemId)});
+	    CallSynchronous(conn, "SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(item->itemId)});
 
 	ValidateResponse(response);
 }
@@ -33,7 +33,19 @@ namespace osn
 		public:
 		uint64_t itemId;
 		SceneItem(uint64_t id);
-		virtual ~SceneItem(){};
+		virtual ~SceneItem();
+
+		// Every wrapper holds one lease on its id on the server. Collected
+		//  wrappers queue their id and the queue is sent back in one call per
+		//  loop iteration.
+		struct LeaseCounters
+		{
+			uint64_t collected = 0; // Wrappers collected so far.
+			uint64_t pending   = 0; // Ids waiting for the next flush.
+			uint64_t flushes   = 0; // Release calls sent to the server.
+		};
+		static LeaseCounters GetLeaseCounters();
+		static void          FlushLeases();
 
 		// JavaScript
 		public:
@@ -66,7 +66,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::Types(Nan::NAN_METHOD_ARGS_TYPE inf
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Types", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Transition", "Types", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -116,7 +116,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::Create(Nan::NAN_METHOD_ARGS_TYPE in
 		}
 	}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Create", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Transition", "Create", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -161,7 +161,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::CreatePrivate(Nan::NAN_METHOD_ARGS_
 	}
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Transition", "CreatePrivate", {std::move(params)});
+	    CallSynchronous(conn, "Transition", "CreatePrivate", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -185,7 +185,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::FromName(Nan::NAN_METHOD_ARGS_TYPE
 
 	auto params = std::vector<ipc::value>{ipc::value(name)};
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "FromName", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Transition", "FromName", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -214,7 +214,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::GetActiveSource(Nan::NAN_METHOD_ARG
 	auto params = std::vector<ipc::value>{ipc::value(obj->sourceId)};
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Transition", "GetActiveSource", {std::move(params)});
+	    CallSynchronous(conn, "Transition", "GetActiveSource", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -250,7 +250,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::Clear(Nan::NAN_METHOD_ARGS_TYPE inf
 
 	auto params = std::vector<ipc::value>{ipc::value(obj->sourceId)};
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Clear", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Transition", "Clear", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -288,7 +288,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::Set(Nan::NAN_METHOD_ARGS_TYPE info)
 
 	auto params = std::vector<ipc::value>{ipc::value(obj->sourceId), ipc::value(targetobj->sourceId)};
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Set", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Transition", "Set", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -329,7 +329,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Transition::Start(Nan::NAN_METHOD_ARGS_TYPE inf
 
 	auto params = std::vector<ipc::value>{ipc::value(obj->sourceId), ipc::value(ms), ipc::value(targetobj->sourceId)};
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Start", {std::move(params)});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Transition", "Start", {std::move(params)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -44,7 +44,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Video::GetGlobal(Nan::NAN_METHOD_ARGS_TYPE info
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Video", "GetGlobal", {});
+	std::vector<ipc::value> response = CallSynchronous(conn, "Video", "GetGlobal", {});
 
 	if (!ValidateResponse(response))
 		return;
@@ -65,7 +65,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Video::GetSkippedFrames(Nan::NAN_METHOD_ARGS_TY
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Video", "GetSkippedFrames", {ipc::value(obj->handler)});
+	    CallSynchronous(conn, "Video", "GetSkippedFrames", {ipc::value(obj->handler)});
 
 	if (!ValidateResponse(response))
 		return;
@@ -85,7 +85,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::Video::GetTotalFrames(Nan::NAN_METHOD_ARGS_TYPE
 		return;
 
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Video", "GetTotalFrames", {ipc::value(obj->handler)});
+	    CallSynchronous(conn, "Video", "GetTotalFrames", {ipc::value(obj->handler)});
 
 	if (!ValidateResponse(response))
 		return;
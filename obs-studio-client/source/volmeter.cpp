@@ -21,12 +21,16 @@
 #include <vector>
 #include "controller.hpp"
 #include "error.hpp"
+#include "events.hpp"
 #include "isource.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
+#include "volmeter-frame.hpp"
 
-using namespace std::placeholders;
+std::map<uint64_t, osn::VolMeter*> osn::VolMeter::m_subscribers;
+std::mutex                         osn::VolMeter::m_worker_lock;
+osn::VolMeterCallback*             osn::VolMeter::m_async_callback = nullptr;
 
 osn::VolMeter::VolMeter(uint64_t p_uid)
 {
@@ -35,6 +39,7 @@ osn::VolMeter::VolMeter(uint64_t p_uid)
 
 osn::VolMeter::~VolMeter()
 {
+	unsubscribe();
 }
 
 std::vector<std::unique_ptr<osn::VolMeter>> volmeters;
@@ -44,132 +49,106 @@ uint64_t osn::VolMeter::GetId()
 	return m_uid;
 }
 
-void osn::VolMeter::start_async_runner()
+void osn::VolMeter::subscribe(v8::Local<v8::Object> self, v8::Local<v8::Function> callback)
 {
-	if (m_async_callback)
-		return;
-
-	std::unique_lock<std::mutex> ul(m_worker_lock);
-
-	// Start v8/uv asynchronous runner.
-	m_async_callback = new osn::VolMeterCallback();
-	m_async_callback->set_handler(std::bind(&VolMeter::callback_handler, this, _1, _2), nullptr);
+	m_callback_function.Reset(callback);
+	m_keepalive.Reset(self);
+	m_subscribers[m_uid] = this;
+	start_dispatcher();
 }
 
-void osn::VolMeter::stop_async_runner()
+void osn::VolMeter::unsubscribe()
 {
-	if (!m_async_callback)
+	auto iter = m_subscribers.find(m_uid);
+	if (iter == m_subscribers.end())
 		return;
 
-	std::unique_lock<std::mutex> ul(m_worker_lock);
+	m_subscribers.erase(iter);
+	m_callback_function.Reset();
+	m_keepalive.Reset();
 
-	// Stop v8/uv asynchronous runner.
-	m_async_callback->clear();
-	m_async_callback->finalize();
-	m_async_callback = nullptr;
+	if (m_subscribers.empty())
+		stop_dispatcher();
 }
 
-void osn::VolMeter::callback_handler(void* data, std::shared_ptr<osn::VolMeterData> item)
+void osn::VolMeter::start_dispatcher()
 {
-	// utilv8::ToValue on a std::vector<> creates a v8::Local<v8::Array> automatically.
-	v8::Local<v8::Value> args[] = {
-	    utilv8::ToValue(item->magnitude), utilv8::ToValue(item->peak), utilv8::ToValue(item->input_peak)};
+	{
+		std::unique_lock<std::mutex> ul(m_worker_lock);
+		if (m_async_callback)
+			return;
 
-	Nan::Call(m_callback_function, 3, args);
+		// Start v8/uv asynchronous runner.
+		m_async_callback = new osn::VolMeterCallback();
+		m_async_callback->set_handler(callback_handler, nullptr);
+	}
+
+	osn::Events::Subscribe(EventType::VolMeter, [](std::vector<ipc::value>& event) {
+		if (!event.size() || (event[0].value_bin.size() == 0))
+			return;
+
+		std::unique_lock<std::mutex> ul(m_worker_lock);
+		if (!m_async_callback)
+			return;
+
+		std::shared_ptr<osn::VolMeterData> data = std::make_shared<osn::VolMeterData>();
+		data->frames.swap(event[0].value_bin);
+		m_async_callback->queue(std::move(data));
+	});
 }
 
-void osn::VolMeter::start_worker()
+void osn::VolMeter::stop_dispatcher()
 {
-	if (!m_worker_stop)
-		return;
+	{
+		std::unique_lock<std::mutex> ul(m_worker_lock);
+		if (!m_async_callback)
+			return;
+	}
 
-	// Launch worker thread.
-	m_worker_stop = false;
-	m_worker      = std::thread(std::bind(&osn::VolMeter::worker, this));
+	osn::Events::Unsubscribe(EventType::VolMeter);
+
+	std::unique_lock<std::mutex> ul(m_worker_lock);
+
+	// Stop v8/uv asynchronous runner.
+	m_async_callback->clear();
+	m_async_callback->finalize();
+	m_async_callback = nullptr;
 }
 
-void osn::VolMeter::stop_worker()
+void osn::VolMeter::callback_handler(void* data, std::shared_ptr<osn::VolMeterData> item)
 {
-	if (m_worker_stop != false)
+	std::vector<char>& buf = item->frames;
+	if (buf.size() == 0)
 		return;
 
-	// Stop worker thread.
-	m_worker_stop = true;
-	if (m_worker.joinable()) {
-		m_worker.join();
-	}
-}
+	// Copy the whole batch once, every callback then gets views into it.
+	auto buffer = v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), buf.size());
+	memcpy(buffer->GetContents().Data(), buf.data(), buf.size());
 
-void osn::VolMeter::worker()
-{
-	size_t totalSleepMS = 0;
+	size_t offset = 0;
+	while ((offset + sizeof(osn::VolMeterFrameHeader)) <= buf.size()) {
+		osn::VolMeterFrameHeader header;
+		memcpy(&header, buf.data() + offset, sizeof(header));
+		if ((offset + osn::VolMeterFrameSize(header.channels)) > buf.size())
+			break;
 
-	while (!m_worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
+		size_t data_offset = offset + sizeof(header);
+		size_t plane       = sizeof(float) * header.channels;
+		offset += osn::VolMeterFrameSize(header.channels);
 
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn) {
-			goto do_sleep;
-		}
+		// Frames may still arrive for a meter that just removed its callback.
+		auto iter = m_subscribers.find(header.uid);
+		if (iter == m_subscribers.end())
+			continue;
 
-		// Call
-		try {
-			std::unique_lock<std::mutex> ul(m_worker_lock);
-
-			if (!m_async_callback)
-				goto do_sleep;
-
-			std::vector<ipc::value> response = conn->call_synchronous_helper(
-			    "VolMeter",
-			    "Query",
-			    {
-			        ipc::value(m_uid),
-			    });
-			if (!response.size()) {
-				goto do_sleep;
-			}
-			if ((response.size() == 1) && (response[0].type == ipc::type::Null)) {
-				goto do_sleep;
-			}
-
-			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				std::shared_ptr<osn::VolMeterData> data     = std::make_shared<osn::VolMeterData>();
-				size_t                             channels = response[1].value_union.i32;
-				data->magnitude.resize(channels);
-				data->peak.resize(channels);
-				data->input_peak.resize(channels);
-				data->param = this;
-				for (size_t ch = 0; ch < channels; ch++) {
-					data->magnitude[ch]  = response[1 + ch * 3 + 0].value_union.fp32;
-					data->peak[ch]       = response[1 + ch * 3 + 1].value_union.fp32;
-					data->input_peak[ch] = response[1 + ch * 3 + 2].value_union.fp32;
-				}
-				m_async_callback->queue(std::move(data));
-			} else {
-				std::cerr << "Failed VolMeter" << std::endl;
-				break;
-			}
-		} catch (std::exception e) {
-			goto do_sleep;
-		}
+		v8::Local<v8::Value> args[] = {v8::Float32Array::New(buffer, data_offset, header.channels),
+		                               v8::Float32Array::New(buffer, data_offset + plane, header.channels),
+		                               v8::Float32Array::New(buffer, data_offset + plane * 2, header.channels)};
 
-	do_sleep:
-		auto tp_end  = std::chrono::high_resolution_clock::now();
-		auto dur     = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = m_sleep_interval - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
+		Nan::Call(iter->second->m_callback_function, 3, args);
 	}
 }
 
-void osn::VolMeter::set_keepalive(v8::Local<v8::Object> obj)
-{
-	if (!m_async_callback)
-		return;
-	m_async_callback->set_keepalive(obj);
-}
-
 Nan::Persistent<v8::FunctionTemplate> osn::VolMeter::prototype = Nan::Persistent<v8::FunctionTemplate>();
 
 void osn::VolMeter::Register(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target)
@@ -210,7 +189,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::Create(Nan::NAN_METHOD_ARGS_TYPE info
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper(
+	std::vector<ipc::value> rval = CallSynchronous(
+	    conn,
 	    "VolMeter",
 	    "Create",
 	    {
@@ -238,8 +218,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::Create(Nan::NAN_METHOD_ARGS_TYPE info
 	}
 
 	// Return created Object
-	auto newVolmeter              = std::make_unique<osn::VolMeter>(rval[1].value_union.ui64);
-	newVolmeter->m_sleep_interval = rval[2].value_union.ui32;
+	auto newVolmeter = std::make_unique<osn::VolMeter>(rval[1].value_union.ui64);
 	volmeters.push_back(std::move(newVolmeter));
 	info.GetReturnValue().Set(Store(volmeters.back().get()));
 }
@@ -253,23 +232,17 @@ Nan::NAN_METHOD_RETURN_TYPE
 		return; // Well, we can't really do anything here then.
 	}
 
-	// For each volmeter
+	// Stop delivering frames before the meters go away.
 	for (auto& volmeter : volmeters) {
-		volmeter->stop_async_runner();
-		volmeter->stop_worker();
-
-		// Call
-		std::vector<ipc::value> rval = conn->call_synchronous_helper(
-		    "VolMeter",
-		    "Destroy",
-		    {
-		        ipc::value(volmeter->GetId()),
-		    });
-
-		if (!rval.size()) {
-			return; // Nothing we can do.
-		}
+		volmeter->unsubscribe();
 	}
+
+	// Destroy all of them in a single round trip.
+	std::vector<osn::batch::call> calls;
+	for (auto& volmeter : volmeters) {
+		calls.push_back({"VolMeter", "Destroy", {ipc::value(volmeter->GetId())}});
+	}
+	Controller::GetInstance().CallBatch(calls);
 }
 
 Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::GetUpdateInterval(Nan::NAN_METHOD_ARGS_TYPE info)
@@ -291,7 +264,8 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::GetUpdateInterval(Nan::NAN_METHOD_ARG
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper(
+	std::vector<ipc::value> rval = CallSynchronous(
+	    conn,
 	    "VolMeter",
 	    "GetUpdateInterval",
 	    {
@@ -318,8 +292,6 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::GetUpdateInterval(Nan::NAN_METHOD_ARG
 		return;
 	}
 
-	self->m_sleep_interval = rval[1].value_union.ui32;
-
 	// Return DeziBel Value
 	info.GetReturnValue().Set(rval[1].value_union.ui32);
 }
@@ -346,7 +318,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::SetUpdateInterval(Nan::NAN_METHOD_ARG
 
 	// Call
 	std::vector<ipc::value> rval =
-	    conn->call_synchronous_helper("VolMeter", "SetUpdateInterval", {ipc::value(self->m_uid), ipc::value(interval)});
+	    CallSynchronous(conn, "VolMeter", "SetUpdateInterval", {ipc::value(self->m_uid), ipc::value(interval)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -368,8 +340,6 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::SetUpdateInterval(Nan::NAN_METHOD_ARG
 		return;
 	}
 
-	self->m_sleep_interval = interval;
-
 	// Return DeziBel Value
 	info.GetReturnValue().Set(rval[1].value_union.ui32);
 }
@@ -401,7 +371,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::Attach(Nan::NAN_METHOD_ARGS_TYPE info
 
 	// Call
 	std::vector<ipc::value> rval =
-	    conn->call_synchronous_helper("VolMeter", "Attach", {ipc::value(fader->m_uid), ipc::value(source->sourceId)});
+	    CallSynchronous(conn, "VolMeter", "Attach", {ipc::value(fader->m_uid), ipc::value(source->sourceId)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -443,7 +413,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::Detach(Nan::NAN_METHOD_ARGS_TYPE info
 	}
 
 	// Call
-	std::vector<ipc::value> rval = conn->call_synchronous_helper("VolMeter", "Detach", {ipc::value(fader->m_uid)});
+	std::vector<ipc::value> rval = CallSynchronous(conn, "VolMeter", "Detach", {ipc::value(fader->m_uid)});
 	if (!rval.size()) {
 		Nan::ThrowError("Failed to make IPC call, verify IPC status.");
 		return;
@@ -490,7 +460,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::AddCallback(Nan::NAN_METHOD_ARGS_TYPE
 
 		// Send request
 		std::vector<ipc::value> rval =
-		    conn->call_synchronous_helper("VolMeter", "AddCallback", {ipc::value(self->m_uid)});
+		    CallSynchronous(conn, "VolMeter", "AddCallback", {ipc::value(self->m_uid)});
 		if (!ValidateResponse(rval)) {
 			return;
 		}
@@ -501,10 +471,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::AddCallback(Nan::NAN_METHOD_ARGS_TYPE
 		}
 	}
 
-	self->m_callback_function.Reset(callback);
-	self->start_async_runner();
-	self->set_keepalive(info.This());
-	self->start_worker();
+	self->subscribe(info.This(), callback);
 
 	info.GetReturnValue().Set(true);
 }
@@ -520,9 +487,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::RemoveCallback(Nan::NAN_METHOD_ARGS_T
 		}
 	}
 
-	self->stop_worker();
-	self->stop_async_runner();
-	self->m_callback_function.Reset();
+	self->unsubscribe();
 
 	// Grab IPC Connection
 	{
@@ -533,7 +498,7 @@ Nan::NAN_METHOD_RETURN_TYPE osn::VolMeter::RemoveCallback(Nan::NAN_METHOD_ARGS_T
 
 		// Send request
 		std::vector<ipc::value> rval =
-		    conn->call_synchronous_helper("VolMeter", "RemoveCallback", {ipc::value(self->m_uid)});
+		    CallSynchronous(conn, "VolMeter", "RemoveCallback", {ipc::value(self->m_uid)});
 		if (!ValidateResponse(rval)) {
 			return;
 		}
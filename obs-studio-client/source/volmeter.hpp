@@ -16,19 +16,18 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
 
 #pragma once
+#include <map>
+#include <mutex>
 #include <nan.h>
 #include <node.h>
-#include <thread>
 #include "utility-v8.hpp"
 
 namespace osn
 {
+	// Packed frames as received from the server, see volmeter-frame.hpp.
 	struct VolMeterData
 	{
-		std::vector<float> magnitude;
-		std::vector<float> peak;
-		std::vector<float> input_peak;
-		void*              param;
+		std::vector<char> frames;
 	};
 
 	typedef utilv8::managed_callback<std::shared_ptr<osn::VolMeterData>> VolMeterCallback;
@@ -42,14 +41,15 @@ namespace osn
 		friend utilv8::CallbackData<osn::VolMeterData, osn::VolMeter>;
 
 		uint64_t m_uid;
-		uint32_t m_sleep_interval = 33;
 
-		std::thread m_worker;
-		bool        m_worker_stop = true;
-		std::mutex  m_worker_lock;
+		Nan::Callback               m_callback_function;
+		Nan::Persistent<v8::Object> m_keepalive;
 
-		osn::VolMeterCallback* m_async_callback = nullptr;
-		Nan::Callback          m_callback_function;
+		// All meters share one VolMeter event subscription and one runner
+		//  that hands the frames to v8.
+		static std::map<uint64_t, osn::VolMeter*> m_subscribers;
+		static std::mutex                         m_worker_lock;
+		static osn::VolMeterCallback*             m_async_callback;
 
 		public:
 		VolMeter(uint64_t uid);
@@ -57,15 +57,12 @@ namespace osn
 
 		uint64_t GetId();
 
-		void start_async_runner();
-		void stop_async_runner();
-		void callback_handler(void* data, std::shared_ptr<osn::VolMeterData> item);
+		void subscribe(v8::Local<v8::Object> self, v8::Local<v8::Function> callback);
+		void unsubscribe();
 
-		void start_worker();
-		void stop_worker();
-		void worker();
-
-		void set_keepalive(v8::Local<v8::Object>);
+		static void start_dispatcher();
+		static void stop_dispatcher();
+		static void callback_handler(void* data, std::shared_ptr<osn::VolMeterData> item);
 
 		public:
 		static Nan::Persistent<v8::FunctionTemplate> prototype;
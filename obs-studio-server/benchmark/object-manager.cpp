@@ -0,0 +1,257 @@
+// Benchmarks for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+// Compares utility::unique_object_manager against the range list based
+//  implementation it replaced. Usage: osn-bench-object-manager [count...]
+
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
+#include <iostream>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+#include "utility.hpp"
+
+namespace legacy
+{
+	class unique_id
+	{
+		public:
+		typedef uint64_t              id_t;
+		typedef std::pair<id_t, id_t> range_t;
+
+		id_t allocate()
+		{
+			if (allocated.size() > 0) {
+				for (auto& v : allocated) {
+					if (v.first > 0) {
+						id_t v2 = v.first - 1;
+						mark_used(v2);
+						return v2;
+					} else if (v.second < std::numeric_limits<id_t>::max()) {
+						id_t v2 = v.second + 1;
+						mark_used(v2);
+						return v2;
+					}
+				}
+			} else {
+				mark_used(0);
+				return 0;
+			}
+			return std::numeric_limits<id_t>::max();
+		}
+
+		void free(id_t v)
+		{
+			for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
+				if ((v >= iter->first) && (v <= iter->second)) {
+					if (v == iter->first) {
+						iter->first++;
+						if (iter->first > iter->second)
+							allocated.erase(iter);
+					} else if (v == iter->second) {
+						iter->second--;
+						if (iter->second < iter->first)
+							allocated.erase(iter);
+					} else {
+						range_t x;
+						x.first     = iter->first;
+						x.second    = v - 1;
+						iter->first = v + 1;
+						allocated.insert(iter, x);
+					}
+					return;
+				}
+			}
+		}
+
+		private:
+		bool mark_used(id_t v)
+		{
+			if (allocated.size() == 0) {
+				allocated.push_back({v, v});
+				return true;
+			}
+
+			bool lastWasSmaller = false;
+			for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
+				auto fiter = std::list<range_t>::iterator(iter);
+				auto riter = std::list<range_t>::reverse_iterator(iter);
+				if ((iter->first > 0) && (v == (iter->first - 1))) {
+					iter->first--;
+					riter--;
+					if ((riter != allocated.rend()) && (riter->second == (v - 1))) {
+						riter->second = iter->second;
+						allocated.erase(iter);
+					}
+					return true;
+				} else if ((iter->second < std::numeric_limits<id_t>::max()) && (v == (iter->second + 1))) {
+					iter->second++;
+					fiter++;
+					if ((fiter != allocated.end()) && (fiter->first == (v + 1))) {
+						iter->second = fiter->second;
+						allocated.erase(fiter);
+					}
+					return true;
+				} else if (lastWasSmaller && (v < iter->first)) {
+					allocated.insert(iter, {v, v});
+					return true;
+				} else if ((fiter++) == allocated.end()) {
+					allocated.insert(fiter, {v, v});
+					return true;
+				}
+				lastWasSmaller = (v > iter->second);
+			}
+			return false;
+		}
+
+		std::list<range_t> allocated;
+	};
+
+	template<typename T>
+	class unique_object_manager
+	{
+		unique_id                     id_generator;
+		std::map<unique_id::id_t, T*> object_map;
+
+		public:
+		unique_id::id_t allocate(T* obj)
+		{
+			unique_id::id_t uid = id_generator.allocate();
+			object_map.insert_or_assign(uid, obj);
+			return uid;
+		}
+
+		unique_id::id_t find(T* obj)
+		{
+			for (auto kv : object_map) {
+				if (kv.second == obj)
+					return kv.first;
+			}
+			return std::numeric_limits<unique_id::id_t>::max();
+		}
+
+		T* find(unique_id::id_t id)
+		{
+			auto iter = object_map.find(id);
+			return iter != object_map.end() ? iter->second : nullptr;
+		}
+
+		T* free(unique_id::id_t id)
+		{
+			auto iter = object_map.find(id);
+			if (iter == object_map.end())
+				return nullptr;
+			T* obj = iter->second;
+			object_map.erase(iter);
+			id_generator.free(id);
+			return obj;
+		}
+	};
+} // namespace legacy
+
+struct object
+{
+	uint64_t dummy;
+};
+
+struct result
+{
+	double allocate;
+	double find_id;
+	double find_ptr;
+	double churn;
+};
+
+// Number of measured operations per phase, the legacy pointer lookup is
+//  linear so running it once per object would take hours at 100k.
+static const size_t operations = 10000;
+
+template<typename Manager>
+static result run(size_t count)
+{
+	using clock = std::chrono::high_resolution_clock;
+	auto ns_per = [](clock::time_point a, clock::time_point b, size_t n) {
+		return double(std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count()) / double(n);
+	};
+
+	Manager               manager;
+	std::vector<object>   objects(count);
+	std::vector<uint64_t> ids(count);
+	std::mt19937_64       rng(count);
+	result                res;
+
+	auto tp = clock::now();
+	for (size_t idx = 0; idx < count; idx++) {
+		ids[idx] = manager.allocate(&objects[idx]);
+	}
+	res.allocate = ns_per(tp, clock::now(), count);
+
+	std::vector<size_t> picks(operations);
+	for (auto& pick : picks) {
+		pick = size_t(rng() % count);
+	}
+
+	volatile uint64_t sink = 0;
+	tp                     = clock::now();
+	for (size_t pick : picks) {
+		sink += uint64_t(manager.find(ids[pick]) != nullptr);
+	}
+	res.find_id = ns_per(tp, clock::now(), operations);
+
+	tp = clock::now();
+	for (size_t pick : picks) {
+		sink += manager.find(&objects[pick]);
+	}
+	res.find_ptr = ns_per(tp, clock::now(), operations);
+
+	// Release a random object and immediately allocate it again, as happens
+	//  when scene items are removed and added.
+	tp = clock::now();
+	for (size_t pick : picks) {
+		manager.free(ids[pick]);
+		ids[pick] = manager.allocate(&objects[pick]);
+	}
+	res.churn = ns_per(tp, clock::now(), operations);
+
+	return res;
+}
+
+static void print(const char* name, size_t count, result const& res)
+{
+	std::cout << name << "\t" << count << "\tallocate " << res.allocate << " ns\tfind(id) " << res.find_id
+	          << " ns\tfind(ptr) " << res.find_ptr << " ns\tfree+allocate " << res.churn << " ns" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<size_t> counts;
+	for (int idx = 1; idx < argc; idx++) {
+		counts.push_back(size_t(std::stoull(argv[idx])));
+	}
+	if (counts.size() == 0) {
+		counts = {10000, 100000};
+	}
+
+	for (size_t count : counts) {
+		print("legacy", count, run<legacy::unique_object_manager<object>>(count));
+		print("current", count, run<utility::unique_object_manager<object>>(count));
+	}
+	return 0;
+}
@@ -0,0 +1,383 @@
+// Benchmarks for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+// Round trips the Output, Video and Audio settings categories through the
+//  size_t based format OBS_settings used before and through settings-wire.hpp.
+//  Usage: osn-bench-settings-wire [iterations]
+
+#include <chrono>
+#include <cstring>
+#include <inttypes.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "settings-wire.hpp"
+
+struct Parameter
+{
+	std::string       name;
+	std::string       description;
+	std::string       type;
+	std::string       subType;
+	bool              enabled = true;
+	bool              masked  = false;
+	bool              visible = true;
+	size_t            sizeOfCurrentValue = 0;
+	std::vector<char> currentValue;
+	size_t            sizeOfValues = 0;
+	size_t            countValues  = 0;
+	std::vector<char> values;
+};
+
+struct SubCategory
+{
+	std::string            name;
+	size_t                 paramsCount = 0;
+	std::vector<Parameter> params;
+};
+
+namespace legacy
+{
+	static std::vector<char> serialize(const Parameter& p)
+	{
+		std::vector<char> buffer;
+		size_t            indexBuffer = 0;
+
+		size_t sizeStruct = p.name.length() + p.description.length() + p.type.length() + p.subType.length()
+		                    + sizeof(size_t) * 7 + sizeof(bool) * 3 + p.sizeOfCurrentValue + p.sizeOfValues;
+		buffer.resize(sizeStruct);
+
+		auto put_string = [&](const std::string& s) {
+			*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = s.length();
+			indexBuffer += sizeof(size_t);
+			memcpy(buffer.data() + indexBuffer, s.data(), s.length());
+			indexBuffer += s.length();
+		};
+		put_string(p.name);
+		put_string(p.description);
+		put_string(p.type);
+		put_string(p.subType);
+
+		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = p.enabled;
+		indexBuffer += sizeof(bool);
+		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = p.masked;
+		indexBuffer += sizeof(bool);
+		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = p.visible;
+		indexBuffer += sizeof(bool);
+
+		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = p.sizeOfCurrentValue;
+		indexBuffer += sizeof(size_t);
+		memcpy(buffer.data() + indexBuffer, p.currentValue.data(), p.sizeOfCurrentValue);
+		indexBuffer += p.sizeOfCurrentValue;
+
+		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = p.sizeOfValues;
+		indexBuffer += sizeof(size_t);
+		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = p.countValues;
+		indexBuffer += sizeof(size_t);
+		memcpy(buffer.data() + indexBuffer, p.values.data(), p.sizeOfValues);
+
+		return buffer;
+	}
+
+	static std::vector<char> serialize(const SubCategory& sc)
+	{
+		std::vector<char> buffer;
+		buffer.resize(sc.name.length() + sizeof(size_t) * 2);
+
+		*reinterpret_cast<size_t*>(buffer.data()) = sc.name.length();
+		memcpy(buffer.data() + sizeof(size_t), sc.name.data(), sc.name.length());
+		*reinterpret_cast<size_t*>(buffer.data() + sizeof(size_t) + sc.name.length()) = sc.paramsCount;
+
+		for (size_t i = 0; i < sc.params.size(); i++) {
+			std::vector<char> serializedBuf = serialize(sc.params.at(i));
+			buffer.insert(buffer.end(), serializedBuf.begin(), serializedBuf.end());
+		}
+		return buffer;
+	}
+
+	static std::vector<char> encode(const std::vector<SubCategory>& settings)
+	{
+		std::vector<char> binaryValue;
+		for (size_t i = 0; i < settings.size(); i++) {
+			std::vector<char> serializedBuf = serialize(settings.at(i));
+			binaryValue.insert(binaryValue.end(), serializedBuf.begin(), serializedBuf.end());
+		}
+		return binaryValue;
+	}
+
+	// Mirrors the old client side serializeCategory, including its copies.
+	static std::vector<SubCategory> decode(uint32_t subCategoriesCount, std::vector<char> buffer)
+	{
+		std::vector<SubCategory> category;
+		size_t                   indexData = 0;
+
+		auto get_size = [&]() {
+			size_t v = *reinterpret_cast<size_t*>(buffer.data() + indexData);
+			indexData += sizeof(size_t);
+			return v;
+		};
+		auto get_string = [&]() {
+			size_t      size = get_size();
+			std::string v(buffer.data() + indexData, size);
+			indexData += size;
+			return v;
+		};
+
+		for (uint32_t i = 0; i < subCategoriesCount; i++) {
+			SubCategory sc;
+			sc.name        = get_string();
+			sc.paramsCount = get_size();
+
+			Parameter param;
+			for (size_t j = 0; j < sc.paramsCount; j++) {
+				param.name        = get_string();
+				param.description = get_string();
+				param.type        = get_string();
+				param.subType     = get_string();
+				param.enabled     = *reinterpret_cast<bool*>(buffer.data() + indexData++);
+				param.masked      = *reinterpret_cast<bool*>(buffer.data() + indexData++);
+				param.visible     = *reinterpret_cast<bool*>(buffer.data() + indexData++);
+
+				size_t            sizeOfCurrentValue = get_size();
+				std::vector<char> currentValue(sizeOfCurrentValue);
+				memcpy(currentValue.data(), buffer.data() + indexData, sizeOfCurrentValue);
+				indexData += sizeOfCurrentValue;
+
+				size_t            sizeOfValues = get_size();
+				size_t            countValues  = get_size();
+				std::vector<char> values(sizeOfValues);
+				memcpy(values.data(), buffer.data() + indexData, sizeOfValues);
+				indexData += sizeOfValues;
+
+				param.currentValue = currentValue;
+				param.values       = values;
+				param.countValues  = countValues;
+				sc.params.push_back(param);
+			}
+			category.push_back(sc);
+		}
+		return category;
+	}
+} // namespace legacy
+
+// Builders producing the same shapes OBS_settings::serializeSettingsData does.
+static void add_list_item(Parameter& p, const std::string& name, const std::string& value)
+{
+	uint64_t sizeName = name.size(), sizeValue = value.size();
+	p.values.insert(p.values.end(), (char*)&sizeName, (char*)&sizeName + sizeof(sizeName));
+	p.values.insert(p.values.end(), name.begin(), name.end());
+	p.values.insert(p.values.end(), (char*)&sizeValue, (char*)&sizeValue + sizeof(sizeValue));
+	p.values.insert(p.values.end(), value.begin(), value.end());
+	p.sizeOfValues = p.values.size();
+	p.countValues++;
+}
+
+static Parameter make(const std::string& name, const std::string& type, const std::string& subType = "")
+{
+	Parameter p;
+	p.name        = name;
+	p.description = name + " description";
+	p.type        = type;
+	p.subType     = subType;
+	return p;
+}
+
+template<typename T>
+static Parameter make_value(const std::string& name, const std::string& type, T value)
+{
+	Parameter p = make(name, type);
+	p.currentValue.resize(sizeof(value));
+	memcpy(p.currentValue.data(), &value, sizeof(value));
+	p.sizeOfCurrentValue = sizeof(value);
+	return p;
+}
+
+static Parameter make_list(const std::string& name, const std::vector<std::string>& items)
+{
+	Parameter p = make(name, "OBS_PROPERTY_LIST", "OBS_COMBO_FORMAT_STRING");
+	for (const std::string& item : items)
+		add_list_item(p, item, item);
+	p.currentValue.assign(items.front().begin(), items.front().end());
+	p.sizeOfCurrentValue = p.currentValue.size();
+	return p;
+}
+
+static SubCategory make_category(const std::string& name, std::vector<Parameter> params)
+{
+	SubCategory sc;
+	sc.name        = name;
+	sc.params      = std::move(params);
+	sc.paramsCount = sc.params.size();
+	return sc;
+}
+
+static std::vector<SubCategory> output_settings()
+{
+	std::vector<SubCategory> settings;
+	settings.push_back(make_category("Untitled", {make_list("Mode", {"Simple", "Advanced"})}));
+
+	std::vector<Parameter> streaming = {
+	    make_list("TrackIndex", {"1", "2", "3", "4", "5", "6"}),
+	    make_list("Encoder", {"obs_x264", "ffmpeg_nvenc", "amd_amf_h264", "obs_qsv11"}),
+	    make_value("ApplyServiceSettings", "OBS_PROPERTY_BOOL", true),
+	    make_value("Rescale", "OBS_PROPERTY_BOOL", false),
+	    make_list("rate_control", {"CBR", "ABR", "VBR", "CRF"}),
+	    make_value("bitrate", "OBS_PROPERTY_INT", int64_t(2500)),
+	    make_value("keyint_sec", "OBS_PROPERTY_INT", int64_t(0)),
+	    make_list("preset", {"ultrafast", "superfast", "veryfast", "faster", "fast", "medium", "slow"}),
+	    make_list("profile", {"(None)", "baseline", "main", "high"}),
+	    make_list("tune", {"(None)", "film", "animation", "grain", "stillimage", "psnr", "ssim"}),
+	    make("x264opts", "OBS_PROPERTY_EDIT_TEXT")};
+	settings.push_back(make_category("Streaming", streaming));
+
+	std::vector<Parameter> recording = {
+	    make_list("RecType", {"Standard", "Custom Output (FFmpeg)"}),
+	    make("RecFilePath", "OBS_PROPERTY_PATH"),
+	    make_value("RecFileNameWithoutSpace", "OBS_PROPERTY_BOOL", false),
+	    make_list("RecFormat", {"flv", "mp4", "mov", "mkv", "ts", "m3u8"}),
+	    make_list("RecEncoder", {"none", "obs_x264", "ffmpeg_nvenc"}),
+	    make_value("RecRescale", "OBS_PROPERTY_BOOL", false),
+	    make("RecMuxerCustom", "OBS_PROPERTY_EDIT_TEXT")};
+	settings.push_back(make_category("Recording", recording));
+
+	for (int track = 1; track <= 6; track++) {
+		std::string name = "Audio - Track " + std::to_string(track);
+		settings.push_back(make_category(
+		    name,
+		    {make_list("Track" + std::to_string(track) + "Bitrate", {"32", "64", "96", "128", "160", "192", "320"}),
+		     make("Track" + std::to_string(track) + "Name", "OBS_PROPERTY_EDIT_TEXT")}));
+	}
+
+	settings.push_back(make_category(
+	    "Replay Buffer",
+	    {make_value("RecRB", "OBS_PROPERTY_BOOL", false), make_value("RecRBTime", "OBS_PROPERTY_INT", int64_t(20))}));
+	return settings;
+}
+
+static std::vector<SubCategory> video_settings()
+{
+	std::vector<std::string> resolutions = {"3840x2160", "2560x1440", "1920x1080", "1600x900", "1280x720",
+	                                        "1152x648",  "1024x576",  "852x480",   "640x360"};
+
+	Parameter base   = make_list("Base", resolutions);
+	base.type        = "OBS_INPUT_RESOLUTION_LIST";
+	Parameter output = make_list("Output", resolutions);
+	output.type      = "OBS_INPUT_RESOLUTION_LIST";
+
+	std::vector<Parameter> video = {
+	    base,
+	    output,
+	    make_list("ScaleType", {"bilinear", "bicubic", "lanczos"}),
+	    make_list("FPSType", {"Common FPS Values", "Integer FPS Value", "Fractional FPS Value"}),
+	    make_list("FPSCommon", {"10", "20", "24 NTSC", "29.97", "30", "48", "59.94", "60"})};
+
+	return {make_category("Untitled", video)};
+}
+
+static std::vector<SubCategory> audio_settings()
+{
+	std::vector<std::string> devices = {"Disabled", "Default", "Speakers (Realtek High Definition Audio)",
+	                                    "Headphones (USB Audio Device)", "Digital Output (S/PDIF)"};
+
+	std::vector<Parameter> audio = {make_list("SampleRate", {"44.1khz", "48khz"}),
+	                                make_list("ChannelSetup", {"Mono", "Stereo"}),
+	                                make_list("Desktop Audio", devices),
+	                                make_list("Desktop Audio 2", devices),
+	                                make_list("Mic/Auxiliary Device", devices),
+	                                make_list("Mic/Auxiliary Device 2", devices),
+	                                make_list("Mic/Auxiliary Device 3", devices)};
+
+	return {make_category("Untitled", audio)};
+}
+
+// Touches every field the way the client does when it builds the v8 objects.
+static size_t walk_views(const std::vector<char>& buffer)
+{
+	osn::settings_wire::reader r(buffer.data(), buffer.size());
+	uint32_t                   count = 0;
+	size_t                     sum   = 0;
+	if (!osn::settings_wire::read_header(r, count))
+		return 0;
+
+	for (uint32_t i = 0; i < count; i++) {
+		osn::settings_wire::view name;
+		uint32_t                 params = 0;
+		osn::settings_wire::read_subcategory(r, name, params);
+		sum += name.size;
+		for (uint32_t j = 0; j < params; j++) {
+			osn::settings_wire::parameter_view p;
+			osn::settings_wire::read_parameter(r, p);
+			sum += p.name.size + p.description.size + p.type.size + p.subType.size + p.currentValue.size
+			       + p.values.size + p.flags;
+		}
+	}
+	return sum;
+}
+
+int main(int argc, char* argv[])
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	size_t iterations = 10000;
+	if (argc > 1)
+		iterations = size_t(std::stoull(argv[1]));
+
+	std::vector<std::pair<const char*, std::vector<SubCategory>>> categories = {
+	    {"Output", output_settings()}, {"Video", video_settings()}, {"Audio", audio_settings()}};
+
+	for (auto& category : categories) {
+		const std::vector<SubCategory>& settings = category.second;
+		volatile size_t                 sink     = 0;
+
+		auto tp = clock::now();
+		for (size_t n = 0; n < iterations; n++) {
+			std::vector<char>        buffer = legacy::encode(settings);
+			std::vector<SubCategory> result = legacy::decode(uint32_t(settings.size()), buffer);
+			sink += result.size();
+		}
+		double legacy_ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - tp).count());
+
+		std::vector<char> buffer;
+		tp = clock::now();
+		for (size_t n = 0; n < iterations; n++) {
+			osn::settings_wire::encode(settings, buffer);
+			sink += walk_views(buffer);
+		}
+		double view_ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - tp).count());
+
+		tp = clock::now();
+		for (size_t n = 0; n < iterations; n++) {
+			std::vector<SubCategory> result;
+			osn::settings_wire::encode(settings, buffer);
+			osn::settings_wire::decode(buffer.data(), buffer.size(), result);
+			sink += result.size();
+		}
+		double decode_ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - tp).count());
+
+		std::vector<SubCategory> check;
+		if (!osn::settings_wire::decode(buffer.data(), buffer.size(), check)
+		    || (legacy::encode(check) != legacy::encode(settings))) {
+			std::cerr << category.first << ": round trip mismatch" << std::endl;
+			return 1;
+		}
+
+		std::cout << category.first << "\tlegacy " << legacy::encode(settings).size() << " B "
+		          << legacy_ns / iterations << " ns\twire " << buffer.size() << " B, views " << view_ns / iterations
+		          << " ns, owned " << decode_ns / iterations << " ns" << std::endl;
+	}
+	return 0;
+}
@@ -16,12 +16,17 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
 
 #include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <inttypes.h>
 #include <iostream>
 #include <ipc-class.hpp>
 #include <ipc-function.hpp>
 #include <ipc-server.hpp>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 #include "error.hpp"
@@ -30,12 +35,18 @@
 #include "nodeobs_content.h"
 #include "nodeobs_service.h"
 #include "nodeobs_settings.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-events.hpp"
 #include "osn-fader.hpp"
 #include "osn-filter.hpp"
+#include "osn-frame-trace.hpp"
 #include "osn-global.hpp"
 #include "osn-input.hpp"
+#include "osn-performance.hpp"
 #include "osn-properties.hpp"
 #include "osn-scene.hpp"
+#include "osn-scene-collection.hpp"
 #include "osn-sceneitem.hpp"
 #include "osn-source.hpp"
 #include "osn-transition.hpp"
@@ -57,28 +68,40 @@ extern "C" __declspec(dllexport) DWORD NvOptimusEnablement = 1;
 
 #define BUFFSIZE 512
 
+// Defaults for --idle-timeout and --drain-timeout, in milliseconds.
+#define IDLE_TIMEOUT 5000
+#define DRAIN_TIMEOUT 250
+
 struct ServerData
 {
-	std::mutex                                     mtx;
-	std::chrono::high_resolution_clock::time_point last_connect, last_disconnect;
-	size_t                                         count_connected = 0;
+	std::mutex                            mtx;
+	std::condition_variable               cv;
+	std::chrono::steady_clock::time_point last_connect, last_disconnect;
+	size_t                                count_connected = 0;
+	bool                                  shutdown        = false;
 };
 
 bool ServerConnectHandler(void* data, int64_t)
 {
-	ServerData*                  sd = reinterpret_cast<ServerData*>(data);
-	std::unique_lock<std::mutex> ulock(sd->mtx);
-	sd->last_connect = std::chrono::high_resolution_clock::now();
-	sd->count_connected++;
+	ServerData* sd = reinterpret_cast<ServerData*>(data);
+	{
+		std::unique_lock<std::mutex> ulock(sd->mtx);
+		sd->last_connect = std::chrono::steady_clock::now();
+		sd->count_connected++;
+	}
+	sd->cv.notify_all();
 	return true;
 }
 
 void ServerDisconnectHandler(void* data, int64_t)
 {
-	ServerData*                  sd = reinterpret_cast<ServerData*>(data);
-	std::unique_lock<std::mutex> ulock(sd->mtx);
-	sd->last_disconnect = std::chrono::high_resolution_clock::now();
-	sd->count_connected--;
+	ServerData* sd = reinterpret_cast<ServerData*>(data);
+	{
+		std::unique_lock<std::mutex> ulock(sd->mtx);
+		sd->last_disconnect = std::chrono::steady_clock::now();
+		sd->count_connected--;
+	}
+	sd->cv.notify_all();
 }
 
 namespace System
@@ -86,8 +109,12 @@ namespace System
 	static void
 	    Shutdown(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 	{
-		bool* shutdown = (bool*)data;
-		*shutdown      = true;
+		ServerData* sd = reinterpret_cast<ServerData*>(data);
+		{
+			std::unique_lock<std::mutex> ulock(sd->mtx);
+			sd->shutdown = true;
+		}
+		sd->cv.notify_all();
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		return;
 	}
@@ -140,17 +167,31 @@ int main(int argc, char* argv[])
 	// Usage:
 	// argv[0] = Path to this application. (Usually given by default if run via path-based command!)
 	// argv[1] = Path to a named socket.
+	// Optional:
+	// --idle-timeout=<ms> = Exit once no client was connected for this long, 0 to never exit. (Default: 5000)
+	// --drain-timeout=<ms> = How long to wait for pending calls after a shutdown request. (Default: 250)
 
-	if (argc != 2) {
-		std::cerr << "There must be exactly one parameter." << std::endl;
+	if (argc < 2) {
+		std::cerr << "There must be at least one parameter." << std::endl;
 		return -1;
 	}
 
+	std::chrono::milliseconds idle_timeout(IDLE_TIMEOUT), drain_timeout(DRAIN_TIMEOUT);
+	for (int idx = 2; idx < argc; idx++) {
+		if (strncmp(argv[idx], "--idle-timeout=", 15) == 0) {
+			idle_timeout = std::chrono::milliseconds(strtoul(argv[idx] + 15, nullptr, 10));
+		} else if (strncmp(argv[idx], "--drain-timeout=", 16) == 0) {
+			drain_timeout = std::chrono::milliseconds(strtoul(argv[idx] + 16, nullptr, 10));
+		} else {
+			std::cerr << "Unknown parameter " << argv[idx] << "." << std::endl;
+			return -1;
+		}
+	}
+
 	// Instance
 	ipc::server myServer;
-	bool        doShutdown = false;
 	ServerData  sd;
-	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
+	sd.last_disconnect = sd.last_connect = std::chrono::steady_clock::now();
 	sd.count_connected                   = 0;
 
 	// Classes
@@ -158,7 +199,7 @@ int main(int argc, char* argv[])
 	{
 		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("System");
 		cls->register_function(
-		    std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
+		    osn::CallStats::Function(cls, "Shutdown", std::vector<ipc::type>{}, System::Shutdown, &sd));
 		myServer.register_collection(cls);
 	};
 
@@ -181,6 +222,12 @@ int main(int argc, char* argv[])
 	OBS_settings::Register(myServer);
 	OBS_settings::Register(myServer);
 	autoConfig::Register(myServer);
+	osn::Events::Register(myServer);
+	osn::Batch::Register(myServer);
+	osn::Performance::Register(myServer);
+	osn::FrameTrace::Register(myServer);
+	osn::CallStats::Register(myServer);
+	osn::SceneCollection::Register(myServer);
 
 	// Register Connect/Disconnect Handlers
 	myServer.set_connect_handler(ServerConnectHandler, &sd);
@@ -197,21 +244,34 @@ int main(int argc, char* argv[])
 		return -2;
 	}
 
-	// Reset Connect/Disconnect time.
-	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
-
 	bool waitBeforeClosing = false;
 
-	while (!doShutdown) {
-		if (sd.count_connected == 0) {
-			auto tp    = std::chrono::high_resolution_clock::now();
-			auto delta = tp - sd.last_disconnect;
-			if (std::chrono::duration_cast<std::chrono::milliseconds>(delta).count() > 5000) {
-				doShutdown = true;
+	// Sleep until a handler changes something, instead of polling the state.
+	{
+		std::unique_lock<std::mutex> ulock(sd.mtx);
+
+		// Reset Connect/Disconnect time.
+		sd.last_disconnect = sd.last_connect = std::chrono::steady_clock::now();
+
+		while (!sd.shutdown) {
+			if ((sd.count_connected != 0) || (idle_timeout.count() == 0)) {
+				size_t connected = sd.count_connected;
+				sd.cv.wait(ulock, [&sd, connected]() { return sd.shutdown || (sd.count_connected != connected); });
+				continue;
+			}
+
+			auto deadline = sd.last_disconnect + idle_timeout;
+			if (!sd.cv.wait_until(ulock, deadline, [&sd]() { return sd.shutdown || (sd.count_connected != 0); })) {
+				sd.shutdown       = true;
 				waitBeforeClosing = true;
 			}
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+
+	// Let calls that are still waiting on the server, like the event poll, return
+	//  before the connections go away.
+	if (!osn::Events::Drain(drain_timeout)) {
+		std::cerr << "Pending calls did not finish within " << drain_timeout.count() << "ms." << std::endl;
 	}
 
 	// Wait on receive the exit message from the crash-handler
@@ -1,6 +1,11 @@
 #include "nodeobs_api.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-frame-trace.hpp"
+#include "osn-performance.hpp"
+#include "osn-settings-delta.hpp"
 #include "osn-source.hpp"
-#include "util/lexer.h"
+#include "util-log.h"
 
 #ifdef _WIN32
 
@@ -34,18 +39,56 @@
 #include <util/windows/HRError.hpp>
 #include <util/windows/WinHandle.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sys/stat.h>
+#include <thread>
+
 #include "error.hpp"
 #include "shared.hpp"
 
 
 std::string g_moduleDirectory = "";
-os_cpu_usage_info_t *cpuUsageInfo = nullptr;
-uint64_t lastBytesSent = 0;
-uint64_t lastBytesSentTime = 0;
 std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
 std::string                                            slobs_plugin;
 std::vector<std::pair<std::string, obs_module_t*>>     obsModules;
 
+// Sampling interval of osn::Performance, in milliseconds.
+#define PERFORMANCE_INTERVAL 500
+
+// Bump when the meaning of the cached entries changes.
+#define MODULE_MANIFEST_VERSION 3
+
+struct ModuleInfo
+{
+	std::string name;
+	std::string path;
+	std::string data_path;
+	int64_t     size        = 0;
+	int64_t     mtime       = 0;
+	int         result      = MODULE_ERROR;
+	bool        known       = false; // The manifest entry matches the file on disk.
+	bool        cached      = false; // Skipped because of the result in the manifest.
+	bool        deferred    = false; // Waiting for one of its types to be used.
+	bool        initialized = false;
+	double      load_ms     = 0;
+	double      init_ms     = 0;
+
+	// Types registered by obs_init_module, from the manifest until the module ran.
+	std::vector<std::string> inputs;
+	std::vector<std::string> filters;
+	std::vector<std::string> transitions;
+	bool                     eager = true; // Registers encoders, outputs or services, or has a post_load hook.
+};
+std::vector<ModuleInfo>       moduleInfos;
+std::map<std::string, size_t> deferredModules;
+std::mutex                    moduleLock;
+std::shared_timed_mutex       creationLock;
+
 #ifdef _WIN32
 std::vector<HMODULE> dynamicLibraries;
 #else
@@ -56,18 +99,32 @@ void OBS_API::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("API");
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_API_initAPI", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, OBS_API_initAPI));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_API_initAPI", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, OBS_API_initAPI));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "OBS_API_initAPI",
+	    std::vector<ipc::type>{ipc::type::String,
+	                           ipc::type::String,
+	                           ipc::type::UInt32,
+	                           ipc::type::UInt32,
+	                           ipc::type::UInt64,
+	                           ipc::type::UInt32},
+	    OBS_API_initAPI));
 	cls->register_function(
-	    std::make_shared<ipc::function>("OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
+	    osn::CallStats::Function(cls, "OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "OBS_API_getModuleTimings", std::vector<ipc::type>{}, OBS_API_getModuleTimings));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "OBS_API_getLogStatistics", std::vector<ipc::type>{}, OBS_API_getLogStatistics));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
 
-	srv.register_collection(cls);
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void replaceAll(std::string& str, const std::string& from, const std::string& to)
@@ -94,130 +151,6 @@ void OBS_API::SetWorkingDirectory(
 	AUTO_DEBUG;
 }
 
-static string GenerateTimeDateFilename(const char *extension)
-{
-	time_t     now       = time(0);
-	char       file[256] = {};
-	struct tm* cur_time;
-
-	cur_time = localtime(&now);
-	snprintf(
-	    file,
-	    sizeof(file),
-	    "%d-%02d-%02d %02d-%02d-%02d.%s",
-	    cur_time->tm_year + 1900,
-	    cur_time->tm_mon + 1,
-	    cur_time->tm_mday,
-	    cur_time->tm_hour,
-	    cur_time->tm_min,
-	    cur_time->tm_sec,
-	    extension);
-
-	return string(file);
-}
-
-static bool GetToken(lexer* lex, string& str, base_token_type type)
-{
-	base_token token;
-	if (!lexer_getbasetoken(lex, &token, IGNORE_WHITESPACE))
-		return false;
-	if (token.type != type)
-		return false;
-
-	str.assign(token.text.array, token.text.len);
-	return true;
-}
-
-static bool ExpectToken(lexer* lex, const char* str, base_token_type type)
-{
-	base_token token;
-	if (!lexer_getbasetoken(lex, &token, IGNORE_WHITESPACE))
-		return false;
-	if (token.type != type)
-		return false;
-
-	return strref_cmp(&token.text, str) == 0;
-}
-
-/* os_dirent mimics POSIX dirent structure.
-* Perhaps a better cross-platform solution can take
-* place but this is as cross-platform as it gets
-* for right now.  */
-static uint64_t ConvertLogName(const char* name)
-{
-	lexer  lex;
-	string year, month, day, hour, minute, second;
-
-	lexer_init(&lex);
-	lexer_start(&lex, name);
-
-	if (!GetToken(&lex, year, BASETOKEN_DIGIT))
-		return 0;
-	if (!ExpectToken(&lex, "-", BASETOKEN_OTHER))
-		return 0;
-	if (!GetToken(&lex, month, BASETOKEN_DIGIT))
-		return 0;
-	if (!ExpectToken(&lex, "-", BASETOKEN_OTHER))
-		return 0;
-	if (!GetToken(&lex, day, BASETOKEN_DIGIT))
-		return 0;
-	if (!GetToken(&lex, hour, BASETOKEN_DIGIT))
-		return 0;
-	if (!ExpectToken(&lex, "-", BASETOKEN_OTHER))
-		return 0;
-	if (!GetToken(&lex, minute, BASETOKEN_DIGIT))
-		return 0;
-	if (!ExpectToken(&lex, "-", BASETOKEN_OTHER))
-		return 0;
-	if (!GetToken(&lex, second, BASETOKEN_DIGIT))
-		return 0;
-
-	std::string timestring(year);
-	timestring += month + day + hour + minute + second;
-	lexer_free(&lex);
-	return std::stoull(timestring);
-}
-
-static void DeleteOldestFile(const char* location, unsigned maxLogs)
-{
-	string            oldestLog;
-	uint64_t          oldest_ts = (uint64_t)-1;
-	struct os_dirent* entry;
-
-	os_dir_t* dir = os_opendir(location);
-
-	if (!dir) {
-		std::cout << "Failed to open log directory." << std::endl;
-	}
-
-	unsigned count = 0;
-
-	while ((entry = os_readdir(dir)) != NULL) {
-		if (entry->directory || *entry->d_name == '.')
-			continue;
-
-		uint64_t ts = ConvertLogName(entry->d_name);
-
-		if (ts) {
-			if (ts < oldest_ts) {
-				oldestLog = entry->d_name;
-				oldest_ts = ts;
-			}
-
-			count++;
-		}
-	}
-
-	os_closedir(dir);
-
-	if (count > maxLogs) {
-		string delPath;
-
-		delPath = delPath + location + "/" + oldestLog;
-		os_unlink(delPath.c_str());
-	}
-}
-
 #include <chrono>
 #include <cstdarg>
 #include <varargs.h>
@@ -229,132 +162,10 @@ static void DeleteOldestFile(const char* location, unsigned maxLogs)
 #include <unistd.h>
 #endif
 
-inline std::string nodeobs_log_formatted_message(const char* format, va_list& args)
-{
-	size_t            length  = _vscprintf(format, args);
-	std::vector<char> buf     = std::vector<char>(length + 1, '\0');
-	size_t            written = vsprintf_s(buf.data(), buf.size(), format, args);
-	return std::string(buf.begin(), buf.begin() + length);
-}
-
-std::chrono::high_resolution_clock             hrc;
-std::chrono::high_resolution_clock::time_point tp = std::chrono::high_resolution_clock::now();
-static void                                    node_obs_log(int log_level, const char* msg, va_list args, void* param)
-{
-	// Calculate log time.
-	auto timeSinceStart = (std::chrono::high_resolution_clock::now() - tp);
-	auto days           = std::chrono::duration_cast<std::chrono::duration<int, ratio<86400>>>(timeSinceStart);
-	timeSinceStart -= days;
-	auto hours = std::chrono::duration_cast<std::chrono::hours>(timeSinceStart);
-	timeSinceStart -= hours;
-	auto minutes = std::chrono::duration_cast<std::chrono::minutes>(timeSinceStart);
-	timeSinceStart -= minutes;
-	auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeSinceStart);
-	timeSinceStart -= seconds;
-	auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timeSinceStart);
-	timeSinceStart -= milliseconds;
-	auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(timeSinceStart);
-	timeSinceStart -= microseconds;
-	auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timeSinceStart);
-
-	// Generate timestamp and log_level part.
-	/// Convert level int to human readable name
-	std::string levelname = "";
-	switch (log_level) {
-	case LOG_INFO:
-		levelname = "Info";
-		break;
-	case LOG_WARNING:
-		levelname = "Warning";
-		break;
-	case LOG_ERROR:
-		levelname = "Error";
-		break;
-	case LOG_DEBUG:
-		levelname = "Debug";
-		break;
-	default:
-		if (log_level <= 50) {
-			levelname = "Critical";
-		} else if (log_level > 50 && log_level < LOG_ERROR) {
-			levelname = "Error";
-		} else if (log_level > LOG_ERROR && log_level < LOG_WARNING) {
-			levelname = "Alert";
-		} else if (log_level > LOG_WARNING && log_level < LOG_INFO) {
-			levelname = "Hint";
-		} else if (log_level > LOG_INFO) {
-			levelname = "Notice";
-		}
-		break;
-	}
-
-	std::vector<char> timebuf(65535, '\0');
-	std::string       timeformat = "[%.3d:%.2d:%.2d:%.2d.%.3d.%.3d.%.3d][%*s]"; // "%*s";
-	int               length     = sprintf_s(
-        timebuf.data(),
-        timebuf.size(),
-        timeformat.c_str(),
-        days.count(),
-        hours.count(),
-        minutes.count(),
-        seconds.count(),
-        milliseconds.count(),
-        microseconds.count(),
-        nanoseconds.count(),
-        levelname.length(),
-        levelname.c_str());
-	std::string time_and_level = std::string(timebuf.data(), length);
-
-	// Format incoming text
-	std::string text = nodeobs_log_formatted_message(msg, args);
-
-	std::fstream* logStream = reinterpret_cast<std::fstream*>(param);
-
-	// Split by \n (new-line)
-	size_t last_valid_idx = 0;
-	for (size_t idx = 0; idx <= text.length(); idx++) {
-		char& ch = text[idx];
-		if ((ch == '\n') || (idx == text.length())) {
-			std::string newmsg = time_and_level + " " + std::string(&text[last_valid_idx], idx - last_valid_idx) + '\n';
-			last_valid_idx     = idx + 1;
-
-			// File Log
-			*logStream << newmsg << std::flush;
-
-			// Std Out / Std Err
-			/// Why fwrite and not std::cout and std::cerr?
-			/// Well, it seems that std::cout and std::cerr break if you click in the console window and paste.
-			/// Which is really bad, as nothing gets logged into the console anymore.
-			if (log_level <= LOG_WARNING) {
-				fwrite(newmsg.data(), sizeof(char), newmsg.length(), stderr);
-			}
-			fwrite(newmsg.data(), sizeof(char), newmsg.length(), stdout);
-
-			// Debugger
-#ifdef _WIN32
-			if (IsDebuggerPresent()) {
-				int wNum = MultiByteToWideChar(CP_UTF8, 0, newmsg.c_str(), -1, NULL, 0);
-				if (wNum > 1) {
-					std::wstring wide_buf;
-					std::mutex   wide_mutex;
-
-					lock_guard<mutex> lock(wide_mutex);
-					wide_buf.reserve(wNum + 1);
-					wide_buf.resize(wNum - 1);
-					MultiByteToWideChar(CP_UTF8, 0, newmsg.c_str(), -1, &wide_buf[0], wNum);
-
-					OutputDebugStringW(wide_buf.c_str());
-				}
-			}
-#endif
-		}
-	}
-	*logStream << std::flush;
-
-#if defined(_WIN32) && defined(OBS_DEBUGBREAK_ON_ERROR)
-	if (log_level <= LOG_ERROR && IsDebuggerPresent())
-		__debugbreak();
-#endif
+util::Logger logger;
+static void  node_obs_log(int log_level, const char* msg, va_list args, void* param)
+{
+	reinterpret_cast<util::Logger*>(param)->log(log_level, msg, args);
 }
 
 uint32_t pid = GetCurrentProcessId();
@@ -501,7 +312,6 @@ void OBS_API::OBS_API_initAPI(
 	obs_startup(locale.c_str(), userData.data(), NULL);
 
 	/* Logging */
-	string filename = GenerateTimeDateFilename("txt");
 	string log_path = appdata;
 	log_path.append("/node-obs/logs/");
 
@@ -511,21 +321,25 @@ void OBS_API::OBS_API_initAPI(
 		cerr << "Failed to open log file" << endl;
 	}
 
-	DeleteOldestFile(log_path.c_str(), 3);
-	log_path.append(filename);
-
-#if defined(_WIN32) && defined(UNICODE)
-	fstream* logfile = new fstream(converter.from_bytes(log_path.c_str()).c_str(), ios_base::out | ios_base::trunc);
-#else
-	fstream* logfile = new fstream(log_path, ios_base::out | ios_base::trunc);
-#endif
+	/* Rotates by size and keeps the three most recent files unless told
+	otherwise, a zero in any of the optional arguments keeps the default.
+	The logger clamps the capacity to util::Logger::max_capacity lines. */
+	util::Logger::Options log_options;
+	if (args.size() >= 6) {
+		if (args[2].value_union.ui32 != 0)
+			log_options.capacity = args[2].value_union.ui32;
+		if (args[3].value_union.ui32 == uint32_t(util::Logger::Overflow::Block))
+			log_options.overflow = util::Logger::Overflow::Block;
+		if (args[4].value_union.ui64 != 0)
+			log_options.max_file_size = size_t(args[4].value_union.ui64);
+		if (args[5].value_union.ui32 != 0)
+			log_options.max_files = args[5].value_union.ui32;
+	}
 
-	if (!logfile) {
+	if (!logger.start(log_path, log_options)) {
 		cerr << "Failed to open log file" << endl;
 	}
-
-	/* Delete oldest file in the folder to imitate rotating */
-	base_set_log_handler(node_obs_log, logfile);
+	base_set_log_handler(node_obs_log, &logger);
 
 	/* INJECT osn::Source::Manager */
 	// Alright, you're probably wondering: Why is osn code here?
@@ -535,12 +349,14 @@ void OBS_API::OBS_API_initAPI(
 	osn::Source::initialize_global_signals();
 	/* END INJECT osn::Source::Manager */
 
-	cpuUsageInfo = os_cpu_usage_info_start();
+	osn::Performance::Start(std::chrono::milliseconds(PERFORMANCE_INTERVAL));
+	osn::FrameTrace::Start();
+	osn::SettingsDelta::Start();
 
 	ConfigManager::getInstance().setAppdataPath(appdata);
 
 	int videoError;
-	if (!openAllModules(videoError)) {
+	if (!openAllModules(videoError, appdata + "/node-obs/module-manifest.json")) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
 		rval.push_back(ipc::value(videoError));
 		AUTO_DEBUG;
@@ -612,6 +428,37 @@ void OBS_API::OBS_API_getPerformanceStatistics(
 	AUTO_DEBUG;
 }
 
+void OBS_API::OBS_API_getModuleTimings(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+
+	// Five values per module, in the order they were loaded.
+	for (const ModuleInfo& module : moduleInfos) {
+		rval.push_back(ipc::value(module.name));
+		rval.push_back(ipc::value(int32_t(module.result)));
+		rval.push_back(ipc::value(uint32_t(module.cached)));
+		rval.push_back(ipc::value(module.load_ms));
+		rval.push_back(ipc::value(module.init_ms));
+	}
+	AUTO_DEBUG;
+}
+
+void OBS_API::OBS_API_getLogStatistics(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(logger.dropped()));
+	rval.push_back(ipc::value(logger.written()));
+	AUTO_DEBUG;
+}
+
 void OBS_API::SetProcessPriority(const char* priority)
 {
 	if (!priority)
@@ -705,7 +552,9 @@ void OBS_API::StopCrashHandler(
 
 void OBS_API::destroyOBS_API(void)
 {
-	os_cpu_usage_info_destroy(cpuUsageInfo);
+	osn::Performance::Stop();
+	osn::FrameTrace::Stop();
+	osn::SettingsDelta::Stop();
 
 #ifdef _WIN32
 	bool disableAudioDucking = config_get_bool(ConfigManager::getInstance().getBasic(), "Audio",
@@ -744,6 +593,10 @@ void OBS_API::destroyOBS_API(void)
 
 	obs_shutdown();
 
+	// Write out whatever is still queued, anything logged after this goes to the default handler.
+	base_set_log_handler(nullptr, nullptr);
+	logger.stop();
+
 	// Release each obs module (dlls for windows)
 	// TODO: For now we are releasing only the obs-browser.dll because it could lead into a specific 
 	// crash that we are trying to extinguish, the ideia is start releasing all of these dlls someday
@@ -800,7 +653,193 @@ typedef std::basic_string<char, ci_char_traits> istring;
 
 /* This should be reusable outside of node-obs, especially
 * if we go a server/client route. */
-bool OBS_API::openAllModules(int& video_err)
+static void GetManifestTypes(obs_data_t* entry, const char* name, std::vector<std::string>& types)
+{
+	obs_data_array_t* array = obs_data_get_array(entry, name);
+	size_t            count = obs_data_array_count(array);
+	for (size_t idx = 0; idx < count; idx++) {
+		obs_data_t* item = obs_data_array_item(array, idx);
+		types.push_back(obs_data_get_string(item, "id"));
+		obs_data_release(item);
+	}
+	obs_data_array_release(array);
+}
+
+static void SetManifestTypes(obs_data_t* entry, const char* name, const std::vector<std::string>& types)
+{
+	obs_data_array_t* array = obs_data_array_create();
+	for (const std::string& type : types) {
+		obs_data_t* item = obs_data_create();
+		obs_data_set_string(item, "id", type.c_str());
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(entry, name, array);
+	obs_data_array_release(array);
+}
+
+static std::set<std::string> EnumTypes(bool (*enum_types)(size_t, const char**))
+{
+	std::set<std::string> types;
+	const char*           type = nullptr;
+	for (size_t idx = 0; enum_types(idx, &type); idx++) {
+		types.insert(type ? type : "");
+	}
+	return types;
+}
+
+static std::vector<std::string> NewTypes(const std::set<std::string>& before, const std::set<std::string>& after)
+{
+	std::vector<std::string> types;
+	std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(types));
+	return types;
+}
+
+static size_t CountOtherTypes()
+{
+	return EnumTypes(obs_enum_encoder_types).size() + EnumTypes(obs_enum_output_types).size()
+	       + EnumTypes(obs_enum_service_types).size();
+}
+
+// Opens and initializes a module, 'handle' is the library prefetched by openAllModules if any.
+static void OpenModule(ModuleInfo& module, void* handle)
+{
+	std::string& plugin_path = module.path;
+
+	auto          start = std::chrono::high_resolution_clock::now();
+	obs_module_t* obs_module;
+	module.result = obs_open_module(&obs_module, plugin_path.c_str(), module.data_path.c_str());
+	module.load_ms +=
+	    std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	if (handle)
+		os_dlclose(handle);
+
+	switch (module.result) {
+	case MODULE_SUCCESS:
+		obsModules.push_back(std::make_pair(module.name, obs_module));
+		break;
+	case MODULE_FILE_NOT_FOUND:
+		std::cerr << "Unable to load '" << plugin_path << "', could not find file." << std::endl;
+		return;
+	case MODULE_MISSING_EXPORTS:
+		std::cerr << "Unable to load '" << plugin_path << "', missing exports." << std::endl;
+		return;
+	case MODULE_INCOMPATIBLE_VER:
+		std::cerr << "Unable to load '" << plugin_path << "', incompatible version." << std::endl;
+		return;
+	case MODULE_ERROR:
+		std::cerr << "Unable to load '" << plugin_path << "', generic error." << std::endl;
+		return;
+	default:
+		return;
+	}
+
+	// Remember what the module registers so later boots can defer it.
+	std::set<std::string> inputs      = EnumTypes(obs_enum_input_types);
+	std::set<std::string> filters     = EnumTypes(obs_enum_filter_types);
+	std::set<std::string> transitions = EnumTypes(obs_enum_transition_types);
+	size_t                others      = CountOtherTypes();
+
+	start        = std::chrono::high_resolution_clock::now();
+	bool success = obs_init_module(obs_module);
+	module.init_ms =
+	    std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	module.initialized = success;
+
+	if (!success) {
+		std::cerr << "Failed to initialize module " << plugin_path << std::endl;
+		return;
+	}
+
+	module.inputs      = NewTypes(inputs, EnumTypes(obs_enum_input_types));
+	module.filters     = NewTypes(filters, EnumTypes(obs_enum_filter_types));
+	module.transitions = NewTypes(transitions, EnumTypes(obs_enum_transition_types));
+	module.eager       = (CountOtherTypes() != others)
+	               || (module.inputs.empty() && module.filters.empty() && module.transitions.empty());
+
+	// post_load runs once after startup, a module opened on demand would miss it.
+	void* library = os_dlopen(plugin_path.c_str());
+	if (library) {
+		module.eager = module.eager || (os_dlsym(library, "obs_module_post_load") != nullptr);
+		os_dlclose(library);
+	}
+}
+
+static void LoadModuleManifest(const std::string& path, std::vector<ModuleInfo>& modules)
+{
+	obs_data_t* manifest = obs_data_create_from_json_file_safe(path.c_str(), "bak");
+	if (!manifest)
+		return;
+
+	// Whether a module is compatible also depends on libobs, so an update of it
+	//  invalidates every entry.
+	std::map<std::string, obs_data_t*> entries;
+	if (obs_data_get_int(manifest, "version") == MODULE_MANIFEST_VERSION
+	    && obs_data_get_int(manifest, "libobs") == obs_get_version()) {
+		obs_data_array_t* array = obs_data_get_array(manifest, "modules");
+		size_t            count = obs_data_array_count(array);
+		for (size_t idx = 0; idx < count; idx++) {
+			obs_data_t* entry = obs_data_array_item(array, idx);
+			entries.emplace(obs_data_get_string(entry, "path"), entry);
+		}
+		obs_data_array_release(array);
+	}
+
+	for (ModuleInfo& module : modules) {
+		auto iter = entries.find(module.path);
+		if (iter == entries.end())
+			continue;
+
+		// Only failures that a rebuild of the plugin fixes are remembered, and
+		//  only as long as the file on disk and libobs are the same ones.
+		obs_data_t* entry = iter->second;
+		if (obs_data_get_int(entry, "size") == module.size && obs_data_get_int(entry, "mtime") == module.mtime) {
+			module.known  = true;
+			module.result = int(obs_data_get_int(entry, "result"));
+			module.cached = (module.result == MODULE_MISSING_EXPORTS) || (module.result == MODULE_INCOMPATIBLE_VER);
+			module.eager  = obs_data_get_bool(entry, "eager");
+			GetManifestTypes(entry, "inputs", module.inputs);
+			GetManifestTypes(entry, "filters", module.filters);
+			GetManifestTypes(entry, "transitions", module.transitions);
+		}
+	}
+
+	for (auto& entry : entries)
+		obs_data_release(entry.second);
+	obs_data_release(manifest);
+}
+
+static void SaveModuleManifest(const std::string& path, const std::vector<ModuleInfo>& modules)
+{
+	obs_data_t*       manifest = obs_data_create();
+	obs_data_array_t* array    = obs_data_array_create();
+	for (const ModuleInfo& module : modules) {
+		obs_data_t* entry = obs_data_create();
+		obs_data_set_string(entry, "path", module.path.c_str());
+		obs_data_set_int(entry, "size", module.size);
+		obs_data_set_int(entry, "mtime", module.mtime);
+		obs_data_set_int(entry, "result", module.result);
+		obs_data_set_bool(entry, "eager", module.eager);
+		SetManifestTypes(entry, "inputs", module.inputs);
+		SetManifestTypes(entry, "filters", module.filters);
+		SetManifestTypes(entry, "transitions", module.transitions);
+		obs_data_array_push_back(array, entry);
+		obs_data_release(entry);
+	}
+	obs_data_set_int(manifest, "version", MODULE_MANIFEST_VERSION);
+	obs_data_set_int(manifest, "libobs", obs_get_version());
+	obs_data_set_array(manifest, "modules", array);
+
+	if (!obs_data_save_json_safe(manifest, path.c_str(), "tmp", "bak")) {
+		blog(LOG_WARNING, "Failed to save module manifest to '%s'.", path.c_str());
+	}
+
+	obs_data_array_release(array);
+	obs_data_release(manifest);
+}
+
+bool OBS_API::openAllModules(int& video_err, const std::string& manifest_path)
 {
 	video_err = OBS_service::resetVideoContext();
 	if (video_err != OBS_VIDEO_SUCCESS) {
@@ -814,6 +853,8 @@ bool OBS_API::openAllModules(int& video_err)
 
 	size_t num_paths = sizeof(plugins_paths) / sizeof(plugins_paths[0]);
 
+	// Read every directory once up front, the rest works off this list.
+	std::vector<ModuleInfo> modules;
 	for (int i = 0; i < num_paths; ++i) {
 		std::string& plugins_path      = plugins_paths[i];
 		std::string& plugins_data_path = plugins_data_paths[i];
@@ -836,8 +877,6 @@ bool OBS_API::openAllModules(int& video_err)
 			std::string fullname = ent->d_name;
 			std::string basename = fullname.substr(0, fullname.find_last_of('.'));
 
-			std::string plugin_path      = plugins_path + "/" + fullname;
-			std::string plugin_data_path = plugins_data_path + "/" + basename;
 			if (ent->directory) {
 				continue;
 			}
@@ -848,113 +887,158 @@ bool OBS_API::openAllModules(int& video_err)
 			}
 #endif
 
-			obs_module_t* module;
-			int           result = obs_open_module(&module, plugin_path.c_str(), plugin_data_path.c_str());
-
-			switch (result) {
-			case MODULE_SUCCESS:
-				obsModules.push_back(std::make_pair(fullname, module));
-				break;
-			case MODULE_FILE_NOT_FOUND:
-				std::cerr << "Unable to load '" << plugin_path << "', could not find file." << std::endl;
-				continue;
-			case MODULE_MISSING_EXPORTS:
-				std::cerr << "Unable to load '" << plugin_path << "', missing exports." << std::endl;
-				continue;
-			case MODULE_INCOMPATIBLE_VER:
-				std::cerr << "Unable to load '" << plugin_path << "', incompatible version." << std::endl;
-				continue;
-			case MODULE_ERROR:
-				std::cerr << "Unable to load '" << plugin_path << "', generic error." << std::endl;
-				continue;
-			default:
-				continue;
-			}
-
-			bool success = obs_init_module(module);
+			ModuleInfo module;
+			module.name      = fullname;
+			module.path      = plugins_path + "/" + fullname;
+			module.data_path = plugins_data_path + "/" + basename;
 
-			if (!success) {
-				std::cerr << "Failed to initialize module " << plugin_path << std::endl;
-				/* Just continue to next one */
+			struct stat st;
+			if (os_stat(module.path.c_str(), &st) == 0) {
+				module.size  = int64_t(st.st_size);
+				module.mtime = int64_t(st.st_mtime);
 			}
+			modules.push_back(std::move(module));
 		}
 
 		os_closedir(plugin_dir);
 	}
 
-	return true;
-}
+	LoadModuleManifest(manifest_path, modules);
 
-double OBS_API::getCPU_Percentage(void)
-{
-	double cpuPercentage = os_cpu_usage_info_query(cpuUsageInfo);
+	// Modules that only provide sources can wait until one of their types is
+	//  requested, as long as the manifest already knows which types those are.
+	bool lazy = config_get_bool(ConfigManager::getInstance().getGlobal(), "General", "LazyModules");
+	for (ModuleInfo& module : modules) {
+		module.deferred = lazy && module.known && (module.result == MODULE_SUCCESS) && !module.eager;
+	}
 
-	cpuPercentage *= 10;
-	cpuPercentage = trunc(cpuPercentage);
-	cpuPercentage /= 10;
+	// Plugins only depend on libobs and system libraries, so mapping them and
+	//  their dependencies can happen in parallel. obs_open_module below then
+	//  only takes another reference to an already loaded library.
+	std::vector<void*>  handles(modules.size(), nullptr);
+	std::atomic<size_t> next(0);
+	auto                prefetch = [&modules, &handles, &next]() {
+		for (size_t idx = next++; idx < modules.size(); idx = next++) {
+			if (modules[idx].cached || modules[idx].deferred)
+				continue;
 
-	return cpuPercentage;
-}
+			auto start   = std::chrono::high_resolution_clock::now();
+			handles[idx] = os_dlopen(modules[idx].path.c_str());
+			modules[idx].load_ms =
+			    std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+	};
 
-int OBS_API::getNumberOfDroppedFrames(void)
-{
-	obs_output_t* streamOutput = OBS_service::getStreamingOutput();
+	std::vector<std::thread> workers;
+	size_t                   num_workers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), 8);
+	for (size_t idx = 1; idx < num_workers; idx++)
+		workers.emplace_back(prefetch);
+	prefetch();
+	for (auto& worker : workers)
+		worker.join();
 
-	int totalDropped = 0;
+	for (size_t idx = 0; idx < modules.size(); idx++) {
+		ModuleInfo& module = modules[idx];
+
+		if (module.cached) {
+			blog(LOG_INFO, "Skipping '%s', it failed to load with result %d before.", module.path.c_str(), module.result);
+			continue;
+		}
+
+		if (module.deferred) {
+			for (auto* types : {&module.inputs, &module.filters, &module.transitions}) {
+				for (const std::string& type : *types)
+					deferredModules.emplace(type, idx);
+			}
+			continue;
+		}
 
-	if (obs_output_active(streamOutput)) {
-		totalDropped = obs_output_get_frames_dropped(streamOutput);
+		OpenModule(module, handles[idx]);
 	}
 
-	return totalDropped;
+	SaveModuleManifest(manifest_path, modules);
+
+	std::unique_lock<std::mutex> ul(moduleLock);
+	moduleInfos = std::move(modules);
+
+	return true;
 }
 
-double OBS_API::getDroppedFramesPercentage(void)
+bool OBS_API::openModuleForType(const std::string& type)
 {
-	obs_output_t* streamOutput = OBS_service::getStreamingOutput();
+	std::unique_lock<std::mutex> ul(moduleLock);
 
-	double percent = 0;
+	auto iter = deferredModules.find(type);
+	if (iter == deferredModules.end())
+		return true;
 
-	if (obs_output_active(streamOutput)) {
-		int totalDropped = obs_output_get_frames_dropped(streamOutput);
-		int totalFrames  = obs_output_get_total_frames(streamOutput);
-		percent          = (double)totalDropped / (double)totalFrames * 100.0;
+	ModuleInfo& module = moduleInfos[iter->second];
+	for (auto* types : {&module.inputs, &module.filters, &module.transitions}) {
+		for (const std::string& name : *types)
+			deferredModules.erase(name);
 	}
 
-	return percent;
+	blog(LOG_INFO, "Loading '%s' on demand for '%s'.", module.path.c_str(), type.c_str());
+	module.deferred = false;
+
+	// obs_init_module registers types, which must not race obs_source_create.
+	std::unique_lock<std::shared_timed_mutex> creation(creationLock);
+	OpenModule(module, nullptr);
+	return module.initialized;
 }
 
-double OBS_API::getCurrentBandwidth(void)
+std::shared_timed_mutex& OBS_API::sourceCreationLock()
+{
+	return creationLock;
+}
+
+std::vector<std::string> OBS_API::deferredTypes(ModuleTypes kind)
 {
-	obs_output_t* streamOutput = OBS_service::getStreamingOutput();
+	std::unique_lock<std::mutex> ul(moduleLock);
 
-	double kbitsPerSec = 0;
+	std::vector<std::string> types;
+	for (const ModuleInfo& module : moduleInfos) {
+		if (!module.deferred)
+			continue;
 
-	if (obs_output_active(streamOutput)) {
-		uint64_t bytesSent     = obs_output_get_total_bytes(streamOutput);
-		uint64_t bytesSentTime = os_gettime_ns();
+		const std::vector<std::string>& list = (kind == ModuleTypes::Input)
+		                                           ? module.inputs
+		                                           : (kind == ModuleTypes::Filter) ? module.filters : module.transitions;
+		types.insert(types.end(), list.begin(), list.end());
+	}
+	return types;
+}
 
-		if (bytesSent < lastBytesSent)
-			bytesSent = 0;
-		if (bytesSent == 0)
-			lastBytesSent = 0;
+double OBS_API::getCPU_Percentage(void)
+{
+	double cpuPercentage = osn::Performance::Latest(osn::PerformanceMetric::CPU);
 
-		uint64_t bitsBetween = (bytesSent - lastBytesSent) * 8;
+	cpuPercentage *= 10;
+	cpuPercentage = trunc(cpuPercentage);
+	cpuPercentage /= 10;
 
-		double timePassed = double(bytesSentTime - lastBytesSentTime) / 1000000000.0;
+	return cpuPercentage;
+}
 
-		kbitsPerSec = double(bitsBetween) / timePassed / 1000.0;
+int OBS_API::getNumberOfDroppedFrames(void)
+{
+	return int(osn::Performance::Latest(osn::PerformanceMetric::DroppedFrames));
+}
 
-		lastBytesSent     = bytesSent;
-		lastBytesSentTime = bytesSentTime;
-	}
+double OBS_API::getDroppedFramesPercentage(void)
+{
+	return osn::Performance::Latest(osn::PerformanceMetric::DroppedPercentage);
+}
 
-	return kbitsPerSec;
+double OBS_API::getCurrentBandwidth(void)
+{
+	// Rate over the last sampling interval, independent of who asks and how often.
+	return osn::Performance::Latest(osn::PerformanceMetric::Bandwidth);
 }
 
 double OBS_API::getCurrentFrameRate(void)
 {
-	return obs_get_active_fps();
+	return osn::Performance::Latest(osn::PerformanceMetric::FrameRate);
 }
 
 static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor,
@@ -4,6 +4,7 @@
 #include <ipc-server.hpp>
 #include <math.h>
 #include <obs.h>
+#include <shared_mutex>
 #include <stdio.h>
 #include <string.h>
 #include <string>
@@ -45,6 +46,16 @@ class OBS_API
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_API_getModuleTimings(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_API_getLogStatistics(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 	static void SetWorkingDirectory(
 	    void*                          data,
 	    const int64_t                  id,
@@ -59,7 +70,7 @@ class OBS_API
 	private:
 	static void initAPI(void);
 	static void destroyOBS_API(void);
-	static bool openAllModules(int& video_err);
+	static bool openAllModules(int& video_err, const std::string& manifest_path);
 
 	static double getCPU_Percentage(void);
 	static int    getNumberOfDroppedFrames(void);
@@ -69,6 +80,22 @@ class OBS_API
 
 	static std::vector<std::string> exploreDirectory(std::string directory, std::string typeToReturn);
 
+	public:
+	enum class ModuleTypes
+	{
+		Input,
+		Filter,
+		Transition,
+	};
+
+	// With "LazyModules" set in the global config, modules that only provide
+	//  sources are initialized the first time one of their types is created.
+	static bool                     openModuleForType(const std::string& type);
+	static std::vector<std::string> deferredTypes(ModuleTypes kind);
+	// Hold shared while creating sources off the IPC thread, a module opened on
+	//  demand initializes with it held exclusively.
+	static std::shared_timed_mutex& sourceCreationLock();
+
 	public:
 	static std::string         getPathConfigDirectory(void);
 	static void                setPathConfigDirectory(std::string newPathConfigDirectory);
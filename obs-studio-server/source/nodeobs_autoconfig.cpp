@@ -1,6 +1,22 @@
 #include "nodeobs_autoconfig.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <sstream>
 #include "error.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-events.hpp"
 #include "shared.hpp"
+#include "util-net.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
 
 enum class Type
 {
@@ -66,8 +82,12 @@ class AutoConfigInfo
 	double      percentage;
 };
 
-std::mutex                 eventsMutex;
-std::queue<AutoConfigInfo> events;
+static void PublishEvent(const AutoConfigInfo& info)
+{
+	osn::Events::Publish(
+	    EventType::AutoConfig,
+	    {ipc::value(info.event), ipc::value(info.description), ipc::value(info.percentage)});
+}
 
 Service     serviceSelected   = Service::Other;
 Quality     recordingQuality  = Quality::Stream;
@@ -128,6 +148,26 @@ struct ServerInfo
 	inline ServerInfo(const char* name_, const char* address_) : name(name_), address(address_) {}
 };
 
+// Parallel bandwidth test: the connect time of every candidate is probed at
+//  once, only the fastest 'candidates' get a throughput test and that test
+//  ends as soon as the bitrate estimate settles. Each run gets its own copy.
+struct BandwidthTestOptions
+{
+	bool                    parallel   = true;
+	size_t                  candidates = 3;
+	std::vector<ServerInfo> servers; // Overrides the servers of the service.
+};
+
+static const std::chrono::milliseconds probeTimeout(2000);
+static const size_t                    probeWorkers = 16;
+
+static const std::chrono::milliseconds throughputInterval(500);
+static const std::chrono::milliseconds throughputMinimum(3000);
+static const std::chrono::milliseconds throughputMaximum(10000);
+// Consecutive estimates that must be within 'throughputTolerance' of each other.
+static const int    throughputStableSamples = 3;
+static const double throughputTolerance     = 0.05;
+
 class TestMode
 {
 	obs_video_info ovi;
@@ -191,31 +231,36 @@ void autoConfig::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("AutoConfig");
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetListServer", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, autoConfig::GetListServer));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetListServer", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, autoConfig::GetListServer));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "InitializeAutoConfig",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String},
 	    autoConfig::InitializeAutoConfig));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartBandwidthTest", std::vector<ipc::type>{}, autoConfig::StartBandwidthTest));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartStreamEncoderTest", std::vector<ipc::type>{}, autoConfig::StartStreamEncoderTest));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartRecordingEncoderTest", std::vector<ipc::type>{}, autoConfig::StartRecordingEncoderTest));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartCheckSettings", std::vector<ipc::type>{}, autoConfig::StartCheckSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartSetDefaultSettings", std::vector<ipc::type>{}, autoConfig::StartSetDefaultSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "StartSaveStreamSettings", std::vector<ipc::type>{}, autoConfig::StartSaveStreamSettings));
 	cls->register_function(
-	    std::make_shared<ipc::function>("StartSaveSettings", std::vector<ipc::type>{}, autoConfig::StartSaveSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "TerminateAutoConfig", std::vector<ipc::type>{}, autoConfig::TerminateAutoConfig));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, autoConfig::Query));
+	    osn::CallStats::Function(cls, "StartBandwidthTest", std::vector<ipc::type>{}, autoConfig::StartBandwidthTest));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "StartBandwidthTest",
+	    std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32, ipc::type::String},
+	    autoConfig::StartBandwidthTest));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "StartStreamEncoderTest", std::vector<ipc::type>{}, autoConfig::StartStreamEncoderTest));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "StartRecordingEncoderTest", std::vector<ipc::type>{}, autoConfig::StartRecordingEncoderTest));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "StartCheckSettings", std::vector<ipc::type>{}, autoConfig::StartCheckSettings));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "StartSetDefaultSettings", std::vector<ipc::type>{}, autoConfig::StartSetDefaultSettings));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "StartSaveStreamSettings", std::vector<ipc::type>{}, autoConfig::StartSaveStreamSettings));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "StartSaveSettings", std::vector<ipc::type>{}, autoConfig::StartSaveSettings));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "TerminateAutoConfig", std::vector<ipc::type>{}, autoConfig::TerminateAutoConfig));
 
-	srv.register_collection(cls);
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void autoConfig::TestHardwareEncoding(void)
@@ -351,26 +396,6 @@ void autoConfig::TerminateAutoConfig(
 	StopThread();
 }
 
-void autoConfig::Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
-{
-	std::unique_lock<std::mutex> ulock(eventsMutex);
-	if (events.empty()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
-	}
-
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	rval.push_back(ipc::value(events.front().event));
-	rval.push_back(ipc::value(events.front().description));
-	rval.push_back(ipc::value(events.front().percentage));
-
-	events.pop();
-
-	AUTO_DEBUG;
-}
-
 void autoConfig::StopThread(void)
 {
 	unique_lock<mutex> ul(m);
@@ -398,7 +423,23 @@ void autoConfig::StartBandwidthTest(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	std::thread(TestBandwidthThread).detach();
+	// Optional: parallel mode, number of candidates and a list of ingest URLs,
+	//  one per line, to test instead of the servers of the service.
+	BandwidthTestOptions options;
+	if (args.size() == 3) {
+		options.parallel   = args[0].value_union.ui32 != 0;
+		options.candidates = std::max(args[1].value_union.ui32, 1u);
+
+		std::istringstream urls(args[2].value_str);
+		std::string        url;
+		while (std::getline(urls, url)) {
+			if (!url.empty())
+				options.servers.emplace_back(url.c_str(), url.c_str());
+		}
+	}
+
+	// A run that is still going keeps the options it started with.
+	std::thread(TestBandwidthThread, std::move(options)).detach();
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 }
@@ -527,6 +568,40 @@ void autoConfig::GetListServer(
 	}
 }
 
+static void ProbeServers(std::vector<ServerInfo>& servers, size_t candidates)
+{
+	std::atomic<size_t>      next(0);
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < std::min(servers.size(), probeWorkers); i++) {
+		workers.emplace_back([&servers, &next]() {
+			for (size_t idx = next++; idx < servers.size(); idx = next++)
+				servers[idx].ms = util::ProbeConnectTime(servers[idx].address, probeTimeout);
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+
+	// Fastest first, unreachable servers last.
+	std::stable_sort(servers.begin(), servers.end(), [](const ServerInfo& a, const ServerInfo& b) {
+		if (a.ms < 0)
+			return false;
+		return b.ms < 0 || a.ms < b.ms;
+	});
+
+	size_t reachable =
+	    size_t(std::count_if(servers.begin(), servers.end(), [](const ServerInfo& info) { return info.ms >= 0; }));
+	servers.resize(std::min(reachable ? reachable : servers.size(), candidates));
+}
+
+// Average bitrate in kbit/s since 't_start'.
+static double EstimateBitrate(OBSOutput& output, uint64_t t_start)
+{
+	uint64_t elapsed = os_gettime_ns() - t_start;
+	if (!elapsed)
+		return 0;
+	return double(obs_output_get_total_bytes(output)) * 8.0 * 1000000000.0 / double(elapsed) / 1000.0;
+}
+
 int EvaluateBandwidth(
     ServerInfo& server,
     bool&       connected,
@@ -535,7 +610,8 @@ int EvaluateBandwidth(
     OBSData&    service_settings,
     OBSService& service,
     OBSOutput&  output,
-    OBSData&    vencoder_settings)
+    OBSData&    vencoder_settings,
+    bool        adaptive)
 {
 	// auto &server = servers[i];
 
@@ -569,7 +645,27 @@ int EvaluateBandwidth(
 
 	uint64_t t_start = os_gettime_ns();
 
-	cv.wait_for(ul, chrono::seconds(10));
+	if (adaptive) {
+		auto   begin    = std::chrono::steady_clock::now();
+		double previous = 0;
+		int    stable   = 0;
+		while (std::chrono::steady_clock::now() - begin < throughputMaximum) {
+			if (cv.wait_for(ul, throughputInterval, [&]() { return stopped || cancel; }))
+				break;
+
+			double estimate = EstimateBitrate(output, t_start);
+			if (previous > 0 && std::fabs(estimate - previous) <= previous * throughputTolerance)
+				stable++;
+			else
+				stable = 0;
+			previous = estimate;
+
+			if (stable >= throughputStableSamples && std::chrono::steady_clock::now() - begin >= throughputMinimum)
+				break;
+		}
+	} else {
+		cv.wait_for(ul, chrono::seconds(10));
+	}
 	if (stopped)
 		return -1;
 	if (cancel) {
@@ -579,11 +675,7 @@ int EvaluateBandwidth(
 	}
 
 	obs_output_stop(output);
-
-	while (!obs_output_active(output)) {
-		std::this_thread::sleep_for(std::chrono::milliseconds(500));
-	}
-	cv.wait(ul);
+	cv.wait(ul, [&]() { return stopped; });
 
 	uint64_t total_time = os_gettime_ns() - t_start;
 
@@ -602,16 +694,12 @@ int EvaluateBandwidth(
 }
 
 void sendErrorMessage(std::string message) {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("error", message.c_str(), 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("error", message.c_str(), 0));
 }
 
-void autoConfig::TestBandwidthThread(void)
+void autoConfig::TestBandwidthThread(const BandwidthTestOptions& options)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "bandwidth_test", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("starting_step", "bandwidth_test", 0));
 
 	bool connected = false;
 	bool stopped   = false;
@@ -732,15 +820,20 @@ void autoConfig::TestBandwidthThread(void)
 	/* determine which servers to test    */
 
 	std::vector<ServerInfo> servers;
-	if (customServer)
+	if (!options.servers.empty())
+		servers = options.servers;
+	else if (customServer)
 		servers.emplace_back(server.c_str(), server.c_str());
 	else
 		GetServers(servers);
 
 	/* just use the first server if it only has one alternate server */
-	if (servers.size() < 3)
+	if (servers.size() < 3 && options.servers.empty())
 		servers.resize(1);
 
+	if (options.parallel && servers.size() > options.candidates)
+		ProbeServers(servers, options.candidates);
+
 	/* -----------------------------------*/
 	/* apply settings                     */
 
@@ -805,14 +898,21 @@ void autoConfig::TestBandwidthThread(void)
 	string bestServerName;
 	bool   success = false;
 
-	if (serverName.compare("") != 0) {
+	if (serverName.compare("") != 0 && options.servers.empty()) {
 		ServerInfo info(serverName.c_str(), server.c_str());
 
-		if (EvaluateBandwidth(info, connected, stopped, success, service_settings, service, output, vencoder_settings)
+		if (EvaluateBandwidth(
+		        info,
+		        connected,
+		        stopped,
+		        success,
+		        service_settings,
+		        service,
+		        output,
+		        vencoder_settings,
+		        options.parallel)
 		    < 0) {
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-			eventsMutex.unlock();
+			PublishEvent(AutoConfigInfo("error", "invalid_stream_settings", 0));
 			return;
 		}
 
@@ -820,24 +920,26 @@ void autoConfig::TestBandwidthThread(void)
 		bestServerName = info.name;
 		bestBitrate    = info.bitrate;
 
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("progress", "bandwidth_test", 100));
-		eventsMutex.unlock();
+		PublishEvent(AutoConfigInfo("progress", "bandwidth_test", 100));
 
 	} else {
 		for (size_t i = 0; i < servers.size(); i++) {
 			EvaluateBandwidth(
-			    servers[i], connected, stopped, success, service_settings, service, output, vencoder_settings);
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
-			eventsMutex.unlock();
+			    servers[i],
+			    connected,
+			    stopped,
+			    success,
+			    service_settings,
+			    service,
+			    output,
+			    vencoder_settings,
+			    options.parallel);
+			PublishEvent(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
 		}
 	}
 
 	if (!success) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-		eventsMutex.unlock();
+		PublishEvent(AutoConfigInfo("error", "invalid_stream_settings", 0));
 		return;
 	}
 
@@ -856,9 +958,7 @@ void autoConfig::TestBandwidthThread(void)
 	serverName   = bestServerName;
 	idealBitrate = bestBitrate;
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
 }
 
 /* this is used to estimate the lower bitrate limit for a given
@@ -979,6 +1079,75 @@ void autoConfig::FindIdealHardwareResolution()
 	idealFPSDen = result.fps_den;
 }
 
+// Encoder benchmark: a setting is sustained when, after the warm-up, the
+//  encoder delivers at least 'benchmarkMinimumFPS' of the target frame rate
+//  and at most 'benchmarkSkippedRatio' of the frames were skipped.
+static const std::chrono::milliseconds benchmarkWarmup(1000);
+static const std::chrono::milliseconds benchmarkDuration(2000);
+static const double                    benchmarkMinimumFPS   = 0.95;
+static const double                    benchmarkSkippedRatio = 0.02;
+
+static std::string ProcessorName()
+{
+	char brand[49] = {0};
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int regs[4];
+	__cpuid(regs, 0x80000000);
+	if (unsigned(regs[0]) >= 0x80000004) {
+		for (int idx = 0; idx < 3; idx++) {
+			__cpuid(regs, 0x80000002 + idx);
+			memcpy(brand + idx * 16, regs, 16);
+		}
+	}
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	unsigned int regs[4];
+	if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+		for (unsigned int idx = 0; idx < 3; idx++) {
+			__get_cpuid(0x80000002 + idx, &regs[0], &regs[1], &regs[2], &regs[3]);
+			memcpy(brand + idx * 16, regs, 16);
+		}
+	}
+#endif
+	return brand;
+}
+
+// Benchmark results only carry over to the same processor, libobs version
+//  and encoder configuration.
+static std::string BenchmarkFingerprint(const char* rateControl)
+{
+	std::ostringstream fingerprint;
+	fingerprint << ProcessorName() << "|" << os_get_physical_cores() << "/" << os_get_logical_cores() << "|"
+	            << obs_get_version_string() << "|obs_x264 " << rateControl << " veryfast|" << baseResolutionCX
+	            << "x" << baseResolutionCY;
+	return fingerprint.str();
+}
+
+static const char* BenchmarkKey()
+{
+	return type == Type::Recording ? "RecordingBenchmark" : "StreamingBenchmark";
+}
+
+static bool LoadBenchmark(const std::string& fingerprint, long double& maxRate)
+{
+	config_t*   config = ConfigManager::getInstance().getGlobal();
+	std::string key    = BenchmarkKey();
+	const char* stored = config_get_string(config, "AutoConfig", key.c_str());
+	if (!stored || fingerprint != stored)
+		return false;
+
+	maxRate = config_get_double(config, "AutoConfig", (key + "Rate").c_str());
+	return true;
+}
+
+static void SaveBenchmark(const std::string& fingerprint, long double maxRate)
+{
+	config_t*   config = ConfigManager::getInstance().getGlobal();
+	std::string key    = BenchmarkKey();
+	config_set_string(config, "AutoConfig", key.c_str(), fingerprint.c_str());
+	config_set_double(config, "AutoConfig", (key + "Rate").c_str(), double(maxRate));
+	config_save_safe(config, "tmp", nullptr);
+}
+
 bool autoConfig::TestSoftwareEncoding()
 {
 	OBSEncoder vencoder = obs_video_encoder_create("obs_x264", "test_x264", nullptr, nullptr);
@@ -1047,69 +1216,76 @@ bool autoConfig::TestSoftwareEncoding()
 	int baseCY = int(baseResolutionCY);
 
 	/* -----------------------------------*/
-	/* calculate starting test rates      */
-
-	int pcores = os_get_physical_cores();
-	int lcores = os_get_logical_cores();
-	int maxDataRate;
-	if (lcores > 8 || pcores > 4) {
-		/* superb */
-		maxDataRate = int(baseResolutionCX * baseResolutionCY * 60 + 1000);
-
-	} else if (lcores > 4 && pcores == 4) {
-		/* great */
-		maxDataRate = int(baseResolutionCX * baseResolutionCY * 60 + 1000);
-
-	} else if (pcores == 4) {
-		/* okay */
-		maxDataRate = int(baseResolutionCX * baseResolutionCY * 30 + 1000);
-
-	} else {
-		/* toaster */
-		maxDataRate = 960 * 540 * 30 + 1000;
-	}
-
-	/* -----------------------------------*/
-	/* perform tests                      */
-
-	vector<Result> results;
-	int            i     = 0;
-	int            count = 1;
+	/* determine candidate settings       */
 
-	auto testRes = [&](long double div, int fps_num, int fps_den, bool force) {
-		int per = ++i * 100 / count;
+	struct Candidate
+	{
+		int         cx;
+		int         cy;
+		int         fps_num;
+		int         fps_den;
+		long double rate;
+		bool        force;
+		bool        fitsBitrate;
+	};
 
-		/* no need for more than 3 tests max */
-		if (results.size() >= 3)
-			return true;
+	vector<Candidate> candidates;
 
+	auto addCandidate = [&](long double div, int fps_num, int fps_den, bool force) {
 		if (!fps_num || !fps_den) {
 			fps_num = specificFPSNum;
 			fps_den = specificFPSDen;
 		}
 
-		long double fps = ((long double)fps_num / (long double)fps_den);
-
 		int cx = int((long double)baseCX / div);
 		int cy = int((long double)baseCY / div);
 
+		// Settings the bitrate cannot carry still take part in the benchmark
+		//  so that the cached rate does not depend on the bitrate.
+		bool fitsBitrate = true;
 		if (!force && type != Type::Recording) {
-			int est = int(EstimateMinBitrate(cx, cy, fps_num, fps_den));
-			if (est > idealBitrate)
-				return true;
+			int est     = int(EstimateMinBitrate(cx, cy, fps_num, fps_den));
+			fitsBitrate = est <= idealBitrate;
 		}
 
-		long double rate = (long double)cx * (long double)cy * fps;
-		if (!force && rate > maxDataRate)
-			return true;
+		long double rate = (long double)cx * (long double)cy * ((long double)fps_num / (long double)fps_den);
+		candidates.push_back({cx, cy, fps_num, fps_den, rate, force, fitsBitrate});
+	};
+
+	if (specificFPSNum && specificFPSDen) {
+		addCandidate(1.0, 0, 0, false);
+		addCandidate(1.5, 0, 0, false);
+		addCandidate(1.0 / 0.6, 0, 0, false);
+		addCandidate(2.0, 0, 0, false);
+		addCandidate(2.25, 0, 0, true);
+	} else {
+		addCandidate(1.0, 60, 1, false);
+		addCandidate(1.0, 30, 1, false);
+		addCandidate(1.5, 60, 1, false);
+		addCandidate(1.5, 30, 1, false);
+		addCandidate(1.0 / 0.6, 60, 1, false);
+		addCandidate(1.0 / 0.6, 30, 1, false);
+		addCandidate(2.0, 60, 1, false);
+		addCandidate(2.0, 30, 1, false);
+		addCandidate(2.25, 60, 1, false);
+		addCandidate(2.25, 30, 1, true);
+	}
 
+	/* -----------------------------------*/
+	/* perform tests                      */
+
+	// Encodes the test pattern at the given setting and checks that the
+	//  encoder keeps up: after a warm-up that covers the encoder's lookahead,
+	//  the encoded frame rate has to be close to the target and the video
+	//  thread must not have skipped frames.
+	auto benchmark = [&](const Candidate& candidate, bool& sustained) {
 		obs_video_info ovi;
 		obs_get_video_info(&ovi);
 
-		ovi.output_width  = (uint32_t)cx;
-		ovi.output_height = (uint32_t)cy;
-		ovi.fps_num       = fps_num;
-		ovi.fps_den       = fps_den;
+		ovi.output_width  = (uint32_t)candidate.cx;
+		ovi.output_height = (uint32_t)candidate.cy;
+		ovi.fps_num       = candidate.fps_num;
+		ovi.fps_den       = candidate.fps_den;
 
 		obs_reset_video(&ovi);
 
@@ -1127,52 +1303,81 @@ bool autoConfig::TestSoftwareEncoding()
 			return false;
 		}
 
-		cv.wait_for(ul, chrono::seconds(5));
+		auto isCancelled = [&]() { return cancel; };
+		cv.wait_until(ul, chrono::steady_clock::now() + benchmarkWarmup, isCancelled);
+
+		video_t* video        = obs_get_video();
+		uint64_t begin        = os_gettime_ns();
+		int      beginEncoded = obs_output_get_total_frames(output);
+		uint32_t beginFrames  = video_output_get_total_frames(video);
+		uint32_t beginSkipped = video_output_get_skipped_frames(video);
+		cv.wait_until(ul, chrono::steady_clock::now() + benchmarkDuration, isCancelled);
+		uint64_t elapsed = os_gettime_ns() - begin;
+		int      encoded = obs_output_get_total_frames(output) - beginEncoded;
+		uint32_t frames  = video_output_get_total_frames(video) - beginFrames;
+		uint32_t skipped = video_output_get_skipped_frames(video) - beginSkipped;
 
 		obs_output_stop(output);
 		cv.wait(ul);
 
-		int skipped = (int)video_output_get_skipped_frames(obs_get_video());
-		if (force || skipped <= 10)
-			results.emplace_back(cx, cy, fps_num, fps_den);
-
+		double fps          = elapsed ? double(encoded) * 1000000000.0 / double(elapsed) : 0.0;
+		double target       = double(candidate.fps_num) / double(candidate.fps_den);
+		double skippedRatio = frames ? double(skipped) / double(frames) : 1.0;
+		sustained           = (skippedRatio <= benchmarkSkippedRatio) && (fps >= target * benchmarkMinimumFPS);
+
+		blog(
+		    LOG_INFO,
+		    "Encoder benchmark %dx%d@%.2f: %.2f fps, %.2f%% skipped, %s",
+		    candidate.cx,
+		    candidate.cy,
+		    target,
+		    fps,
+		    skippedRatio * 100.0,
+		    sustained ? "sustained" : "not sustained");
 		return !cancel;
 	};
 
-	if (specificFPSNum && specificFPSDen) {
-		count = 5;
-		if (!testRes(1.0, 0, 0, false))
-			return false;
-		if (!testRes(1.5, 0, 0, false))
-			return false;
-		if (!testRes(1.0 / 0.6, 0, 0, false))
-			return false;
-		if (!testRes(2.0, 0, 0, false))
-			return false;
-		if (!testRes(2.25, 0, 0, true))
-			return false;
-	} else {
-		count = 10;
-		if (!testRes(1.0, 60, 1, false))
-			return false;
-		if (!testRes(1.0, 30, 1, false))
-			return false;
-		if (!testRes(1.5, 60, 1, false))
-			return false;
-		if (!testRes(1.5, 30, 1, false))
-			return false;
-		if (!testRes(1.0 / 0.6, 60, 1, false))
-			return false;
-		if (!testRes(1.0 / 0.6, 30, 1, false))
-			return false;
-		if (!testRes(2.0, 60, 1, false))
-			return false;
-		if (!testRes(2.0, 30, 1, false))
-			return false;
-		if (!testRes(2.25, 60, 1, false))
-			return false;
-		if (!testRes(2.25, 30, 1, true))
-			return false;
+	// Highest pixel rate the encoder sustains on this machine. A setting that
+	//  is sustained means every setting with a lower pixel rate is as well, so
+	//  a binary search over the distinct rates finds it in a few runs.
+	std::string fingerprint = BenchmarkFingerprint(obs_data_get_string(vencoder_settings, "rate_control"));
+	long double maxRate     = 0;
+	if (!LoadBenchmark(fingerprint, maxRate)) {
+		vector<long double> rates;
+		for (const Candidate& candidate : candidates) {
+			if (!candidate.force)
+				rates.push_back(candidate.rate);
+		}
+		std::sort(rates.begin(), rates.end(), std::greater<long double>());
+		rates.erase(std::unique(rates.begin(), rates.end()), rates.end());
+
+		size_t low = 0, high = rates.size();
+		while (low < high) {
+			size_t mid       = (low + high) / 2;
+			auto   isMidRate = [&](const Candidate& candidate) { return candidate.rate == rates[mid]; };
+			auto   iter      = std::find_if(candidates.begin(), candidates.end(), isMidRate);
+
+			bool sustained = false;
+			if (!benchmark(*iter, sustained))
+				return false;
+
+			if (sustained)
+				high = mid;
+			else
+				low = mid + 1;
+		}
+
+		maxRate = low < rates.size() ? rates[low] : 0;
+		SaveBenchmark(fingerprint, maxRate);
+	}
+
+	vector<Result> results;
+	for (const Candidate& candidate : candidates) {
+		/* no need for more than 3 results */
+		if (results.size() >= 3)
+			break;
+		if (candidate.force || (candidate.fitsBitrate && candidate.rate <= maxRate))
+			results.emplace_back(candidate.cx, candidate.cy, candidate.fps_num, candidate.fps_den);
 	}
 
 	/* -----------------------------------*/
@@ -1221,9 +1426,7 @@ bool autoConfig::TestSoftwareEncoding()
 
 void autoConfig::TestStreamEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
 
 	baseResolutionCX = config_get_int(ConfigManager::getInstance().getBasic(), "Video", "BaseCX");
 	baseResolutionCY = config_get_int(ConfigManager::getInstance().getBasic(), "Video", "BaseCY");
@@ -1252,16 +1455,12 @@ void autoConfig::TestStreamEncoderThread()
 		streamingEncoder = Encoder::x264;
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
 }
 
 void autoConfig::TestRecordingEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
 
 	TestHardwareEncoding();
 
@@ -1296,9 +1495,7 @@ void autoConfig::TestRecordingEncoderThread()
 		}
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
 }
 
 inline const char* GetEncoderId(Encoder enc)
@@ -1347,9 +1544,7 @@ bool autoConfig::CheckSettings(void)
 	OBSService service = obs_service_create("rtmp_common", "serviceTest", settings, NULL);
 
 	if (!service) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_service", 100));
-		eventsMutex.unlock();
+		PublishEvent(AutoConfigInfo("error", "invalid_service", 100));
 		return false;
 	}
 
@@ -1428,9 +1623,7 @@ bool autoConfig::CheckSettings(void)
 
 void autoConfig::SetDefaultSettings(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "setting_default_settings", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("starting_step", "setting_default_settings", 0));
 
 	idealResolutionCX = 1280;
 	idealResolutionCY = 720;
@@ -1440,9 +1633,7 @@ void autoConfig::SetDefaultSettings(void)
 	streamingEncoder = Encoder::x264;
 	recordingEncoder = Encoder::Stream;
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
 }
 
 void autoConfig::SaveStreamSettings()
@@ -1450,9 +1641,7 @@ void autoConfig::SaveStreamSettings()
 	/* ---------------------------------- */
 	/* save service                       */
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_service", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("starting_step", "saving_service", 0));
 
 	const char* service_id = "rtmp_common";
 
@@ -1485,16 +1674,12 @@ void autoConfig::SaveStreamSettings()
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
 	
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_service", 100));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("stopping_step", "saving_service", 100));
 }
 
 void autoConfig::SaveSettings()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_settings", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("starting_step", "saving_settings", 0));
 	
 	if (recordingEncoder != Encoder::Stream)
 		config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecEncoder",
@@ -1517,8 +1702,6 @@ void autoConfig::SaveSettings()
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_settings", 100));
-	events.push(AutoConfigInfo("done", "", 0));
-	eventsMutex.unlock();
+	PublishEvent(AutoConfigInfo("stopping_step", "saving_settings", 100));
+	PublishEvent(AutoConfigInfo("done", "", 0));
 }
@@ -10,6 +10,8 @@
 #include "nodeobs_api.h"
 #include "nodeobs_service.h"
 
+struct BandwidthTestOptions;
+
 namespace autoConfig
 {
 	void Register(ipc::server& srv);
@@ -60,12 +62,11 @@ namespace autoConfig
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
-	void Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 
 	void StopThread();
 	void FindIdealHardwareResolution();
 	bool TestSoftwareEncoding();
-	void TestBandwidthThread();
+	void TestBandwidthThread(const BandwidthTestOptions& options);
 	void TestStreamEncoderThread();
 	void TestRecordingEncoderThread();
 	void SaveStreamSettings();
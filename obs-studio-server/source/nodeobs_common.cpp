@@ -7,6 +7,8 @@
 #include <graphics/matrix4.h>
 
 #include "error.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "shared.hpp"
 
 #include <thread>
@@ -110,115 +112,137 @@ void OBS_content::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Display");
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_createDisplay",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String},
 	    OBS_content_createDisplay));
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_content_destroyDisplay", std::vector<ipc::type>{ipc::type::String}, OBS_content_destroyDisplay));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_content_destroyDisplay", std::vector<ipc::type>{ipc::type::String}, OBS_content_destroyDisplay));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_getDisplayPreviewOffset",
 	    std::vector<ipc::type>{ipc::type::String},
 	    OBS_content_getDisplayPreviewOffset));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_getDisplayPreviewSize",
 	    std::vector<ipc::type>{ipc::type::String},
 	    OBS_content_getDisplayPreviewSize));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_createSourcePreviewDisplay",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String},
 	    OBS_content_createSourcePreviewDisplay));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_resizeDisplay",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_resizeDisplay));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_moveDisplay",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_moveDisplay));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setPaddingSize",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32},
 	    OBS_content_setPaddingSize));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setPaddingColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setPaddingColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setBackgroundColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setBackgroundColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setOutlineColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setOutlineColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setGuidelineColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setGuidelineColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setResizeBoxOuterColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setResizeBoxOuterColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setResizeBoxInnerColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setResizeBoxInnerColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setResizeBoxInnerColor",
 	    std::vector<ipc::type>{
 	        ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_setResizeBoxInnerColor));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setShouldDrawUI",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
 	    OBS_content_setShouldDrawUI));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_selectSource",
 	    std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32},
 	    OBS_content_selectSource));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_selectSources",
 	    std::vector<ipc::type>{ipc::type::UInt32, ipc::type::Binary},
 	    OBS_content_selectSources));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_dragSelectedSource",
 	    std::vector<ipc::type>{ipc::type::Int32, ipc::type::Int32},
 	    OBS_content_dragSelectedSource));
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_content_getDrawGuideLines", std::vector<ipc::type>{ipc::type::String}, OBS_content_getDrawGuideLines));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "OBS_content_getDrawGuideLines",
+	    std::vector<ipc::type>{ipc::type::String},
+	    OBS_content_getDrawGuideLines));
 
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_content_setDrawGuideLines",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
 	    OBS_content_setDrawGuideLines));
 
-	srv.register_collection(cls);
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void popupAeroDisabledWindow(void)
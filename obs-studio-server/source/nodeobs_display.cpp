@@ -3,6 +3,7 @@
 #include <map>
 #include <string>
 #include "nodeobs_api.h"
+#include "osn-frame-trace.hpp"
 
 #include <graphics/matrix4.h>
 #include <graphics/vec4.h>
@@ -960,6 +961,7 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item,
 
 void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 {
+	uint64_t        begin       = os_gettime_ns();
 	Display*        dp          = static_cast<Display*>(displayPtr);
 	gs_effect_t*    solid       = obs_get_base_effect(OBS_EFFECT_SOLID);
 	gs_eparam_t*    solid_color = gs_effect_get_param_by_name(solid, "color");
@@ -1095,6 +1097,8 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 	obs_source_release(source);
 	gs_projection_pop();
 	gs_viewport_pop();
+
+	osn::FrameTrace::Record(osn::FrameTrace::Stage::DisplayRender, begin, os_gettime_ns());
 }
 
 void OBS::Display::UpdatePreviewArea()
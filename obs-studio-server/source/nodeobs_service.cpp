@@ -2,10 +2,16 @@
 #include <ShlObj.h>
 #include <windows.h>
 #include "error.hpp"
+#include "nodeobs_api.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-events.hpp"
+#include "osn-frame-trace.hpp"
 #include "shared.hpp"
 
 obs_output_t*  streamingOutput;
 obs_output_t*  recordingOutput;
+std::mutex     outputLock; // Guards replacing the outputs against other threads taking a reference.
 obs_encoder_t* audioStreamingEncoder;
 obs_encoder_t* audioRecordingEncoder;
 obs_encoder_t* videoStreamingEncoder;
@@ -31,61 +37,71 @@ void OBS_service::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Service");
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_resetAudioContext", std::vector<ipc::type>{}, OBS_service_resetAudioContext));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_resetVideoContext", std::vector<ipc::type>{}, OBS_service_resetVideoContext));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createAudioEncoder", std::vector<ipc::type>{}, OBS_service_createAudioEncoder));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createVideoStreamingEncoder", std::vector<ipc::type>{}, OBS_service_createVideoStreamingEncoder));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createVideoRecordingEncoder", std::vector<ipc::type>{}, OBS_service_createVideoRecordingEncoder));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createService", std::vector<ipc::type>{}, OBS_service_createService));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createRecordingSettings", std::vector<ipc::type>{}, OBS_service_createRecordingSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createStreamingOutput", std::vector<ipc::type>{}, OBS_service_createStreamingOutput));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_createRecordingOutput", std::vector<ipc::type>{}, OBS_service_createRecordingOutput));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_startStreaming", std::vector<ipc::type>{}, OBS_service_startStreaming));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_startRecording", std::vector<ipc::type>{}, OBS_service_startRecording));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_stopStreaming", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopStreaming));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_stopRecording", std::vector<ipc::type>{}, OBS_service_stopRecording));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_resetAudioContext", std::vector<ipc::type>{}, OBS_service_resetAudioContext));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_resetVideoContext", std::vector<ipc::type>{}, OBS_service_resetVideoContext));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_createAudioEncoder", std::vector<ipc::type>{}, OBS_service_createAudioEncoder));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "OBS_service_createVideoStreamingEncoder",
+	    std::vector<ipc::type>{},
+	    OBS_service_createVideoStreamingEncoder));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "OBS_service_createVideoRecordingEncoder",
+	    std::vector<ipc::type>{},
+	    OBS_service_createVideoRecordingEncoder));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_createService", std::vector<ipc::type>{}, OBS_service_createService));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_createRecordingSettings", std::vector<ipc::type>{}, OBS_service_createRecordingSettings));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_createStreamingOutput", std::vector<ipc::type>{}, OBS_service_createStreamingOutput));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_createRecordingOutput", std::vector<ipc::type>{}, OBS_service_createRecordingOutput));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_startStreaming", std::vector<ipc::type>{}, OBS_service_startStreaming));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_startRecording", std::vector<ipc::type>{}, OBS_service_startRecording));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_stopStreaming", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopStreaming));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_stopRecording", std::vector<ipc::type>{}, OBS_service_stopRecording));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_service_associateAudioAndVideoToTheCurrentStreamingContext",
 	    std::vector<ipc::type>{},
 	    OBS_service_associateAudioAndVideoToTheCurrentStreamingContext));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_service_associateAudioAndVideoToTheCurrentRecordingContext",
 	    std::vector<ipc::type>{},
 	    OBS_service_associateAudioAndVideoToTheCurrentRecordingContext));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_service_associateAudioAndVideoEncodersToTheCurrentStreamingOutput",
 	    std::vector<ipc::type>{},
 	    OBS_service_associateAudioAndVideoEncodersToTheCurrentStreamingOutput));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_service_associateAudioAndVideoEncodersToTheCurrentRecordingOutput",
 	    std::vector<ipc::type>{},
 	    OBS_service_associateAudioAndVideoEncodersToTheCurrentRecordingOutput));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_service_setServiceToTheStreamingOutput",
 	    std::vector<ipc::type>{},
 	    OBS_service_setServiceToTheStreamingOutput));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_setRecordingSettings", std::vector<ipc::type>{}, OBS_service_setRecordingSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_service_connectOutputSignals", std::vector<ipc::type>{}, OBS_service_connectOutputSignals));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, Query));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_setRecordingSettings", std::vector<ipc::type>{}, OBS_service_setRecordingSettings));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_service_connectOutputSignals", std::vector<ipc::type>{}, OBS_service_connectOutputSignals));
 
 	// TODO : connect output signals
 
-	srv.register_collection(cls);
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void OBS_service::OBS_service_resetAudioContext(
@@ -310,6 +326,15 @@ void LoadAudioDevice(const char* name, int channel, obs_data_t* parent)
 	if (!data)
 		return;
 
+	OBS_API::openModuleForType(obs_data_get_string(data, "id"));
+	obs_data_array_t* filters = obs_data_get_array(data, "filters");
+	for (size_t idx = 0; idx < obs_data_array_count(filters); idx++) {
+		obs_data_t* filter = obs_data_array_item(filters, idx);
+		OBS_API::openModuleForType(obs_data_get_string(filter, "id"));
+		obs_data_release(filter);
+	}
+	obs_data_array_release(filters);
+
 	obs_source_t* source = obs_load_source(data);
 	if (source) {
 		obs_set_output_source(channel, source);
@@ -559,7 +584,9 @@ int OBS_service::resetVideoContext(bool reload)
 
     config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
 
-	return obs_reset_video(&ovi);
+	int result = obs_reset_video(&ovi);
+	osn::FrameTrace::VideoReset();
+	return result;
 }
 
 const char* FindAudioEncoderFromCodec(const char* type)
@@ -835,13 +862,13 @@ void OBS_service::createService()
 
 void OBS_service::createStreamingOutput(void)
 {
-	streamingOutput = obs_output_create("rtmp_output", "simple_stream", nullptr, nullptr);
+	setStreamingOutput(obs_output_create("rtmp_output", "simple_stream", nullptr, nullptr));
 	connectOutputSignals();
 }
 
 void OBS_service::createRecordingOutput(void)
 {
-	recordingOutput = obs_output_create("ffmpeg_muxer", "simple_file_output", nullptr, nullptr);
+	setRecordingOutput(obs_output_create("ffmpeg_muxer", "simple_file_output", nullptr, nullptr));
 	connectOutputSignals();
 }
 
@@ -851,8 +878,7 @@ bool OBS_service::startStreaming(void)
 	if (!type)
 		type = "rtmp_output";
 
-	obs_output_release(streamingOutput);
-	streamingOutput = obs_output_create(type, "simple_stream", nullptr, nullptr);
+	setStreamingOutput(obs_output_create(type, "simple_stream", nullptr, nullptr));
 	connectOutputSignals();
 	
 	uint64_t trackIndex = config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut",
@@ -1350,10 +1376,7 @@ void OBS_service::updateAdvancedRecordingOutput(void)
 
 void OBS_service::LoadRecordingPreset_Lossless()
 {
-	if (recordingOutput != NULL) {
-		obs_output_release(recordingOutput);
-	}
-	recordingOutput = obs_output_create("ffmpeg_output", "simple_ffmpeg_output", nullptr, nullptr);
+	setRecordingOutput(obs_output_create("ffmpeg_output", "simple_ffmpeg_output", nullptr, nullptr));
 	connectOutputSignals();
 	if (!recordingOutput)
 		throw "Failed to create recording FFmpeg output "
@@ -1423,10 +1446,7 @@ void OBS_service::UpdateFFmpegOutput(void)
 {
     update_ffmpeg_output(ConfigManager::getInstance().getBasic());
 
-	if (recordingOutput != NULL) {
-		obs_output_release(recordingOutput);
-	}
-	recordingOutput = obs_output_create("ffmpeg_output", "simple_ffmpeg_output", nullptr, nullptr);
+	setRecordingOutput(obs_output_create("ffmpeg_output", "simple_ffmpeg_output", nullptr, nullptr));
 	connectOutputSignals();
 
 	const char *url = 
@@ -1749,8 +1769,19 @@ obs_output_t* OBS_service::getStreamingOutput(void)
 
 void OBS_service::setStreamingOutput(obs_output_t* output)
 {
-	obs_output_release(streamingOutput);
-	streamingOutput = output;
+	obs_output_t* previous = nullptr;
+	{
+		std::unique_lock<std::mutex> ul(outputLock);
+		previous        = streamingOutput;
+		streamingOutput = output;
+	}
+	obs_output_release(previous);
+}
+
+obs_output_t* OBS_service::getStreamingOutputRef(void)
+{
+	std::unique_lock<std::mutex> ul(outputLock);
+	return obs_output_get_ref(streamingOutput);
 }
 
 obs_output_t* OBS_service::getRecordingOutput(void)
@@ -1760,8 +1791,19 @@ obs_output_t* OBS_service::getRecordingOutput(void)
 
 void OBS_service::setRecordingOutput(obs_output_t* output)
 {
-	obs_output_release(recordingOutput);
-	recordingOutput = output;
+	obs_output_t* previous = nullptr;
+	{
+		std::unique_lock<std::mutex> ul(outputLock);
+		previous        = recordingOutput;
+		recordingOutput = output;
+	}
+	obs_output_release(previous);
+}
+
+obs_output_t* OBS_service::getRecordingOutputRef(void)
+{
+	std::unique_lock<std::mutex> ul(outputLock);
+	return obs_output_get_ref(recordingOutput);
 }
 
 void OBS_service::updateStreamSettings(void)
@@ -1856,30 +1898,6 @@ void OBS_service::OBS_service_connectOutputSignals(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 }
 
-std::mutex             signalMutex;
-std::queue<SignalInfo> outputSignal;
-
-void OBS_service::Query(void* data, const int64_t id, 
-	const std::vector<ipc::value>& args, std::vector<ipc::value>& rval) {
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	if (outputSignal.empty()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
-	}
-
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	rval.push_back(ipc::value(outputSignal.front().getOutputType()));
-	rval.push_back(ipc::value(outputSignal.front().getSignal()));
-	rval.push_back(ipc::value(outputSignal.front().getCode()));
-	rval.push_back(ipc::value(outputSignal.front().getErrorMessage()));
-
-	outputSignal.pop();
-
-	AUTO_DEBUG;
-}
-
 void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 {
 	SignalInfo& signal = *reinterpret_cast<SignalInfo*>(data);
@@ -1904,8 +1922,12 @@ void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 		}
 	}
 
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	outputSignal.push(signal);
+	osn::Events::Publish(
+	    EventType::OutputSignal,
+	    {ipc::value(signal.getOutputType()),
+	     ipc::value(signal.getSignal()),
+	     ipc::value(signal.getCode()),
+	     ipc::value(signal.getErrorMessage())});
 }
 
 void OBS_service::connectOutputSignals(void)
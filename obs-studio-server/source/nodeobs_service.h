@@ -191,7 +191,6 @@ class OBS_service
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
-	static void Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 
 	private:
 	static bool        startStreaming(void);
@@ -240,6 +239,10 @@ class OBS_service
 	static void          setStreamingOutput(obs_output_t* output);
 	static obs_output_t* getRecordingOutput(void);
 	static void          setRecordingOutput(obs_output_t* output);
+	// For threads other than the IPC one: a new reference that stays valid while
+	//  the output gets replaced, release it when done. May be nullptr.
+	static obs_output_t* getStreamingOutputRef(void);
+	static obs_output_t* getRecordingOutputRef(void);
 
 	// Update settings
 	static void updateStreamSettings(void);
@@ -1,6 +1,9 @@
 #include "error.hpp"
 #include "nodeobs_api.h"
 #include "nodeobs_settings.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "settings-wire.hpp"
 #include "shared.hpp"
 
 #include <windows.h>
@@ -26,16 +29,22 @@ void OBS_settings::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Settings");
 
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_settings_getSettings", std::vector<ipc::type>{ipc::type::String}, OBS_settings_getSettings));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_settings_getSettings", std::vector<ipc::type>{ipc::type::String}, OBS_settings_getSettings));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "OBS_settings_saveSettings",
-	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::Binary},
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Binary},
 	    OBS_settings_saveSettings));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "OBS_settings_getListCategories", std::vector<ipc::type>{}, OBS_settings_getListCategories));
-
-	srv.register_collection(cls);
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "OBS_settings_saveSettingsPatch",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Binary},
+	    OBS_settings_saveSettingsPatch));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "OBS_settings_getListCategories", std::vector<ipc::type>{}, OBS_settings_getListCategories));
+
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void OBS_settings::OBS_settings_getListCategories(
@@ -63,130 +72,53 @@ void OBS_settings::OBS_settings_getSettings(
 {
 	std::string              nameCategory = args[0].value_str;
 	std::vector<SubCategory> settings     = getSettings(nameCategory);
-	std::vector<char>        binaryValue;
-
-	for (int i = 0; i < settings.size(); i++) {
-		std::vector<char> serializedBuf = settings.at(i).serialize();
-
-		binaryValue.insert(binaryValue.end(), serializedBuf.begin(), serializedBuf.end());
-	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(settings.size()));
-	rval.push_back(ipc::value(binaryValue.size()));
-
-	rval.push_back(ipc::value(binaryValue));
+	rval.push_back(ipc::value(std::vector<char>()));
+	osn::settings_wire::encode(settings, rval.back().value_bin);
 	AUTO_DEBUG;
 }
 
-std::vector<SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+void OBS_settings::OBS_settings_saveSettings(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
 {
-	std::vector<SubCategory> category;
-
-	size_t indexData = 0;
-	for (uint32_t i = 0; i < subCategoriesCount; i++) {
-		SubCategory sc;
-
-		size_t* sizeMessage = reinterpret_cast<size_t*>(buffer.data() + indexData);
-		indexData += sizeof(size_t);
-
-		std::string name(buffer.data() + indexData, *sizeMessage);
-		indexData += *sizeMessage;
-
-		uint32_t* paramsCount = reinterpret_cast<uint32_t*>(buffer.data() + indexData);
-		indexData += sizeof(uint32_t);
-
-		Parameter param;
-		for (uint32_t j = 0; j < *paramsCount; j++) {
-			size_t* sizeName = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string name(buffer.data() + indexData, *sizeName);
-			indexData += *sizeName;
-
-			size_t* sizeDescription = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string description(buffer.data() + indexData, *sizeDescription);
-			indexData += *sizeDescription;
-
-			size_t* sizeType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string type(buffer.data() + indexData, *sizeType);
-			indexData += *sizeType;
-
-			size_t* sizeSubType = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::string subType(buffer.data() + indexData, *sizeSubType);
-			indexData += *sizeSubType;
-
-			bool* enabled = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* masked = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			bool* visible = reinterpret_cast<bool*>(buffer.data() + indexData);
-			indexData += sizeof(bool);
-
-			size_t* sizeOfCurrentValue = reinterpret_cast<std::size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> currentValue;
-			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
-			indexData += *sizeOfCurrentValue;
-
-			size_t* sizeOfValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			size_t* countValues = reinterpret_cast<size_t*>(buffer.data() + indexData);
-			indexData += sizeof(size_t);
-
-			std::vector<char> values;
-			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
-			indexData += *sizeOfValues;
-
-			param.name         = name;
-			param.description  = description;
-			param.type         = type;
-			param.subType      = subType;
-			param.enabled      = enabled;
-			param.masked       = masked;
-			param.visible      = visible;
-			param.currentValue = currentValue;
-			param.values       = values;
-			param.countValues  = *countValues;
+	std::string              nameCategory = args[0].value_str;
+	std::vector<SubCategory> settings;
 
-			sc.params.push_back(param);
-		}
-		sc.name        = name;
-		sc.paramsCount = *paramsCount;
-		category.push_back(sc);
+	if (!osn::settings_wire::decode(args[1].value_bin.data(), args[1].value_bin.size(), settings)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Invalid settings buffer."));
+		AUTO_DEBUG;
+		return;
 	}
-	return category;
+
+	saveSettings(nameCategory, settings);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
 }
 
-void OBS_settings::OBS_settings_saveSettings(
+void OBS_settings::OBS_settings_saveSettingsPatch(
     void*                          data,
     const int64_t                  id,
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	std::string nameCategory       = args[0].value_str;
-	uint32_t    subCategoriesCount = args[1].value_union.ui32;
-	uint32_t    sizeStruct         = args[2].value_union.ui32;
-
-	std::vector<char> buffer;
-	buffer.resize(sizeStruct);
-	memcpy(buffer.data(), args[3].value_bin.data(), sizeStruct);
+	std::string              nameCategory = args[0].value_str;
+	std::vector<SubCategory> patch;
 
-	std::vector<SubCategory> settings = serializeCategory(subCategoriesCount, sizeStruct, buffer);
+	if (!osn::settings_wire::decode(args[1].value_bin.data(), args[1].value_bin.size(), patch)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Invalid settings buffer."));
+		AUTO_DEBUG;
+		return;
+	}
 
-	saveSettings(nameCategory, settings);
+	uint32_t reset = saveSettingsPatch(nameCategory, patch);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(reset));
 	AUTO_DEBUG;
 }
 
@@ -3162,6 +3094,191 @@ void OBS_settings::saveSettings(std::string nameCategory, std::vector<SubCategor
 	}
 }
 
+static bool hasSubCategory(const std::vector<SubCategory>& settings, const char* name)
+{
+	return std::find_if(
+	           settings.begin(),
+	           settings.end(),
+	           [name](const SubCategory& sc) { return sc.name.compare(name) == 0; })
+	       != settings.end();
+}
+
+// The getters store numbers at their native width (a bool is one byte), while
+//  the save functions read what the client sends: 64 bit integers and bools.
+//  Widens a value to that encoding so merged entries can be saved and compared.
+static void normalizeCurrentValue(const std::string& type, const std::string& subType, std::vector<char>& value)
+{
+	bool isInt  = type.compare("OBS_PROPERTY_INT") == 0
+	             || (type.compare("OBS_PROPERTY_LIST") == 0 && subType.compare("OBS_COMBO_FORMAT_INT") == 0);
+	bool isUInt = type.compare("OBS_PROPERTY_UINT") == 0 || type.compare("OBS_PROPERTY_BOOL") == 0;
+	if ((!isInt && !isUInt) || value.size() >= sizeof(uint64_t))
+		return;
+
+	uint64_t widened = 0;
+	if (type.compare("OBS_PROPERTY_BOOL") == 0) {
+		widened = std::any_of(value.begin(), value.end(), [](char c) { return c != 0; }) ? 1 : 0;
+	} else if (value.size() == sizeof(int32_t)) {
+		int32_t narrow;
+		memcpy(&narrow, value.data(), sizeof(narrow));
+		widened = isInt ? uint64_t(int64_t(narrow)) : uint64_t(uint32_t(narrow));
+	} else if (value.size() > 0) {
+		memcpy(&widened, value.data(), value.size());
+	}
+
+	value.resize(sizeof(widened));
+	memcpy(value.data(), &widened, sizeof(widened));
+}
+
+std::vector<SubCategory>
+    OBS_settings::mergeSettingsPatch(std::vector<SubCategory>& settings, const std::vector<SubCategory>& patch)
+{
+	std::vector<SubCategory> changes;
+
+	// Everything in 'settings' may be handed to a save function, not only the
+	//  changed entries, so all of it is brought to the client encoding.
+	for (SubCategory& sc : settings) {
+		for (Parameter& param : sc.params) {
+			normalizeCurrentValue(param.type, param.subType, param.currentValue);
+			param.sizeOfCurrentValue = param.currentValue.size();
+		}
+	}
+
+	for (const SubCategory& patchSc : patch) {
+		auto sc = std::find_if(settings.begin(), settings.end(), [&patchSc](const SubCategory& sc) {
+			return sc.name.compare(patchSc.name) == 0;
+		});
+		if (sc == settings.end())
+			continue;
+
+		SubCategory changed;
+		changed.name = sc->name;
+
+		for (const Parameter& patchParam : patchSc.params) {
+			auto param = std::find_if(sc->params.begin(), sc->params.end(), [&patchParam](const Parameter& param) {
+				return param.name.compare(patchParam.name) == 0;
+			});
+			if (param == sc->params.end())
+				continue;
+
+			std::vector<char> value = patchParam.currentValue;
+			normalizeCurrentValue(param->type, param->subType, value);
+			if (param->currentValue == value)
+				continue;
+
+			param->currentValue       = std::move(value);
+			param->sizeOfCurrentValue = param->currentValue.size();
+			changed.params.push_back(*param);
+		}
+
+		if (changed.params.size() > 0) {
+			changed.paramsCount = changed.params.size();
+			changes.push_back(changed);
+		}
+	}
+
+	return changes;
+}
+
+uint32_t OBS_settings::saveOutputSettingsPatch(std::vector<SubCategory>& settings, std::vector<SubCategory>& changes)
+{
+	// Switching the output mode changes the layout of the whole category.
+	if (hasSubCategory(changes, "Untitled")) {
+		saveOutputSettings(settings);
+		return osn::settings_wire::reset::Encoder;
+	}
+
+	const char* mode = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
+	if (mode == nullptr || strcmp(mode, "Advanced") != 0) {
+		saveSimpleOutputSettings(changes);
+		if (hasSubCategory(changes, "Streaming") || hasSubCategory(changes, "Recording"))
+			return osn::settings_wire::reset::Encoder;
+		return 0;
+	}
+
+	// The encoder pages are positional and end up in the encoder's own data,
+	//  so they are saved as a whole but only when one of their fields changed.
+	uint32_t                 reset = 0;
+	std::vector<SubCategory> genericSettings;
+	for (SubCategory& sc : changes) {
+		if (sc.name.compare("Streaming") == 0) {
+			if (!obs_output_active(OBS_service::getStreamingOutput())) {
+				saveAdvancedOutputStreamingSettings(settings);
+				reset |= osn::settings_wire::reset::Encoder;
+			}
+		} else if (sc.name.compare("Recording") == 0) {
+			if (!obs_output_active(OBS_service::getRecordingOutput())) {
+				saveAdvancedOutputRecordingSettings(settings);
+				reset |= osn::settings_wire::reset::Encoder;
+			}
+		} else {
+			if (sc.name.compare(0, strlen("Audio - Track"), "Audio - Track") == 0)
+				reset |= osn::settings_wire::reset::Encoder;
+			genericSettings.push_back(sc);
+		}
+	}
+
+	if (genericSettings.size() > 0)
+		saveGenericSettings(genericSettings, "AdvOut", ConfigManager::getInstance().getBasic());
+
+	return reset;
+}
+
+uint32_t OBS_settings::saveAdvancedSettingsPatch(std::vector<SubCategory>& changes)
+{
+	uint32_t reset = 0;
+
+	for (SubCategory& sc : changes) {
+		std::vector<SubCategory> subCategory = {sc};
+
+		if (sc.name.compare("General") == 0) {
+			saveGenericSettings(subCategory, "General", ConfigManager::getInstance().getGlobal());
+		} else if (sc.name.compare("Video") == 0) {
+			saveGenericSettings(subCategory, "Video", ConfigManager::getInstance().getBasic());
+			reset |= osn::settings_wire::reset::Video;
+		} else if (sc.name.compare("Audio") == 0) {
+			saveGenericSettings(subCategory, "Audio", ConfigManager::getInstance().getBasic());
+			reset |= osn::settings_wire::reset::Audio;
+		} else if (sc.name.compare("Recording") == 0) {
+			saveGenericSettings(subCategory, "SimpleOutput", ConfigManager::getInstance().getBasic());
+		} else {
+			saveGenericSettings(subCategory, "Output", ConfigManager::getInstance().getBasic());
+		}
+	}
+
+	if (reset & osn::settings_wire::reset::Video)
+		OBS_service::resetVideoContext();
+	if (reset & osn::settings_wire::reset::Audio)
+		OBS_API::setAudioDeviceMonitoring();
+
+	return reset;
+}
+
+uint32_t OBS_settings::saveSettingsPatch(std::string nameCategory, std::vector<SubCategory> patch)
+{
+	std::vector<SubCategory> settings = getSettings(nameCategory);
+	std::vector<SubCategory> changes  = mergeSettingsPatch(settings, patch);
+	if (changes.size() == 0)
+		return 0;
+
+	uint32_t reset = 0;
+	if (nameCategory.compare("General") == 0) {
+		saveGenericSettings(changes, "BasicWindow", ConfigManager::getInstance().getGlobal());
+	} else if (nameCategory.compare("Stream") == 0) {
+		saveStreamSettings(settings);
+		OBS_service::updateService();
+		reset |= osn::settings_wire::reset::Service;
+	} else if (nameCategory.compare("Output") == 0) {
+		reset |= saveOutputSettingsPatch(settings, changes);
+	} else if (nameCategory.compare("Video") == 0) {
+		saveVideoSettings(settings);
+		OBS_service::resetVideoContext();
+		reset |= osn::settings_wire::reset::Video;
+	} else if (nameCategory.compare("Advanced") == 0) {
+		reset |= saveAdvancedSettingsPatch(changes);
+	}
+	return reset;
+}
+
 void OBS_settings::saveGenericSettings(std::vector<SubCategory> genericSettings, std::string section, config_t* config)
 {
 	SubCategory sc;
@@ -25,60 +25,6 @@ struct Parameter
 	size_t            sizeOfValues = 0;
 	size_t            countValues  = 0;
 	std::vector<char> values;
-
-	std::vector<char> serialize()
-	{
-		std::vector<char> buffer;
-		size_t            indexBuffer = 0;
-
-		size_t sizeStruct = name.length() + description.length() + type.length() + subType.length() + sizeof(size_t) * 7
-		                    + sizeof(bool) * 3 + sizeOfCurrentValue + sizeOfValues;
-		buffer.resize(sizeStruct);
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = name.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, name.data(), name.length());
-		indexBuffer += name.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = description.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, description.data(), description.length());
-		indexBuffer += description.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = type.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, type.data(), type.length());
-		indexBuffer += type.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = subType.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, subType.data(), subType.length());
-		indexBuffer += subType.length();
-
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = enabled;
-		indexBuffer += sizeof(bool);
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = masked;
-		indexBuffer += sizeof(bool);
-		*reinterpret_cast<bool*>(buffer.data() + indexBuffer) = visible;
-		indexBuffer += sizeof(bool);
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = sizeOfCurrentValue;
-		indexBuffer += sizeof(size_t);
-
-		memcpy(buffer.data() + indexBuffer, currentValue.data(), sizeOfCurrentValue);
-		indexBuffer += sizeOfCurrentValue;
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = sizeOfValues;
-		indexBuffer += sizeof(size_t);
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = countValues;
-		indexBuffer += sizeof(size_t);
-
-		memcpy(buffer.data() + indexBuffer, values.data(), sizeOfValues);
-		indexBuffer += sizeOfValues;
-
-		return buffer;
-	}
 };
 
 struct SubCategory
@@ -86,31 +32,6 @@ struct SubCategory
 	std::string            name;
 	size_t                 paramsCount = 0;
 	std::vector<Parameter> params;
-
-	std::vector<char> serialize()
-	{
-		std::vector<char> buffer;
-		size_t            indexBuffer = 0;
-
-		size_t sizeStruct = name.length() + sizeof(size_t) + sizeof(size_t);
-		buffer.resize(sizeStruct);
-
-		*reinterpret_cast<size_t*>(buffer.data()) = name.length();
-		indexBuffer += sizeof(size_t);
-		memcpy(buffer.data() + indexBuffer, name.data(), name.length());
-		indexBuffer += name.length();
-
-		*reinterpret_cast<size_t*>(buffer.data() + indexBuffer) = paramsCount;
-		indexBuffer += sizeof(size_t);
-
-		for (int i = 0; i < params.size(); i++) {
-			std::vector<char> serializedBuf = params.at(i).serialize();
-
-			buffer.insert(buffer.end(), serializedBuf.begin(), serializedBuf.end());
-		}
-
-		return buffer;
-	}
 };
 
 class OBS_settings
@@ -131,6 +52,11 @@ class OBS_settings
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_settings_saveSettingsPatch(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 	static void OBS_settings_getListCategories(
 	    void*                          data,
 	    const int64_t                  id,
@@ -143,6 +69,7 @@ class OBS_settings
 	// Exposed methods to the frontend
 	static std::vector<SubCategory> getSettings(std::string nameCategory);
 	static void                     saveSettings(std::string nameCategory, std::vector<SubCategory> settings);
+	static uint32_t                 saveSettingsPatch(std::string nameCategory, std::vector<SubCategory> patch);
 
 	// Get each category
 	static std::vector<SubCategory> getGeneralSettings();
@@ -162,6 +89,13 @@ class OBS_settings
 
 	static void saveGenericSettings(std::vector<SubCategory> genericSettings, std::string section, config_t* config);
 
+	// Partial saves, these only write the changed keys and return the reset
+	//  flags from settings-wire.hpp.
+	static std::vector<SubCategory>
+	                mergeSettingsPatch(std::vector<SubCategory>& settings, const std::vector<SubCategory>& patch);
+	static uint32_t saveOutputSettingsPatch(std::vector<SubCategory>& settings, std::vector<SubCategory>& changes);
+	static uint32_t saveAdvancedSettingsPatch(std::vector<SubCategory>& changes);
+
 	static SubCategory serializeSettingsData(
 	    std::string                                                   nameSubCategory,
 	    std::vector<std::vector<std::pair<std::string, std::string>>> entries,
@@ -0,0 +1,82 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-batch.hpp"
+#include "error.hpp"
+#include "ipc-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "shared.hpp"
+
+std::map<std::string, std::shared_ptr<ipc::collection>> osn::Batch::collections;
+
+void osn::Batch::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Batch");
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Execute", std::vector<ipc::type>{ipc::type::Binary}, Execute));
+	srv.register_collection(cls);
+}
+
+void osn::Batch::RegisterCollection(ipc::server& srv, std::shared_ptr<ipc::collection> cls)
+{
+	collections[cls->get_name()] = cls;
+	srv.register_collection(cls);
+}
+
+void osn::Batch::Execute(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<osn::batch::call> calls;
+	if (!osn::batch::deserialize_calls(args[0].value_bin, calls)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Malformed batch."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	// Calls are executed in order and each one gets its own result, a failing
+	//  call does not stop the ones after it. This mirrors what the client would
+	//  see when issuing the calls one by one.
+	std::vector<std::vector<ipc::value>> results(calls.size());
+	for (size_t idx = 0; idx < calls.size(); idx++) {
+		osn::batch::call&        call   = calls[idx];
+		std::vector<ipc::value>& result = results[idx];
+
+		auto cls = collections.find(call.collection);
+		if (cls == collections.end()) {
+			result.push_back(ipc::value((uint64_t)ErrorCode::NotFound));
+			result.push_back(ipc::value("Collection '" + call.collection + "' is not registered."));
+			continue;
+		}
+
+		std::shared_ptr<ipc::function> fn = cls->second->get_function(call.function, call.args);
+		if (!fn) {
+			result.push_back(ipc::value((uint64_t)ErrorCode::NotFound));
+			result.push_back(ipc::value("Function '" + call.function + "' with these arguments does not exist."));
+			continue;
+		}
+
+		fn->call(id, call.args, result);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::batch::serialize_results(results)));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,41 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <ipc-server.hpp>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace osn
+{
+	class Batch
+	{
+		public:
+		static void Register(ipc::server&);
+
+		// Register a collection with the server and make it reachable from
+		//  Batch.Execute. Use this instead of ipc::server::register_collection.
+		static void RegisterCollection(ipc::server& srv, std::shared_ptr<ipc::collection> cls);
+
+		static void
+		    Execute(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+
+		private:
+		static std::map<std::string, std::shared_ptr<ipc::collection>> collections;
+	};
+} // namespace osn
@@ -0,0 +1,130 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-call-stats.hpp"
+#include <chrono>
+#include <list>
+#include <mutex>
+#include "call-stats.hpp"
+#include "error.hpp"
+#include "osn-batch.hpp"
+#include "shared.hpp"
+
+struct MeasuredFunction
+{
+	std::string               collection;
+	std::string               function;
+	osn::CallStats::Handler   handler;
+	void*                     data;
+	osn::callstats::counters* stats;
+};
+
+static osn::callstats::registry    registry;
+static std::mutex                  functions_lock;
+static std::list<MeasuredFunction> functions;
+
+static void MeasuredCall(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	MeasuredFunction* fn    = static_cast<MeasuredFunction*>(data);
+	auto              start = std::chrono::steady_clock::now();
+
+	fn->handler(fn->data, id, args, rval);
+
+	auto end   = std::chrono::steady_clock::now();
+	bool error = rval.empty()
+	             || (rval[0].type == ipc::type::UInt64 && rval[0].value_union.ui64 != uint64_t(ErrorCode::Ok));
+	registry.record(
+	    *fn->stats,
+	    fn->collection,
+	    fn->function,
+	    uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count()),
+	    uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()),
+	    osn::callstats::payload_size(args),
+	    osn::callstats::payload_size(rval),
+	    error);
+}
+
+void osn::CallStats::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("CallStats");
+	cls->register_function(osn::CallStats::Function(cls, "Query", std::vector<ipc::type>{}, Query));
+	cls->register_function(osn::CallStats::Function(cls, "GetTrace", std::vector<ipc::type>{}, GetTrace));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "SetSampling", std::vector<ipc::type>{ipc::type::UInt32}, SetSampling));
+	cls->register_function(osn::CallStats::Function(cls, "Reset", std::vector<ipc::type>{}, Reset));
+	osn::Batch::RegisterCollection(srv, cls);
+}
+
+std::shared_ptr<ipc::function> osn::CallStats::Function(
+    std::shared_ptr<ipc::collection> cls,
+    const std::string&               name,
+    std::vector<ipc::type>           params,
+    Handler                          handler,
+    void*                            data)
+{
+	std::unique_lock<std::mutex> ul(functions_lock);
+	functions.push_back({cls->get_name(), name, handler, data, &registry.find(cls->get_name(), name)});
+	return std::make_shared<ipc::function>(name, params, MeasuredCall, &functions.back());
+}
+
+void osn::CallStats::Query(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::callstats::serialize_snapshots(registry.collect())));
+	AUTO_DEBUG;
+}
+
+void osn::CallStats::GetTrace(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::callstats::serialize_samples(registry.samples())));
+	AUTO_DEBUG;
+}
+
+void osn::CallStats::SetSampling(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	registry.set_sample_every(args[0].value_union.ui32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::CallStats::Reset(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	registry.reset();
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,61 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <ipc-server.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osn
+{
+	// Always-on counters, latency and payload size histograms for every IPC
+	//  function, plus a sampled call trace. The client keeps the same numbers
+	//  for its side of each call.
+	class CallStats
+	{
+		public:
+		typedef void (*Handler)(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		static void Register(ipc::server&);
+
+		// Create a function for 'cls' whose calls are measured. Use this
+		//  instead of constructing an ipc::function directly.
+		static std::shared_ptr<ipc::function> Function(
+		    std::shared_ptr<ipc::collection> cls,
+		    const std::string&               name,
+		    std::vector<ipc::type>           params,
+		    Handler                          handler,
+		    void*                            data = nullptr);
+
+		static void
+		    Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void
+		    GetTrace(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void SetSampling(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void
+		    Reset(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	};
+} // namespace osn
@@ -0,0 +1,132 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-events.hpp"
+#include <chrono>
+#include <iterator>
+#include "error.hpp"
+#include "ipc-batch.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-volmeter.hpp"
+#include "shared.hpp"
+
+std::mutex                          osn::Events::mtx;
+std::condition_variable             osn::Events::cv;
+std::deque<std::vector<ipc::value>> osn::Events::queue;
+bool                                osn::Events::woken    = false;
+bool                                osn::Events::draining = false;
+size_t                              osn::Events::polling  = 0;
+uint64_t                            osn::Events::dropped  = 0;
+
+void osn::Events::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Events");
+	cls->register_function(osn::CallStats::Function(cls, "Poll", std::vector<ipc::type>{ipc::type::UInt32}, Poll));
+	cls->register_function(osn::CallStats::Function(cls, "Interrupt", std::vector<ipc::type>{}, Interrupt));
+	osn::Batch::RegisterCollection(srv, cls);
+}
+
+void osn::Events::Publish(EventType type, std::vector<ipc::value> payload)
+{
+	payload.insert(payload.begin(), ipc::value((uint32_t)type));
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		if (queue.size() >= MaxQueued) {
+			queue.pop_front();
+			dropped++;
+		}
+		queue.push_back(std::move(payload));
+	}
+	cv.notify_all();
+}
+
+uint64_t osn::Events::Dropped()
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	return dropped;
+}
+
+void osn::Events::Wake()
+{
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		woken = true;
+	}
+	cv.notify_all();
+}
+
+void osn::Events::Interrupt(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	Wake();
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+bool osn::Events::Drain(std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	draining = true;
+	cv.notify_all();
+	return cv.wait_for(ulock, timeout, []() { return polling == 0; });
+}
+
+void osn::Events::Poll(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto timeout = std::chrono::milliseconds(args[0].value_union.ui32);
+
+	// Block until something happened or the timeout passed, so an idle client
+	//  does not wake up at all.
+	std::vector<std::vector<ipc::value>> events;
+	uint64_t                             total_dropped;
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		polling++;
+		cv.wait_for(ulock, timeout, []() { return woken || draining || !queue.empty(); });
+		events.reserve(queue.size() + 1);
+		std::move(queue.begin(), queue.end(), std::back_inserter(events));
+		queue.clear();
+		woken         = false;
+		total_dropped = dropped;
+	}
+
+	std::vector<char> frames = osn::VolMeter::TakePendingFrames();
+	if (frames.size()) {
+		events.push_back(
+		    std::vector<ipc::value>{ipc::value((uint32_t)EventType::VolMeter), ipc::value(std::move(frames))});
+	}
+
+	// Same framing as batch results: a list of value lists.
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::batch::serialize_results(events)));
+	rval.push_back(ipc::value(total_dropped));
+
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		polling--;
+	}
+	cv.notify_all();
+	AUTO_DEBUG;
+}
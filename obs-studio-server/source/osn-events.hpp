@@ -0,0 +1,71 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <ipc-server.hpp>
+#include <mutex>
+#include <vector>
+#include "event-type.hpp"
+
+namespace osn
+{
+	// Server side event queue. Producers publish from any thread, a single
+	//  client long-poll (Events.Poll) drains everything that is pending.
+	class Events
+	{
+		static std::mutex                          mtx;
+		static std::condition_variable             cv;
+		static std::deque<std::vector<ipc::value>> queue;
+		static bool                                woken;
+		static bool                                draining;
+		static size_t                              polling;
+		static uint64_t                            dropped;
+
+		public:
+		static void Register(ipc::server&);
+
+		// Events kept while nobody polls, the oldest are dropped beyond this.
+		static const size_t MaxQueued = 4096;
+
+		// Queue an event, 'payload' follows the layout documented in
+		//  event-type.hpp for 'type'.
+		static void Publish(EventType type, std::vector<ipc::value> payload);
+
+		// Number of events dropped because the queue was full.
+		static uint64_t Dropped();
+
+		// Wake a pending poll without queueing anything. Used by producers
+		//  that coalesce their own data and are collected during Poll.
+		static void Wake();
+
+		// Release every pending poll and make new ones return immediately, then
+		//  wait up to 'timeout' for them to finish. Used while shutting down.
+		static bool Drain(std::chrono::milliseconds timeout);
+
+		static void
+		    Poll(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		// Ends a pending poll early, for a client that stops polling.
+		static void Interrupt(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+	};
+} // namespace osn
@@ -18,6 +18,8 @@
 #include "osn-fader.hpp"
 #include "error.hpp"
 #include "obs.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
@@ -31,30 +33,29 @@ osn::Fader::Manager& osn::Fader::Manager::GetInstance()
 void osn::Fader::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Fader");
-	cls->register_function(std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
+	cls->register_function(osn::CallStats::Function(cls, "Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
+	    osn::CallStats::Function(cls, "Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDeziBel", std::vector<ipc::type>{ipc::type::UInt64}, GetDeziBel));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
+	    osn::CallStats::Function(cls, "GetDeziBel", std::vector<ipc::type>{ipc::type::UInt64}, GetDeziBel));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDeflection", std::vector<ipc::type>{ipc::type::UInt64}, GetDeflection));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
+	    osn::CallStats::Function(cls, "GetDeflection", std::vector<ipc::type>{ipc::type::UInt64}, GetDeflection));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetMultiplier", std::vector<ipc::type>{ipc::type::UInt64}, GetMultiplier));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
+	    osn::CallStats::Function(cls, "GetMultiplier", std::vector<ipc::type>{ipc::type::UInt64}, GetMultiplier));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	    osn::CallStats::Function(cls, "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
+	cls->register_function(osn::CallStats::Function(cls, "Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
 	cls->register_function(
-	    std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
+	    osn::CallStats::Function(cls, "AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
 	cls->register_function(
-	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Fader::Create(
@@ -20,18 +20,21 @@
 #include <memory>
 #include <obs.h>
 #include "error.hpp"
+#include "nodeobs_api.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
 void osn::Filter::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Filter");
-	cls->register_function(std::make_shared<ipc::function>("Types", std::vector<ipc::type>{}, Types));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
-	srv.register_collection(cls);
+	cls->register_function(osn::CallStats::Function(cls, "Types", std::vector<ipc::type>{}, Types));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Filter::Types(
@@ -45,6 +48,9 @@ void osn::Filter::Types(
 	for (size_t idx = 0; obs_enum_filter_types(idx, &typeId); idx++) {
 		rval.push_back(ipc::value(typeId ? typeId : ""));
 	}
+	for (const std::string& type : OBS_API::deferredTypes(OBS_API::ModuleTypes::Filter)) {
+		rval.push_back(ipc::value(type));
+	}
 	AUTO_DEBUG;
 }
 
@@ -66,6 +72,8 @@ void osn::Filter::Create(
 		break;
 	}
 
+	OBS_API::openModuleForType(sourceId);
+
 	obs_source_t* source = obs_source_create_private(sourceId.c_str(), name.c_str(), settings);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -0,0 +1,283 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-frame-trace.hpp"
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <obs.h>
+#include <util/platform.h>
+#include "error.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "shared.hpp"
+
+// About a minute of frames for all stages at 60 FPS with one display.
+#define FRAME_TRACE_CAPACITY 16384
+#define FRAME_TRACE_STAGES size_t(osn::FrameTrace::Stage::Count)
+
+static const char* stage_names[FRAME_TRACE_STAGES] = {"DisplayRender", "CompositeStart", "VideoOutput"};
+
+struct StageHistogram
+{
+	std::atomic<uint64_t> count;
+	std::atomic<uint64_t> total;
+	std::atomic<uint64_t> max;
+	// Bucket n counts durations in [2^n, 2^(n+1)) microseconds, the first and
+	//  the last one are open ended.
+	std::atomic<uint64_t> buckets[osn::FrameTrace::Buckets];
+};
+
+// Slots are written like a seqlock: 'sequence' is odd while a writer is busy
+//  and 2 * (position + 1) once the event for 'position' is complete.
+struct TraceEvent
+{
+	std::atomic<uint64_t> sequence;
+	std::atomic<uint64_t> begin;
+	std::atomic<uint64_t> duration;
+	std::atomic<uint32_t> stage;
+};
+
+static StageHistogram        histograms[FRAME_TRACE_STAGES];
+static TraceEvent            events[FRAME_TRACE_CAPACITY];
+static std::atomic<uint64_t> events_written(0);
+
+// Raw video listener, only ever (dis)connected outside of the graphics thread.
+static std::mutex connection_lock;
+static bool       output_tracing  = false;
+static video_t*   connected_video = nullptr;
+
+static uint32_t BucketFor(uint64_t duration_ns)
+{
+	uint64_t us     = duration_ns / 1000;
+	uint32_t bucket = 0;
+	while (us > 1 && bucket < osn::FrameTrace::Buckets - 1) {
+		us >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+static void VideoOutputCallback(void* param, struct video_data* frame)
+{
+	osn::FrameTrace::Record(osn::FrameTrace::Stage::VideoOutput, frame->timestamp, os_gettime_ns());
+}
+
+// Main render callbacks run before the main view is drawn, so this marks
+//  the start of the composite.
+static void CompositeCallback(void* param, uint32_t cx, uint32_t cy)
+{
+	osn::FrameTrace::Record(osn::FrameTrace::Stage::CompositeStart, obs_get_video_frame_time(), os_gettime_ns());
+}
+
+// Brings the listener in line with 'output_tracing' and the current video_t.
+//  obs_reset_video frees the old video_t together with our connection.
+static void UpdateConnection(std::unique_lock<std::mutex>& ul)
+{
+	video_t* current = obs_get_video();
+	video_t* video   = output_tracing ? current : nullptr;
+	if (connected_video && connected_video != current)
+		connected_video = nullptr;
+	if (video == connected_video)
+		return;
+
+	if (connected_video)
+		video_output_disconnect(connected_video, VideoOutputCallback, nullptr);
+	if (video)
+		video_output_connect(video, nullptr, VideoOutputCallback, nullptr);
+	connected_video = video;
+}
+
+void osn::FrameTrace::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("FrameTrace");
+	cls->register_function(osn::CallStats::Function(cls, "GetHistograms", std::vector<ipc::type>{}, GetHistograms));
+	cls->register_function(osn::CallStats::Function(cls, "GetTrace", std::vector<ipc::type>{}, GetTrace));
+	cls->register_function(osn::CallStats::Function(cls, "Reset", std::vector<ipc::type>{}, Reset));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetOutputTracing", std::vector<ipc::type>{ipc::type::UInt32}, SetOutputTracing));
+	osn::Batch::RegisterCollection(srv, cls);
+}
+
+void osn::FrameTrace::Start()
+{
+	obs_add_main_render_callback(CompositeCallback, nullptr);
+}
+
+void osn::FrameTrace::Stop()
+{
+	// Waits for a callback that is already running.
+	obs_remove_main_render_callback(CompositeCallback, nullptr);
+
+	std::unique_lock<std::mutex> ul(connection_lock);
+	output_tracing = false;
+	UpdateConnection(ul);
+}
+
+void osn::FrameTrace::VideoReset()
+{
+	std::unique_lock<std::mutex> ul(connection_lock);
+	UpdateConnection(ul);
+}
+
+void osn::FrameTrace::Record(Stage stage, uint64_t begin, uint64_t end)
+{
+	uint64_t        duration  = end > begin ? end - begin : 0;
+	StageHistogram& histogram = histograms[size_t(stage)];
+
+	histogram.count.fetch_add(1, std::memory_order_relaxed);
+	histogram.total.fetch_add(duration, std::memory_order_relaxed);
+	histogram.buckets[BucketFor(duration)].fetch_add(1, std::memory_order_relaxed);
+	uint64_t max = histogram.max.load(std::memory_order_relaxed);
+	while (duration > max && !histogram.max.compare_exchange_weak(max, duration, std::memory_order_relaxed)) {
+	}
+
+	uint64_t    position = events_written.fetch_add(1, std::memory_order_relaxed);
+	TraceEvent& event    = events[position % FRAME_TRACE_CAPACITY];
+	event.sequence.store(position * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	event.begin.store(begin, std::memory_order_relaxed);
+	event.duration.store(duration, std::memory_order_relaxed);
+	event.stage.store(uint32_t(stage), std::memory_order_relaxed);
+	event.sequence.store(position * 2 + 2, std::memory_order_release);
+}
+
+void osn::FrameTrace::GetHistograms(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	VideoReset();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uint32_t(FRAME_TRACE_STAGES)));
+	for (size_t stage = 0; stage < FRAME_TRACE_STAGES; stage++) {
+		StageHistogram&       histogram = histograms[stage];
+		std::vector<uint64_t> buckets(Buckets);
+		for (size_t bucket = 0; bucket < Buckets; bucket++)
+			buckets[bucket] = histogram.buckets[bucket].load(std::memory_order_relaxed);
+
+		std::vector<char> buf(sizeof(uint64_t) * Buckets);
+		memcpy(buf.data(), buckets.data(), buf.size());
+
+		rval.push_back(ipc::value(stage_names[stage]));
+		rval.push_back(ipc::value(histogram.count.load(std::memory_order_relaxed)));
+		rval.push_back(ipc::value(histogram.total.load(std::memory_order_relaxed)));
+		rval.push_back(ipc::value(histogram.max.load(std::memory_order_relaxed)));
+		rval.push_back(ipc::value(buf));
+	}
+	AUTO_DEBUG;
+}
+
+void osn::FrameTrace::GetTrace(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	VideoReset();
+
+	uint64_t end   = events_written.load(std::memory_order_acquire);
+	uint64_t begin = end > FRAME_TRACE_CAPACITY ? end - FRAME_TRACE_CAPACITY : 0;
+
+	// Each stage gets its own track, "ts" and "dur" are in microseconds.
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	json.reserve(json.size() + size_t(end - begin) * 96);
+	for (uint32_t stage = 0; stage < FRAME_TRACE_STAGES; stage++) {
+		char entry[128];
+		snprintf(
+		    entry,
+		    sizeof(entry),
+		    "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"name\":\"%s\"}}",
+		    stage ? "," : "",
+		    stage,
+		    stage_names[stage]);
+		json += entry;
+	}
+
+	for (uint64_t position = begin; position < end; position++) {
+		TraceEvent& event    = events[position % FRAME_TRACE_CAPACITY];
+		uint64_t    sequence = event.sequence.load(std::memory_order_acquire);
+		uint64_t    start    = event.begin.load(std::memory_order_relaxed);
+		uint64_t    duration = event.duration.load(std::memory_order_relaxed);
+		uint32_t    stage    = event.stage.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// Skip slots that are still being written or were reused already.
+		if (sequence != position * 2 + 2 || event.sequence.load(std::memory_order_relaxed) != sequence)
+			continue;
+		if (stage >= FRAME_TRACE_STAGES)
+			continue;
+
+		char entry[192];
+		snprintf(
+		    entry,
+		    sizeof(entry),
+		    ",{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu32
+		    ",\"ts\":%.3f,\"dur\":%.3f}",
+		    stage_names[stage],
+		    stage,
+		    double(start) / 1000.0,
+		    double(duration) / 1000.0);
+		json += entry;
+	}
+	json += "]}";
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(json));
+	AUTO_DEBUG;
+}
+
+void osn::FrameTrace::Reset(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Concurrent writers may land a sample in between, which is fine for
+	//  statistics that start over.
+	for (StageHistogram& histogram : histograms) {
+		histogram.count.store(0, std::memory_order_relaxed);
+		histogram.total.store(0, std::memory_order_relaxed);
+		histogram.max.store(0, std::memory_order_relaxed);
+		for (std::atomic<uint64_t>& bucket : histogram.buckets)
+			bucket.store(0, std::memory_order_relaxed);
+	}
+	for (TraceEvent& event : events)
+		event.sequence.store(0, std::memory_order_relaxed);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::FrameTrace::SetOutputTracing(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ul(connection_lock);
+	output_tracing = args[0].value_union.ui32 != 0;
+	UpdateConnection(ul);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
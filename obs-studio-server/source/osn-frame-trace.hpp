@@ -0,0 +1,74 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <cstdint>
+#include <ipc-server.hpp>
+#include <vector>
+
+namespace osn
+{
+	// Per-frame latency instrumentation. Every stage records into a lock-free
+	//  log2 histogram and into a bounded event ring that can be dumped as
+	//  Chrome trace-event JSON (chrome://tracing, Perfetto).
+	class FrameTrace
+	{
+		public:
+		enum class Stage : uint32_t
+		{
+			// Duration of a single OBS::Display draw callback.
+			DisplayRender,
+			// Video tick to the graphics thread starting the main composite.
+			CompositeStart,
+			// Video tick to delivery to raw video consumers, which is where
+			//  encoders pick up the frame. Off until SetOutputTracing, as a raw
+			//  video consumer forces a texture download for every frame.
+			VideoOutput,
+
+			Count
+		};
+
+		static const uint32_t Buckets = 24;
+
+		static void Register(ipc::server&);
+
+		// Hooks the graphics and video threads, from OBS_API_initAPI until
+		//  OBS_API_destroyOBS_API.
+		static void Start();
+		static void Stop();
+		// Call after obs_reset_video so the VideoOutput stage follows the new video_t.
+		static void VideoReset();
+
+		// Times are os_gettime_ns() values.
+		static void Record(Stage stage, uint64_t begin, uint64_t end);
+
+		static void GetHistograms(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void
+		    GetTrace(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void
+		    Reset(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void SetOutputTracing(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+	};
+} // namespace osn
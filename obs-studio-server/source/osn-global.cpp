@@ -18,6 +18,8 @@
 #include "osn-global.hpp"
 #include <error.hpp>
 #include <obs.h>
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -25,17 +27,17 @@ void osn::Global::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Global");
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetOutputSource", std::vector<ipc::type>{ipc::type::UInt32}, GetOutputSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetOutputSource", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64}, SetOutputSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetOutputFlagsFromId", std::vector<ipc::type>{ipc::type::String}, GetOutputFlagsFromId));
-	cls->register_function(std::make_shared<ipc::function>("LaggedFrames", std::vector<ipc::type>{}, LaggedFrames));
-	cls->register_function(std::make_shared<ipc::function>("TotalFrames", std::vector<ipc::type>{}, TotalFrames));
-	cls->register_function(std::make_shared<ipc::function>("GetLocale", std::vector<ipc::type>{}, GetLocale));
+	    osn::CallStats::Function(cls, "GetOutputSource", std::vector<ipc::type>{ipc::type::UInt32}, GetOutputSource));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetOutputSource", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64}, SetOutputSource));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetOutputFlagsFromId", std::vector<ipc::type>{ipc::type::String}, GetOutputFlagsFromId));
+	cls->register_function(osn::CallStats::Function(cls, "LaggedFrames", std::vector<ipc::type>{}, LaggedFrames));
+	cls->register_function(osn::CallStats::Function(cls, "TotalFrames", std::vector<ipc::type>{}, TotalFrames));
+	cls->register_function(osn::CallStats::Function(cls, "GetLocale", std::vector<ipc::type>{}, GetLocale));
 	cls->register_function(
-	    std::make_shared<ipc::function>("SetLocale", std::vector<ipc::type>{ipc::type::String}, SetLocale));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "SetLocale", std::vector<ipc::type>{ipc::type::String}, SetLocale));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Global::GetOutputSource(
@@ -17,30 +17,32 @@
 
 #include "osn-IEncoder.hpp"
 #include <obs.h>
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 
 void osn::IEncoder::Register(ipc::server& srv)
 {
 	auto cls = std::make_shared<ipc::collection>("IEncoder");
-	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::String}, &GetId));
+	cls->register_function(osn::CallStats::Function(cls, "GetId", std::vector<ipc::type>{ipc::type::String}, &GetId));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::String}, &GetName));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetName", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &SetName));
+	    osn::CallStats::Function(cls, "GetName", std::vector<ipc::type>{ipc::type::String}, &GetName));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetName", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &SetName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetCaps", std::vector<ipc::type>{ipc::type::String}, &GetCaps));
+	    osn::CallStats::Function(cls, "GetCaps", std::vector<ipc::type>{ipc::type::String}, &GetCaps));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetType", std::vector<ipc::type>{ipc::type::String}, &GetType));
+	    osn::CallStats::Function(cls, "GetType", std::vector<ipc::type>{ipc::type::String}, &GetType));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetCodec", std::vector<ipc::type>{ipc::type::String}, &GetCodec));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Update", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &Update));
+	    osn::CallStats::Function(cls, "GetCodec", std::vector<ipc::type>{ipc::type::String}, &GetCodec));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::String}, &GetProperties));
+	    osn::CallStats::Function(cls, "Update", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, &Update));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::String}, &GetSettings));
+	    osn::CallStats::Function(cls, "GetProperties", std::vector<ipc::type>{ipc::type::String}, &GetProperties));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::String}, &Release));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "GetSettings", std::vector<ipc::type>{ipc::type::String}, &GetSettings));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Release", std::vector<ipc::type>{ipc::type::String}, &Release));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::IEncoder::GetId(
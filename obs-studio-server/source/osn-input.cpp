@@ -16,92 +16,109 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
 
 #include "osn-Input.hpp"
+#include <cstring>
 #include <iostream>
 #include <ipc-server.hpp>
+#include <map>
 #include <memory>
 #include <obs.h>
+#include <set>
 #include "error.hpp"
+#include "nodeobs_api.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-settings-delta.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
 void osn::Input::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Input");
-	cls->register_function(std::make_shared<ipc::function>("Types", std::vector<ipc::type>{}, Types));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(cls, "Types", std::vector<ipc::type>{}, Types));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "Create",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String, ipc::type::String},
 	    Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls, "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "CreatePrivate",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
 	    CreatePrivate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
+	    osn::CallStats::Function(cls, "FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
+	    osn::CallStats::Function(cls, "GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Duplicate));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
+	    osn::CallStats::Function(cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Duplicate));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetActive", std::vector<ipc::type>{ipc::type::UInt64}, GetActive));
+	    osn::CallStats::Function(cls, "GetActive", std::vector<ipc::type>{ipc::type::UInt64}, GetActive));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetShowing", std::vector<ipc::type>{ipc::type::UInt64}, GetShowing));
+	    osn::CallStats::Function(cls, "GetShowing", std::vector<ipc::type>{ipc::type::UInt64}, GetShowing));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetWidth", std::vector<ipc::type>{ipc::type::UInt64}, GetWidth));
+	    osn::CallStats::Function(cls, "GetWidth", std::vector<ipc::type>{ipc::type::UInt64}, GetWidth));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetHeight", std::vector<ipc::type>{ipc::type::UInt64}, GetHeight));
+	    osn::CallStats::Function(cls, "GetHeight", std::vector<ipc::type>{ipc::type::UInt64}, GetHeight));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetVolume", std::vector<ipc::type>{ipc::type::UInt64}, GetVolume));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
+	    osn::CallStats::Function(cls, "GetVolume", std::vector<ipc::type>{ipc::type::UInt64}, GetVolume));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64}, GetSyncOffset));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset));
+	    osn::CallStats::Function(cls, "GetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64}, GetSyncOffset));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64}, GetAudioMixers));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAudioMixers));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64}, GetMonitoringType));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMonitoringType));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetDeInterlaceFieldOrder", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceFieldOrder));
-	cls->register_function(std::make_shared<ipc::function>(
+	    osn::CallStats::Function(cls, "GetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64}, GetAudioMixers));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAudioMixers));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64}, GetMonitoringType));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMonitoringType));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetDeInterlaceFieldOrder", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceFieldOrder));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "SetDeInterlaceFieldOrder",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
 	    SetDeInterlaceFieldOrder));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceMode));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetDeInterlaceMode));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64}, GetDeInterlaceMode));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetDeInterlaceMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetDeInterlaceMode));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetFilters", std::vector<ipc::type>{ipc::type::UInt64}, GetFilters));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "AddFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "RemoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, RemoveFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "MoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32}, MoveFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "FindFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "CopyFiltersTo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, CopyFiltersTo));
-
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "GetFilters", std::vector<ipc::type>{ipc::type::UInt64}, GetFilters));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "AddFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddFilter));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "RemoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, RemoveFilter));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "MoveFilter",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32},
+	    MoveFilter));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "FindFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindFilter));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "CopyFiltersTo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, CopyFiltersTo));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetFilterChain", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, SetFilterChain));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetFilterChain", std::vector<ipc::type>{ipc::type::Binary, ipc::type::String}, SetFilterChain));
+
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Input::Types(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
@@ -111,6 +128,9 @@ void osn::Input::Types(void* data, const int64_t id, const std::vector<ipc::valu
 	for (size_t idx = 0; obs_enum_input_types(idx, &typeId); idx++) {
 		rval.push_back(ipc::value(typeId ? typeId : ""));
 	}
+	for (const std::string& type : OBS_API::deferredTypes(OBS_API::ModuleTypes::Input)) {
+		rval.push_back(ipc::value(type));
+	}
 	AUTO_DEBUG;
 }
 
@@ -134,6 +154,8 @@ void osn::Input::Create(
 		break;
 	}
 
+	OBS_API::openModuleForType(sourceId);
+
 	obs_source_t* source = obs_source_create(sourceId.c_str(), name.c_str(), settings, hotkeys);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -174,6 +196,8 @@ void osn::Input::CreatePrivate(
 		break;
 	}
 
+	OBS_API::openModuleForType(sourceId);
+
 	obs_source_t* source = obs_source_create_private(sourceId.c_str(), name.c_str(), settings);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -214,6 +238,11 @@ void osn::Input::Duplicate(
 	bool        isPrivate    = false;
 	const char* nameOverride = nullptr;
 
+	// The copy takes the current settings of the input and of its filters.
+	osn::SettingsDelta::Flush(filter);
+	obs_source_enum_filters(
+	    filter, [](obs_source_t* parent, obs_source_t* child, void* data) { osn::SettingsDelta::Flush(child); }, nullptr);
+
 	obs_source_t* source = nullptr;
 	source               = obs_source_duplicate(filter, nameOverride, isPrivate);
 
@@ -795,3 +824,254 @@ void osn::Input::CopyFiltersTo(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
+
+struct FilterLink
+{
+	std::string type;
+	std::string name;
+	obs_data_t* settings = nullptr;
+	bool        enabled  = true;
+};
+
+static std::vector<obs_source_t*> ListFilters(obs_source_t* input)
+{
+	std::vector<obs_source_t*> filters;
+	auto                       enum_cb = [](obs_source_t* parent, obs_source_t* filter, void* data) {
+        reinterpret_cast<std::vector<obs_source_t*>*>(data)->push_back(filter);
+	};
+	obs_source_enum_filters(input, enum_cb, &filters);
+	return filters;
+}
+
+// What it takes to bring the filters of an input in line with a chain. All
+//  filters in here hold a reference until ReleaseFilterPlan.
+struct FilterPlan
+{
+	std::vector<obs_source_t*> current;  // Filters on the input right now.
+	std::vector<bool>          claimed;  // Per 'current', kept for the chain.
+	std::vector<obs_source_t*> desired;  // Per chain link, existing or created.
+	std::vector<obs_source_t*> created;  // Not attached to the input yet.
+};
+
+static void ReleaseFilterPlan(FilterPlan& plan)
+{
+	for (obs_source_t* filter : plan.current)
+		obs_source_release(filter);
+	for (obs_source_t* filter : plan.created)
+		obs_source_release(filter);
+	plan = FilterPlan();
+}
+
+// Matches the filters of 'input' against 'chain' by name and type, creates the
+//  missing ones without attaching them and writes the id of every resulting
+//  filter to 'ids', in chain order. Does not change the input.
+static bool PlanFilterChain(
+    obs_source_t* input, const std::vector<FilterLink>& chain, FilterPlan& plan, uint64_t* ids, std::string& error)
+{
+	plan.current = ListFilters(input);
+	plan.claimed.assign(plan.current.size(), false);
+	plan.desired.assign(chain.size(), nullptr);
+	for (obs_source_t* filter : plan.current)
+		obs_source_addref(filter);
+
+	for (size_t idx = 0; idx < chain.size(); idx++) {
+		for (size_t cur = 0; cur < plan.current.size(); cur++) {
+			if (plan.claimed[cur] || chain[idx].name != obs_source_get_name(plan.current[cur]))
+				continue;
+			if (chain[idx].type == obs_source_get_id(plan.current[cur])) {
+				plan.claimed[cur] = true;
+				plan.desired[idx] = plan.current[cur];
+			}
+			break;
+		}
+	}
+
+	for (size_t idx = 0; idx < chain.size(); idx++) {
+		const FilterLink& link = chain[idx];
+		if (!plan.desired[idx]) {
+			obs_source_t* filter = obs_source_create_private(link.type.c_str(), link.name.c_str(), link.settings);
+			if (!filter) {
+				error = "Failed to create filter '" + link.name + "'.";
+				return false;
+			}
+			plan.created.push_back(filter);
+			if (obs_source_get_type(filter) != OBS_SOURCE_TYPE_FILTER) {
+				error = "Type '" + link.type + "' is not a filter.";
+				return false;
+			}
+			plan.desired[idx] = filter;
+		}
+
+		uint64_t uid = osn::Source::Manager::GetInstance().find(plan.desired[idx]);
+		if (uid == UINT64_MAX) {
+			uid = osn::Source::Manager::GetInstance().allocate(plan.desired[idx]);
+			if (uid == UINT64_MAX) {
+				error = "Index list is full.";
+				return false;
+			}
+			osn::Source::attach_source_signals(plan.desired[idx]);
+		}
+		ids[idx] = uid;
+	}
+	return true;
+}
+
+// Applies a plan from PlanFilterChain: removes what the chain does not keep,
+//  updates what it does, attaches the created filters and fixes the order.
+//  The input takes its own reference to the filters it gets.
+static void CommitFilterChain(obs_source_t* input, const std::vector<FilterLink>& chain, FilterPlan& plan)
+{
+	for (size_t cur = 0; cur < plan.current.size(); cur++) {
+		if (!plan.claimed[cur])
+			obs_source_filter_remove(input, plan.current[cur]);
+	}
+
+	size_t created = 0;
+	for (size_t idx = 0; idx < chain.size(); idx++) {
+		const FilterLink& link   = chain[idx];
+		obs_source_t*     filter = plan.desired[idx];
+		if (created < plan.created.size() && plan.created[created] == filter) {
+			created++;
+			obs_source_set_enabled(filter, link.enabled);
+			obs_source_filter_add(input, filter);
+			continue;
+		}
+
+		if (link.settings) {
+			osn::SettingsDelta::Flush(filter);
+			obs_source_update(filter, link.settings);
+		}
+		if (obs_source_enabled(filter) != link.enabled)
+			obs_source_set_enabled(filter, link.enabled);
+	}
+
+	// Everything left on the input is in 'desired' now. Keep the longest
+	//  prefix that already matches and move the rest to the bottom in order.
+	std::vector<obs_source_t*> order = ListFilters(input);
+	size_t                     first = 0;
+	while (first < plan.desired.size() && first < order.size() && order[first] == plan.desired[first])
+		first++;
+	for (size_t idx = first; idx < plan.desired.size(); idx++)
+		obs_source_filter_set_order(input, plan.desired[idx], OBS_ORDER_MOVE_BOTTOM);
+}
+
+void osn::Input::SetFilterChain(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<obs_source_t*> inputs;
+	if (args[0].type == ipc::type::Binary) {
+		const std::vector<char>& packed = args[0].value_bin;
+		inputs.resize(packed.size() / sizeof(uint64_t));
+		for (size_t idx = 0; idx < inputs.size(); idx++) {
+			uint64_t uid;
+			std::memcpy(&uid, packed.data() + idx * sizeof(uint64_t), sizeof(uint64_t));
+			inputs[idx] = osn::Source::Manager::GetInstance().find(uid);
+		}
+	} else {
+		inputs.push_back(osn::Source::Manager::GetInstance().find(args[0].value_union.ui64));
+	}
+	for (obs_source_t* input : inputs) {
+		if (!input) {
+			rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+			rval.push_back(ipc::value("Input reference is not valid."));
+			AUTO_DEBUG;
+			return;
+		}
+	}
+
+	// The chain arrives as a JSON array, which obs_data can only parse as a member.
+	std::string       json  = "{\"chain\":" + args[1].value_str + "}";
+	obs_data_t*       root  = obs_data_create_from_json(json.c_str());
+	obs_data_array_t* array = root ? obs_data_get_array(root, "chain") : nullptr;
+	if (!array) {
+		if (root)
+			obs_data_release(root);
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Filter chain is not a valid array."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	// Validate the whole chain before touching any input.
+	std::vector<FilterLink> chain(obs_data_array_count(array));
+	std::set<std::string>   names;
+	std::set<std::string>   filter_types;
+	std::string             error;
+	for (size_t idx = 0; idx < chain.size(); idx++) {
+		obs_data_t* item = obs_data_array_item(array, idx);
+		chain[idx].type  = obs_data_get_string(item, "type");
+		chain[idx].name  = obs_data_get_string(item, "name");
+		if (obs_data_has_user_value(item, "settings"))
+			chain[idx].settings = obs_data_get_obj(item, "settings");
+		if (obs_data_has_user_value(item, "enabled"))
+			chain[idx].enabled = obs_data_get_bool(item, "enabled");
+		obs_data_release(item);
+
+		if (chain[idx].name.empty() || !names.insert(chain[idx].name).second) {
+			error = "Filter names must be unique and not empty.";
+			break;
+		}
+		OBS_API::openModuleForType(chain[idx].type);
+	}
+	obs_data_array_release(array);
+	obs_data_release(root);
+
+	// Only filter types, obs_source_get_display_name would take inputs and
+	//  transitions as well.
+	if (error.empty()) {
+		const char* type = nullptr;
+		for (size_t idx = 0; obs_enum_filter_types(idx, &type); idx++)
+			filter_types.insert(type ? type : "");
+		for (const FilterLink& link : chain) {
+			if (!filter_types.count(link.type)) {
+				error = "Filter type '" + link.type + "' is not available.";
+				break;
+			}
+		}
+	}
+
+	// Every filter for every input is created first, the inputs only change
+	//  once that worked for all of them, so a failure leaves them all as they were.
+	std::vector<char>       buffer;
+	std::vector<FilterPlan> plans(inputs.size());
+	if (error.empty()) {
+		buffer.resize(inputs.size() * chain.size() * sizeof(uint64_t));
+		uint64_t* ids = reinterpret_cast<uint64_t*>(buffer.data());
+		std::map<obs_source_t*, size_t> planned;
+		for (size_t idx = 0; idx < inputs.size() && error.empty(); idx++) {
+			// An input listed twice gets the same filters both times.
+			auto first = planned.emplace(inputs[idx], idx);
+			if (!first.second) {
+				std::memcpy(
+				    ids + idx * chain.size(), ids + first.first->second * chain.size(), chain.size() * sizeof(uint64_t));
+				continue;
+			}
+			PlanFilterChain(inputs[idx], chain, plans[idx], ids + idx * chain.size(), error);
+		}
+		if (error.empty()) {
+			for (auto& entry : planned)
+				CommitFilterChain(entry.first, chain, plans[entry.second]);
+		}
+	}
+	for (FilterPlan& plan : plans)
+		ReleaseFilterPlan(plan);
+
+	for (FilterLink& link : chain) {
+		if (link.settings)
+			obs_data_release(link.settings);
+	}
+
+	if (!error.empty()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value(error));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buffer));
+	AUTO_DEBUG;
+}
@@ -142,5 +142,12 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+		// Takes one input id or packed input ids plus a JSON chain and
+		//  returns the packed filter ids, one row of the chain per input.
+		static void SetFilterChain(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 	};
 } // namespace osn
\ No newline at end of file
@@ -17,6 +17,8 @@
 
 #include "osn-module.hpp"
 #include "error.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "shared.hpp"
 
 void osn::Module::Register(ipc::server& srv)
@@ -24,25 +26,25 @@ void osn::Module::Register(ipc::server& srv)
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Module");
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Open", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Open));
+	    osn::CallStats::Function(cls, "Open", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Open));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Initialize", std::vector<ipc::type>{ipc::type::UInt64}, Initialize));
+	    osn::CallStats::Function(cls, "Initialize", std::vector<ipc::type>{ipc::type::UInt64}, Initialize));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
+	    osn::CallStats::Function(cls, "GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetFileName", std::vector<ipc::type>{ipc::type::UInt64}, GetFileName));
+	    osn::CallStats::Function(cls, "GetFileName", std::vector<ipc::type>{ipc::type::UInt64}, GetFileName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetAuthor", std::vector<ipc::type>{ipc::type::UInt64}, GetAuthor));
+	    osn::CallStats::Function(cls, "GetAuthor", std::vector<ipc::type>{ipc::type::UInt64}, GetAuthor));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDescription", std::vector<ipc::type>{ipc::type::UInt64}, GetDescription));
+	    osn::CallStats::Function(cls, "GetDescription", std::vector<ipc::type>{ipc::type::UInt64}, GetDescription));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetBinaryPath", std::vector<ipc::type>{ipc::type::UInt64}, GetBinaryPath));
+	    osn::CallStats::Function(cls, "GetBinaryPath", std::vector<ipc::type>{ipc::type::UInt64}, GetBinaryPath));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
+	    osn::CallStats::Function(cls, "GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
+	    osn::CallStats::Function(cls, "GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
 
-	srv.register_collection(cls);
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Module::Open(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
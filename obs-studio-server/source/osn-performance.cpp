@@ -0,0 +1,235 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-performance.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <obs.h>
+#include <util/platform.h>
+#include "error.hpp"
+#include "nodeobs_service.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "shared.hpp"
+
+// Ten minutes at the default interval.
+#define PERFORMANCE_CAPACITY 1200
+#define PERFORMANCE_METRICS size_t(osn::PerformanceMetric::Count)
+
+struct PerformanceSample
+{
+	std::atomic<uint64_t> timestamp;
+	std::atomic<double>   values[PERFORMANCE_METRICS];
+};
+
+// Single writer ring: the sampler fills the slot for 'written' and then
+//  publishes it, readers copy what they need and drop anything the sampler
+//  may have overwritten in the meantime.
+static PerformanceSample       samples[PERFORMANCE_CAPACITY];
+static std::atomic<uint64_t>   written(0);
+static std::atomic<uint32_t>   interval_ms(0);
+static std::thread             sampler;
+static std::mutex              sampler_lock;
+static std::condition_variable sampler_cv;
+static bool                    sampler_running = false;
+
+static void Sample(os_cpu_usage_info_t* cpu, std::chrono::steady_clock::time_point start)
+{
+	static uint64_t last_bytes = 0, last_bytes_time = 0;
+	static uint32_t last_lagged = 0, last_skipped = 0;
+
+	double values[PERFORMANCE_METRICS] = {0};
+
+	values[size_t(osn::PerformanceMetric::CPU)]       = os_cpu_usage_info_query(cpu);
+	values[size_t(osn::PerformanceMetric::FrameRate)] = obs_get_active_fps();
+
+	// The IPC thread may replace the outputs at any time, hold a reference while sampling.
+	obs_output_t* streamOutput = OBS_service::getStreamingOutputRef();
+	uint64_t      now          = os_gettime_ns();
+	if (obs_output_active(streamOutput)) {
+		int totalDropped = obs_output_get_frames_dropped(streamOutput);
+		int totalFrames  = obs_output_get_total_frames(streamOutput);
+
+		values[size_t(osn::PerformanceMetric::DroppedFrames)] = totalDropped;
+		values[size_t(osn::PerformanceMetric::DroppedPercentage)] =
+		    totalFrames ? (double)totalDropped / (double)totalFrames * 100.0 : 0.0;
+		values[size_t(osn::PerformanceMetric::StreamingCongestion)] = obs_output_get_congestion(streamOutput);
+
+		uint64_t bytesSent = obs_output_get_total_bytes(streamOutput);
+		if (bytesSent < last_bytes)
+			last_bytes = 0;
+		if (last_bytes_time) {
+			double timePassed = double(now - last_bytes_time) / 1000000000.0;
+			values[size_t(osn::PerformanceMetric::Bandwidth)] =
+			    double((bytesSent - last_bytes) * 8) / timePassed / 1000.0;
+		}
+		last_bytes = bytesSent;
+	} else {
+		last_bytes = 0;
+	}
+	last_bytes_time = now;
+	obs_output_release(streamOutput);
+
+	obs_output_t* recordOutput = OBS_service::getRecordingOutputRef();
+	if (obs_output_active(recordOutput)) {
+		values[size_t(osn::PerformanceMetric::RecordingBytes)]      = double(obs_output_get_total_bytes(recordOutput));
+		values[size_t(osn::PerformanceMetric::RecordingCongestion)] = obs_output_get_congestion(recordOutput);
+	}
+	obs_output_release(recordOutput);
+
+	// Both counters only ever grow, the series holds what happened per interval.
+	uint32_t lagged  = obs_get_lagged_frames();
+	uint32_t skipped = obs_get_video() ? video_output_get_skipped_frames(obs_get_video()) : 0;
+	values[size_t(osn::PerformanceMetric::LaggedFrames)]  = lagged >= last_lagged ? lagged - last_lagged : lagged;
+	values[size_t(osn::PerformanceMetric::SkippedFrames)] = skipped >= last_skipped ? skipped - last_skipped : skipped;
+	last_lagged  = lagged;
+	last_skipped = skipped;
+
+	uint64_t           position = written.load(std::memory_order_relaxed);
+	PerformanceSample& sample   = samples[position % PERFORMANCE_CAPACITY];
+	sample.timestamp.store(
+	    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+	    std::memory_order_relaxed);
+	for (size_t idx = 0; idx < PERFORMANCE_METRICS; idx++) {
+		sample.values[idx].store(values[idx], std::memory_order_relaxed);
+	}
+	written.store(position + 1, std::memory_order_release);
+}
+
+static void SamplerThread(std::chrono::milliseconds interval)
+{
+	os_cpu_usage_info_t* cpu   = os_cpu_usage_info_start();
+	auto                 start = std::chrono::steady_clock::now();
+	auto                 next  = start;
+
+	std::unique_lock<std::mutex> ul(sampler_lock);
+	while (sampler_running) {
+		ul.unlock();
+		Sample(cpu, start);
+		ul.lock();
+
+		// Keep a fixed rate even if a sample took a while.
+		next += interval;
+		sampler_cv.wait_until(ul, next, []() { return !sampler_running; });
+	}
+
+	os_cpu_usage_info_destroy(cpu);
+}
+
+void osn::Performance::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Performance");
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Query", std::vector<ipc::type>{ipc::type::UInt32}, Query));
+	osn::Batch::RegisterCollection(srv, cls);
+}
+
+void osn::Performance::Start(std::chrono::milliseconds interval)
+{
+	std::unique_lock<std::mutex> ul(sampler_lock);
+	if (sampler_running)
+		return;
+
+	written         = 0;
+	interval_ms     = uint32_t(interval.count());
+	sampler_running = true;
+	sampler         = std::thread(SamplerThread, interval);
+}
+
+void osn::Performance::Stop()
+{
+	{
+		std::unique_lock<std::mutex> ul(sampler_lock);
+		if (!sampler_running)
+			return;
+		sampler_running = false;
+	}
+	sampler_cv.notify_all();
+	sampler.join();
+}
+
+double osn::Performance::Latest(PerformanceMetric metric)
+{
+	uint64_t position = written.load(std::memory_order_acquire);
+	if (position == 0)
+		return 0;
+	return samples[(position - 1) % PERFORMANCE_CAPACITY].values[size_t(metric)].load(std::memory_order_relaxed);
+}
+
+void osn::Performance::Query(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// A window of 0 returns everything still in the buffer.
+	uint64_t window = args[0].value_union.ui32;
+
+	uint64_t end   = written.load(std::memory_order_acquire);
+	uint64_t begin = end > PERFORMANCE_CAPACITY ? end - PERFORMANCE_CAPACITY : 0;
+
+	std::vector<uint64_t> timestamps(size_t(end - begin));
+	std::vector<double>   values(PERFORMANCE_METRICS * timestamps.size());
+	for (uint64_t position = begin; position < end; position++) {
+		PerformanceSample& sample = samples[position % PERFORMANCE_CAPACITY];
+		size_t             index  = size_t(position - begin);
+		timestamps[index]         = sample.timestamp.load(std::memory_order_relaxed);
+		for (size_t metric = 0; metric < PERFORMANCE_METRICS; metric++) {
+			values[metric * timestamps.size() + index] = sample.values[metric].load(std::memory_order_relaxed);
+		}
+	}
+
+	// The sampler may have started on the slot after 'after' already.
+	uint64_t after = written.load(std::memory_order_acquire);
+	size_t   first = 0;
+	if (after + 1 > begin + PERFORMANCE_CAPACITY)
+		first = size_t(std::min(end, after + 1 - PERFORMANCE_CAPACITY) - begin);
+	if (window && timestamps.size()) {
+		uint64_t newest = timestamps.back();
+		while (first < timestamps.size() && timestamps[first] + window < newest)
+			first++;
+	}
+
+	uint32_t          count = uint32_t(timestamps.size() - first);
+	std::vector<char> buf(osn::PerformanceSeriesSize(PERFORMANCE_METRICS, count));
+	char*             ptr = buf.data();
+
+	osn::PerformanceSeriesHeader header = {uint32_t(PERFORMANCE_METRICS), count, interval_ms, 0};
+	memcpy(ptr, &header, sizeof(header));
+	ptr += sizeof(header);
+	memcpy(ptr, timestamps.data() + first, sizeof(uint64_t) * count);
+	ptr += sizeof(uint64_t) * count;
+
+	std::vector<double> sorted(count);
+	for (size_t metric = 0; metric < PERFORMANCE_METRICS; metric++) {
+		const double* series = values.data() + metric * timestamps.size() + first;
+		std::copy(series, series + count, sorted.begin());
+
+		osn::PerformanceSummary summary = osn::SummarizePerformance(sorted.data(), count);
+		memcpy(ptr, &summary, sizeof(summary));
+		ptr += sizeof(summary);
+		memcpy(ptr, series, sizeof(double) * count);
+		ptr += sizeof(double) * count;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buf));
+	AUTO_DEBUG;
+}
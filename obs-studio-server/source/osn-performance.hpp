@@ -0,0 +1,43 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <chrono>
+#include <ipc-server.hpp>
+#include <vector>
+#include "performance-series.hpp"
+
+namespace osn
+{
+	// Samples the performance metrics at a fixed rate on its own thread, so
+	//  every caller sees the same numbers no matter how often it asks.
+	class Performance
+	{
+		public:
+		static void Register(ipc::server&);
+
+		// Sampling runs from OBS_API_initAPI until OBS_API_destroyOBS_API.
+		static void Start(std::chrono::milliseconds interval);
+		static void Stop();
+
+		// Most recent value of 'metric', 0 until the first sample was taken.
+		static double Latest(PerformanceMetric metric);
+
+		static void
+		    Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	};
+} // namespace osn
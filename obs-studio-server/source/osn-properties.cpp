@@ -16,19 +16,30 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
 
 #include "osn-Properties.hpp"
+#include <cstring>
 #include "error.hpp"
+#include "obs-property.hpp"
 #include "obs.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-settings-delta.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
+// Schemas are small, but layout hashes are unbounded so start over at some point.
+#define SCHEMA_CACHE_LIMIT 1024
+
+std::map<osn::Properties::schema_key, std::shared_ptr<osn::Properties::Schema>> osn::Properties::schemas;
+std::mutex                                                                      osn::Properties::schemas_lock;
+
 void osn::Properties::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Properties");
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Modified", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String}, Modified));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Clicked", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Clicked));
-	srv.register_collection(cls);
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Modified", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String}, Modified));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Clicked", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Clicked));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Properties::Modified(
@@ -81,6 +92,9 @@ void osn::Properties::Clicked(
 		return;
 	}
 
+	// Button callbacks usually act on the current settings.
+	osn::SettingsDelta::Flush(source);
+
 	obs_properties_t* props = obs_source_properties(source);
 	obs_property_t*   prop  = obs_properties_get(props, name.c_str());
 	if (!prop) {
@@ -94,3 +108,269 @@ void osn::Properties::Clicked(
 
 	AUTO_DEBUG;
 }
+
+std::shared_ptr<obs::Property> osn::Properties::Convert(obs_property_t* p)
+{
+	const char* buf;
+
+	if (p == nullptr)
+		return nullptr;
+
+	std::shared_ptr<obs::Property> prop;
+
+	switch (obs_property_get_type(p)) {
+	case OBS_PROPERTY_BOOL:
+		prop = std::make_shared<obs::BooleanProperty>();
+		break;
+	case OBS_PROPERTY_INT: {
+		auto prop2        = std::make_shared<obs::IntegerProperty>();
+		prop2->field_type = obs::NumberProperty::NumberType(obs_property_int_type(p));
+		prop2->minimum    = obs_property_int_min(p);
+		prop2->maximum    = obs_property_int_max(p);
+		prop2->step       = obs_property_int_step(p);
+		prop              = prop2;
+		break;
+	}
+	case OBS_PROPERTY_FLOAT: {
+		auto prop2        = std::make_shared<obs::FloatProperty>();
+		prop2->field_type = obs::NumberProperty::NumberType(obs_property_float_type(p));
+		prop2->minimum    = obs_property_float_min(p);
+		prop2->maximum    = obs_property_float_max(p);
+		prop2->step       = obs_property_float_step(p);
+		prop              = prop2;
+		break;
+	}
+	case OBS_PROPERTY_TEXT: {
+		auto prop2        = std::make_shared<obs::TextProperty>();
+		prop2->field_type = obs::TextProperty::TextType(obs_proprety_text_type(p));
+		prop              = prop2;
+		break;
+	}
+	case OBS_PROPERTY_PATH: {
+		auto prop2          = std::make_shared<obs::PathProperty>();
+		prop2->field_type   = obs::PathProperty::PathType(obs_property_path_type(p));
+		prop2->filter       = (buf = obs_property_path_filter(p)) != nullptr ? buf : "";
+		prop2->default_path = (buf = obs_property_path_default_path(p)) != nullptr ? buf : "";
+		prop                = prop2;
+		break;
+	}
+	case OBS_PROPERTY_LIST: {
+		auto prop2        = std::make_shared<obs::ListProperty>();
+		prop2->field_type = obs::ListProperty::ListType(obs_property_list_type(p));
+		prop2->format     = obs::ListProperty::Format(obs_property_list_format(p));
+		size_t items      = obs_property_list_item_count(p);
+		for (size_t idx = 0; idx < items; ++idx) {
+			obs::ListProperty::Item entry;
+			entry.name    = (buf = obs_property_list_item_name(p, idx)) != nullptr ? buf : "";
+			entry.enabled = !obs_property_list_item_disabled(p, idx);
+			switch (prop2->format) {
+			case obs::ListProperty::Format::Integer:
+				entry.value_int = obs_property_list_item_int(p, idx);
+				break;
+			case obs::ListProperty::Format::Float:
+				entry.value_float = obs_property_list_item_float(p, idx);
+				break;
+			case obs::ListProperty::Format::String:
+				entry.value_string = (buf = obs_property_list_item_string(p, idx)) != nullptr ? buf : "";
+				break;
+			}
+			prop2->items.push_back(std::move(entry));
+		}
+		prop = prop2;
+		break;
+	}
+	case OBS_PROPERTY_COLOR:
+		prop = std::make_shared<obs::ColorProperty>();
+		break;
+	case OBS_PROPERTY_BUTTON:
+		prop = std::make_shared<obs::ButtonProperty>();
+		break;
+	case OBS_PROPERTY_FONT:
+		prop = std::make_shared<obs::FontProperty>();
+		break;
+	case OBS_PROPERTY_EDITABLE_LIST: {
+		auto prop2          = std::make_shared<obs::EditableListProperty>();
+		prop2->field_type   = obs::EditableListProperty::ListType(obs_property_editable_list_type(p));
+		prop2->filter       = (buf = obs_property_editable_list_filter(p)) != nullptr ? buf : "";
+		prop2->default_path = (buf = obs_property_editable_list_default_path(p)) != nullptr ? buf : "";
+		prop                = prop2;
+		break;
+	}
+	case OBS_PROPERTY_FRAME_RATE: {
+		auto   prop2      = std::make_shared<obs::FrameRateProperty>();
+		size_t num_ranges = obs_property_frame_rate_fps_ranges_count(p);
+		for (size_t idx = 0; idx < num_ranges; idx++) {
+			auto min = obs_property_frame_rate_fps_range_min(p, idx),
+			     max = obs_property_frame_rate_fps_range_max(p, idx);
+
+			obs::FrameRateProperty::Range range;
+			range.minimum.first  = min.numerator;
+			range.minimum.second = min.denominator;
+			range.maximum.first  = max.numerator;
+			range.maximum.second = max.denominator;
+
+			prop2->ranges.push_back(std::move(range));
+		}
+
+		size_t num_options = obs_property_frame_rate_options_count(p);
+		for (size_t idx = 0; idx < num_options; idx++) {
+			auto min = obs_property_frame_rate_fps_range_min(p, idx),
+			     max = obs_property_frame_rate_fps_range_max(p, idx);
+
+			obs::FrameRateProperty::Option option;
+			option.name        = (buf = obs_property_frame_rate_option_name(p, idx)) != nullptr ? buf : "";
+			option.description = (buf = obs_property_frame_rate_option_description(p, idx)) != nullptr ? buf : "";
+
+			prop2->options.push_back(std::move(option));
+		}
+
+		prop = prop2;
+		break;
+	}
+	}
+
+	if (!prop) {
+		return nullptr;
+	}
+
+	prop->name             = obs_property_name(p);
+	prop->description      = obs_property_description(p) ? obs_property_description(p) : "";
+	prop->long_description = obs_property_long_description(p) ? obs_property_long_description(p) : "";
+	prop->enabled          = obs_property_enabled(p);
+	prop->visible          = obs_property_visible(p);
+	return prop;
+}
+
+void osn::Properties::Serialize(obs_properties_t* props, std::vector<ipc::value>& rval)
+{
+	for (obs_property_t* p = obs_properties_first(props); (p != nullptr); obs_property_next(&p)) {
+		std::shared_ptr<obs::Property> prop = Convert(p);
+		if (!prop)
+			continue;
+
+		std::vector<char> buf(prop->size());
+		if (prop->serialize(buf)) {
+			rval.push_back(ipc::value(buf));
+		}
+	}
+}
+
+static uint64_t fnv1a(const char* data, size_t size, uint64_t hash = 14695981039346656037ull)
+{
+	for (size_t idx = 0; idx < size; idx++) {
+		hash ^= uint8_t(data[idx]);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+// Hashes the settings that can change the layout: the values of every property
+//  except free-form ones (text, paths, editable lists), which hold per-instance
+//  data such as URLs and file names and would otherwise defeat the cache.
+static uint64_t LayoutSettingsHash(obs_data_t* settings, obs_properties_t* props)
+{
+	uint64_t hash = fnv1a(nullptr, 0);
+	for (obs_property_t* p = obs_properties_first(props); (p != nullptr); obs_property_next(&p)) {
+		switch (obs_property_get_type(p)) {
+		case OBS_PROPERTY_TEXT:
+		case OBS_PROPERTY_PATH:
+		case OBS_PROPERTY_EDITABLE_LIST:
+		case OBS_PROPERTY_BUTTON:
+			continue;
+		default:
+			break;
+		}
+
+		const char* name = obs_property_name(p);
+		hash             = fnv1a(name, strlen(name) + 1, hash);
+
+		obs_data_item_t* item = obs_data_item_byname(settings, name);
+		if (!item)
+			continue;
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_STRING: {
+			const char* value = obs_data_item_get_string(item);
+			hash              = fnv1a(value, strlen(value), hash);
+			break;
+		}
+		case OBS_DATA_NUMBER: {
+			double value = obs_data_item_get_double(item);
+			hash         = fnv1a(reinterpret_cast<const char*>(&value), sizeof(value), hash);
+			break;
+		}
+		case OBS_DATA_BOOLEAN: {
+			char value = obs_data_item_get_bool(item) ? 1 : 0;
+			hash       = fnv1a(&value, sizeof(value), hash);
+			break;
+		}
+		case OBS_DATA_OBJECT: {
+			obs_data_t* obj  = obs_data_item_get_obj(item);
+			const char* json = obj ? obs_data_get_json(obj) : "";
+			hash             = fnv1a(json, strlen(json), hash);
+			if (obj)
+				obs_data_release(obj);
+			break;
+		}
+		default:
+			break;
+		}
+		obs_data_item_release(&item);
+	}
+	return hash;
+}
+
+std::vector<char> osn::Properties::SerializeProperty(obs_properties_t* props, const std::string& name)
+{
+	std::shared_ptr<obs::Property> prop = Convert(obs_properties_get(props, name.c_str()));
+	std::vector<char>              buf(prop ? prop->size() : 0);
+	if (!prop || !prop->serialize(buf))
+		buf.clear();
+	return buf;
+}
+
+std::shared_ptr<osn::Properties::Schema> osn::Properties::GetSchema(obs_source_t* source, obs_properties_t* props)
+{
+	// The layout only depends on the type and on the settings that the
+	//  modified callbacks looked at, so both together identify a schema.
+	obs_data_t* settings = obs_source_get_settings(source);
+	schema_key  key(obs_source_get_id(source), LayoutSettingsHash(settings, props));
+	obs_data_release(settings);
+
+	{
+		std::unique_lock<std::mutex> ul(schemas_lock);
+		auto                         iter = schemas.find(key);
+		if (iter != schemas.end())
+			return iter->second;
+	}
+
+	std::shared_ptr<Schema> schema = std::make_shared<Schema>();
+	schema->id                     = fnv1a(nullptr, 0);
+	for (obs_property_t* p = obs_properties_first(props); (p != nullptr); obs_property_next(&p)) {
+		std::shared_ptr<obs::Property> prop = Convert(p);
+		if (!prop)
+			continue;
+
+		std::vector<char> buf(prop->size());
+		if (!prop->serialize(buf))
+			continue;
+
+		if (prop->type() == obs::Property::Type::List) {
+			// Hash the list without its items, they are sent fresh every time.
+			std::static_pointer_cast<obs::ListProperty>(prop)->items.clear();
+			std::vector<char> layout(prop->size());
+			if (prop->serialize(layout))
+				schema->id = fnv1a(layout.data(), layout.size(), schema->id);
+			schema->lists.push_back(prop->name);
+			schema->list_slots.push_back(schema->properties.size());
+		} else {
+			schema->id = fnv1a(buf.data(), buf.size(), schema->id);
+		}
+		schema->properties.push_back(std::move(buf));
+	}
+
+	std::unique_lock<std::mutex> ul(schemas_lock);
+	if (schemas.size() >= SCHEMA_CACHE_LIMIT)
+		schemas.clear();
+	schemas.emplace(key, schema);
+	return schema;
+}
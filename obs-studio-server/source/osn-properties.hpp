@@ -17,14 +17,49 @@
 
 #pragma once
 #include <ipc-server.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <obs.h>
+#include <string>
+#include <vector>
+
+namespace obs
+{
+	struct Property;
+}
 
 namespace osn
 {
 	class Properties
 	{
+		public:
+		// Serialized properties of a source type for one set of layout driving
+		//  settings. List items are not part of it: they can change at any time
+		//  (devices, windows) and are serialized again whenever sent, so the id
+		//  only changes with the layout itself.
+		struct Schema
+		{
+			uint64_t                       id;
+			std::vector<std::vector<char>> properties;
+			std::vector<std::string>       lists;
+			std::vector<size_t>            list_slots; // Index into 'properties' per entry of 'lists'.
+		};
+
+		private:
+		typedef std::pair<std::string, uint64_t> schema_key;
+
+		static std::map<schema_key, std::shared_ptr<Schema>> schemas;
+		static std::mutex                                    schemas_lock;
+
 		public:
 		static void Register(ipc::server& srv);
 
+		static std::shared_ptr<obs::Property> Convert(obs_property_t* p);
+		static void                           Serialize(obs_properties_t* props, std::vector<ipc::value>& rval);
+		static std::shared_ptr<Schema>        GetSchema(obs_source_t* source, obs_properties_t* props);
+		static std::vector<char>              SerializeProperty(obs_properties_t* props, const std::string& name);
+
 		static void
 		    Modified(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
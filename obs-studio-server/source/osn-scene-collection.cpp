@@ -0,0 +1,294 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-scene-collection.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <obs.h>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include "error.hpp"
+#include "ipc-batch.hpp"
+#include "nodeobs_api.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-sceneitem.hpp"
+#include "osn-settings-delta.hpp"
+#include "osn-source.hpp"
+#include "scene-collection-map.hpp"
+#include "shared.hpp"
+
+static double ElapsedMs(std::chrono::steady_clock::time_point& since)
+{
+	auto   now = std::chrono::steady_clock::now();
+	double ms  = std::chrono::duration<double, std::milli>(now - since).count();
+	since      = now;
+	return ms;
+}
+
+// Types whose create callbacks were checked to be safe on several threads at
+//  once, anything else is created on the IPC thread. A source only goes to the
+//  pool if its own type and the types of all its filters are listed here.
+static const std::set<std::string> reentrant_types = {
+    "color_source",
+    "image_source",
+    "ffmpeg_source",
+    "text_gdiplus",
+    "text_ft2_source",
+    "crop_filter",
+    "scale_filter",
+    "color_filter",
+    "mask_filter",
+    "sharpness_filter",
+    "scroll_filter",
+    "gain_filter",
+};
+
+// Upper bound for the thread count a caller can ask for.
+static const uint32_t max_load_threads = 8;
+
+static bool CanCreateInParallel(obs_data_t* source_data)
+{
+	if (!reentrant_types.count(obs_data_get_string(source_data, "id")))
+		return false;
+
+	bool              reentrant = true;
+	obs_data_array_t* filters   = obs_data_get_array(source_data, "filters");
+	for (size_t idx = 0; reentrant && idx < obs_data_array_count(filters); idx++) {
+		obs_data_t* filter_data = obs_data_array_item(filters, idx);
+		reentrant               = reentrant_types.count(obs_data_get_string(filter_data, "id")) != 0;
+		obs_data_release(filter_data);
+	}
+	obs_data_array_release(filters);
+	return reentrant;
+}
+
+struct IdMap
+{
+	std::vector<char>                     sources;
+	std::vector<osn::SceneCollectionItem> items;
+	uint32_t                              source_count = 0;
+	uint64_t                              scene_uid    = UINT64_MAX;
+};
+
+static void MapSource(IdMap& map, obs_source_t* source, uint64_t parent_uid)
+{
+	const char* name = obs_source_get_name(source);
+
+	osn::SceneCollectionSource record;
+	record.uid        = osn::Source::Manager::GetInstance().find(source);
+	record.parent_uid = parent_uid;
+	record.type       = uint32_t(obs_source_get_type(source));
+	record.name_size  = uint32_t(name ? strlen(name) : 0);
+
+	osn::batch::writer w(map.sources);
+	w.put(&record, sizeof(record));
+	w.put(name, record.name_size);
+	map.source_count++;
+}
+
+void osn::SceneCollection::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("SceneCollection");
+	cls->register_function(osn::CallStats::Function(cls, "Load", std::vector<ipc::type>{ipc::type::String}, Load));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Load", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32}, Load));
+	cls->register_function(osn::CallStats::Function(cls, "Save", std::vector<ipc::type>{}, Save));
+	osn::Batch::RegisterCollection(srv, cls);
+}
+
+void osn::SceneCollection::Load(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto clock = std::chrono::steady_clock::now();
+
+	obs_data_t* root = obs_data_create_from_json(args[0].value_str.c_str());
+	if (!root) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Scene collection is not valid JSON."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	obs_data_array_t* array = obs_data_get_array(root, "sources");
+	obs_data_release(root);
+	if (!array) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Scene collection has no sources."));
+		AUTO_DEBUG;
+		return;
+	}
+	double parse_ms = ElapsedMs(clock);
+
+	// Same two passes as obs_load_sources, but the references are kept for
+	//  the client instead of being dropped at the end.
+	//
+	// Filters are created along with their parent and scenes only resolve
+	//  their items by name once loaded, so apart from scenes nothing depends
+	//  on anything else at creation time. Sources of audited types are created
+	//  on a pool, the rest and then the scenes follow on this thread.
+	size_t                     count = obs_data_array_count(array);
+	std::vector<obs_source_t*> sources(count, nullptr);
+	std::vector<obs_data_t*>   source_datas(count, nullptr);
+	std::vector<size_t>        independent, serial, scenes;
+	for (size_t idx = 0; idx < count; idx++) {
+		source_datas[idx] = obs_data_array_item(array, idx);
+		const char* type  = obs_data_get_string(source_datas[idx], "id");
+		if ((strcmp(type, "scene") == 0) || (strcmp(type, "group") == 0))
+			scenes.push_back(idx);
+		else if (CanCreateInParallel(source_datas[idx]))
+			independent.push_back(idx);
+		else
+			serial.push_back(idx);
+
+		// Deferred modules are opened here, before any source gets created.
+		OBS_API::openModuleForType(type);
+		obs_data_array_t* filters = obs_data_get_array(source_datas[idx], "filters");
+		for (size_t filter = 0; filter < obs_data_array_count(filters); filter++) {
+			obs_data_t* filter_data = obs_data_array_item(filters, filter);
+			OBS_API::openModuleForType(obs_data_get_string(filter_data, "id"));
+			obs_data_release(filter_data);
+		}
+		obs_data_array_release(filters);
+	}
+
+	uint32_t threads = (args.size() > 1) ? args[1].value_union.ui32 : 1;
+	threads          = std::min({threads, max_load_threads, std::max(std::thread::hardware_concurrency(), 1u)});
+	threads          = uint32_t(std::max<size_t>(std::min<size_t>(threads, independent.size()), 1));
+
+	std::atomic<size_t> next(0);
+	auto                create = [&]() {
+		std::shared_lock<std::shared_timed_mutex> creation(OBS_API::sourceCreationLock());
+		for (size_t job = next++; job < independent.size(); job = next++) {
+			size_t idx   = independent[job];
+			sources[idx] = obs_load_source(source_datas[idx]);
+		}
+	};
+	std::vector<std::thread> pool;
+	for (uint32_t idx = 1; idx < threads; idx++)
+		pool.emplace_back(create);
+	create();
+	for (std::thread& worker : pool)
+		worker.join();
+
+	for (size_t idx : serial)
+		sources[idx] = obs_load_source(source_datas[idx]);
+	for (size_t idx : scenes)
+		sources[idx] = obs_load_source(source_datas[idx]);
+	double create_ms = ElapsedMs(clock);
+
+	for (size_t idx = 0; idx < count; idx++) {
+		obs_source_t* source = sources[idx];
+		if (!source)
+			continue;
+
+		if (obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION)
+			obs_transition_load(source, source_datas[idx]);
+		obs_source_load(source);
+
+		auto load_filter = [](obs_source_t* parent, obs_source_t* filter, void* data) { obs_source_load(filter); };
+		obs_source_enum_filters(source, load_filter, nullptr);
+	}
+	for (obs_data_t* source_data : source_datas)
+		obs_data_release(source_data);
+	obs_data_array_release(array);
+	double load_ms = ElapsedMs(clock);
+
+	IdMap map;
+	for (obs_source_t* source : sources) {
+		if (!source)
+			continue;
+
+		uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+		MapSource(map, source, UINT64_MAX);
+
+		auto map_filter = [](obs_source_t* parent, obs_source_t* filter, void* data) {
+			IdMap* map = reinterpret_cast<IdMap*>(data);
+			MapSource(*map, filter, osn::Source::Manager::GetInstance().find(parent));
+		};
+		obs_source_enum_filters(source, map_filter, &map);
+
+		obs_scene_t* scene = obs_scene_from_source(source);
+		if (!scene)
+			continue;
+
+		map.scene_uid = uid;
+		auto map_item = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
+			IdMap* map = reinterpret_cast<IdMap*>(data);
+
+			osn::SceneCollectionItem record;
+			record.uid        = osn::SceneItem::Manager::GetInstance().lease(item);
+			record.scene_uid  = map->scene_uid;
+			record.source_uid = osn::Source::Manager::GetInstance().find(obs_sceneitem_get_source(item));
+			record.item_id    = obs_sceneitem_get_id(item);
+			map->items.push_back(record);
+			return true;
+		};
+		obs_scene_enum_items(scene, map_item, &map);
+	}
+
+	std::vector<char>  buffer;
+	osn::batch::writer w(buffer);
+	w.put_u32(map.source_count);
+	w.put(map.sources.data(), map.sources.size());
+	w.put_u32(uint32_t(map.items.size()));
+	w.put(map.items.data(), map.items.size() * sizeof(osn::SceneCollectionItem));
+	double map_ms = ElapsedMs(clock);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buffer));
+	rval.push_back(ipc::value(parse_ms));
+	rval.push_back(ipc::value(create_ms));
+	rval.push_back(ipc::value(load_ms));
+	rval.push_back(ipc::value(map_ms));
+	rval.push_back(ipc::value(threads));
+	AUTO_DEBUG;
+}
+
+void osn::SceneCollection::Save(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto clock = std::chrono::steady_clock::now();
+
+	// Every public source with its filters; scenes carry their items.
+	osn::SettingsDelta::FlushAll();
+	obs_data_array_t* array = obs_save_sources();
+	obs_data_t*       root  = obs_data_create();
+	obs_data_set_array(root, "sources", array);
+	obs_data_array_release(array);
+	double collect_ms = ElapsedMs(clock);
+
+	std::string json = obs_data_get_json(root);
+	obs_data_release(root);
+	double serialize_ms = ElapsedMs(clock);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(json));
+	rval.push_back(ipc::value(collect_ms));
+	rval.push_back(ipc::value(serialize_ms));
+	AUTO_DEBUG;
+}
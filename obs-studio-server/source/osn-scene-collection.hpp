@@ -0,0 +1,43 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <ipc-server.hpp>
+#include <vector>
+
+namespace osn
+{
+	// Loads and saves a whole scene collection in one call, instead of one
+	//  call per source, filter, scene and scene item.
+	class SceneCollection
+	{
+		public:
+		static void Register(ipc::server&);
+
+		// Creates every source of a collection first and loads them afterwards,
+		//  so that scenes can resolve their items by name. The caller owns one
+		//  reference to every top level source, exactly as after Input.Create.
+		//  Inputs of audited types and their filters are created on up to as
+		//  many threads as the optional second argument asks for, capped at
+		//  the core count and at 8. Without it, or with 0 or 1, everything is
+		//  created on the calling thread.
+		static void
+		    Load(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void
+		    Save(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+	};
+} // namespace osn
@@ -1,51 +1,64 @@
 #include "osn-scene.hpp"
+#include <cstring>
 #include <list>
 #include "error.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-sceneitem.hpp"
+#include "osn-settings-delta.hpp"
+#include "sceneitem-transform.hpp"
 #include "shared.hpp"
 
 void osn::Scene::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Scene");
+	cls->register_function(osn::CallStats::Function(cls, "Create", std::vector<ipc::type>{ipc::type::String}, Create));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::String}, Create));
+	    osn::CallStats::Function(cls, "CreatePrivate", std::vector<ipc::type>{ipc::type::String}, CreatePrivate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("CreatePrivate", std::vector<ipc::type>{ipc::type::String}, CreatePrivate));
-	cls->register_function(
-	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
+	    osn::CallStats::Function(cls, "FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
-	cls->register_function(
-	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
+	    osn::CallStats::Function(cls, "Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
+	cls->register_function(osn::CallStats::Function(cls, "Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("AsSource", std::vector<ipc::type>{ipc::type::UInt64}, AsSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
-
-	cls->register_function(std::make_shared<ipc::function>(
-	    "AddSource", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddSource));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindItemByName));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, FindItemByItemId));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "MoveItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32}, MoveItem));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetItem));
+	    osn::CallStats::Function(cls, "AsSource", std::vector<ipc::type>{ipc::type::UInt64}, AsSource));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Duplicate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32}, Duplicate));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "DuplicateWithItems",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::Int32},
+	    DuplicateWithItems));
+
+	cls->register_function(osn::CallStats::Function(
+	    cls, "AddSource", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, AddSource));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindItemByName));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "FindItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, FindItemByItemId));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "MoveItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32}, MoveItem));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "GetItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetItem));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetItems", std::vector<ipc::type>{ipc::type::UInt64}, GetItems));
-	cls->register_function(std::make_shared<ipc::function>(
+	    osn::CallStats::Function(cls, "GetItems", std::vector<ipc::type>{ipc::type::UInt64}, GetItems));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "GetItemsInRange",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32},
 	    GetItemsInRange));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetItemsTransforms", std::vector<ipc::type>{ipc::type::UInt64}, GetItemsTransforms));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetItemsTransforms", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, SetItemsTransforms));
 
 	cls->register_function(
-	    std::make_shared<ipc::function>("Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
+	    osn::CallStats::Function(cls, "Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Disconnect", std::vector<ipc::type>{ipc::type::UInt64}, Disconnect));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "Disconnect", std::vector<ipc::type>{ipc::type::UInt64}, Disconnect));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Scene::Create(
@@ -187,8 +200,9 @@ void osn::Scene::Release(
 	if (obs_source_removed(source)) {
 		osn::Source::Manager::GetInstance().free(args[0].value_union.ui64);
 		for (auto item : items) {
-			osn::SceneItem::Manager::GetInstance().free(item);
-			obs_sceneitem_release(item);
+			if (osn::SceneItem::Manager::GetInstance().revoke(item) != UINT64_MAX) {
+				obs_sceneitem_release(item);
+			}
 		}
 	}
 
@@ -235,8 +249,9 @@ void osn::Scene::Remove(
 	osn::Source::Manager::GetInstance().free(args[0].value_union.ui64);
 
 	for (auto item : items) {
-		osn::SceneItem::Manager::GetInstance().free(item);
-		obs_sceneitem_release(item);
+		if (osn::SceneItem::Manager::GetInstance().revoke(item) != UINT64_MAX) {
+			obs_sceneitem_release(item);
+		}
 		obs_sceneitem_release(item);
 	}
 
@@ -256,47 +271,143 @@ void osn::Scene::AsSource(
 	AUTO_DEBUG;
 }
 
-void osn::Scene::Duplicate(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
+// Leases every item of the scene and packs its transform into 'buffer', in
+//  scene order. On failure the leases taken by this call are handed back.
+static bool PackItemTransforms(obs_scene_t* scene, std::vector<char>& buffer)
+{
+	std::list<obs_sceneitem_t*> items;
+	auto                        cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
+        std::list<obs_sceneitem_t*>* items = reinterpret_cast<std::list<obs_sceneitem_t*>*>(data);
+        items->push_back(item);
+        return true;
+	};
+	obs_scene_enum_items(scene, cb, &items);
+
+	buffer.assign(items.size() * sizeof(osn::SceneItemTransform), 0);
+	osn::SceneItemTransform* record = reinterpret_cast<osn::SceneItemTransform*>(buffer.data());
+	for (obs_sceneitem_t* item : items) {
+		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(item);
+		if (uid == UINT64_MAX) {
+			osn::SceneItemTransform* first = reinterpret_cast<osn::SceneItemTransform*>(buffer.data());
+			for (; first != record; first++)
+				osn::SceneItem::Manager::GetInstance().release(first->uid);
+			buffer.clear();
+			return false;
+		}
+
+		obs_transform_info tf;
+		obs_sceneitem_get_info(item, &tf);
+		obs_sceneitem_crop crop;
+		obs_sceneitem_get_crop(item, &crop);
+
+		*record                  = {};
+		record->uid              = uid;
+		record->item_id          = obs_sceneitem_get_id(item);
+		record->pos_x            = tf.pos.x;
+		record->pos_y            = tf.pos.y;
+		record->rot              = tf.rot;
+		record->scale_x          = tf.scale.x;
+		record->scale_y          = tf.scale.y;
+		record->alignment        = tf.alignment;
+		record->bounds_type      = uint32_t(tf.bounds_type);
+		record->bounds_alignment = tf.bounds_alignment;
+		record->bounds_x         = tf.bounds.x;
+		record->bounds_y         = tf.bounds.y;
+		record->crop_left        = crop.left;
+		record->crop_top         = crop.top;
+		record->crop_right       = crop.right;
+		record->crop_bottom      = crop.bottom;
+		record->visible          = obs_sceneitem_visible(item) ? 1 : 0;
+		record->selected         = obs_sceneitem_selected(item) ? 1 : 0;
+		record++;
+	}
+	return true;
+}
+
+// Common part of Duplicate and DuplicateWithItems: duplicates the scene in
+//  args[0] with the name and type in args[1] and args[2] and indexes the copy.
+//  On failure the error is already in 'rval' and nullptr is returned.
+static obs_source_t* DuplicateScene(const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 {
 	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
 		rval.push_back(ipc::value("Source reference is not valid."));
-		AUTO_DEBUG;
-		return;
+		return nullptr;
 	}
 
 	obs_scene_t* scene = obs_scene_from_source(source);
 	if (!scene) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
 		rval.push_back(ipc::value("Source reference is not a scene."));
-		AUTO_DEBUG;
-		return;
+		return nullptr;
 	}
 
+	// Copies take the current settings of every item source and their filters.
+	osn::SettingsDelta::FlushAll();
 	obs_scene_t* scene2 =
 	    obs_scene_duplicate(scene, args[1].value_str.c_str(), (obs_scene_duplicate_type)args[2].value_union.i32);
 	if (!scene2) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
 		rval.push_back(ipc::value("Failed to duplicate scene."));
-		AUTO_DEBUG;
-		return;
+		return nullptr;
 	}
 
 	obs_source_t* source2 = obs_scene_get_source(scene2);
 	if (!source2) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
 		rval.push_back(ipc::value("Failed to get source from duplicate scene."));
+		return nullptr;
+	}
+
+	// Already indexed by the create signal, this only looks up its id.
+	if (osn::Source::Manager::GetInstance().allocate(source2) == UINT64_MAX) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+		rval.push_back(ipc::value("Index list is full."));
+		return nullptr;
+	}
+	return source2;
+}
+
+void osn::Scene::Duplicate(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source2 = DuplicateScene(args, rval);
+	if (!source2) {
 		AUTO_DEBUG;
 		return;
 	}
 
-	uint64_t uid = osn::Source::Manager::GetInstance().allocate(source2);
-	if (uid == UINT64_MAX) {
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::Source::Manager::GetInstance().find(source2)));
+	AUTO_DEBUG;
+}
+
+void osn::Scene::DuplicateWithItems(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// With OBS_SCENE_DUP_REFS the new items share their sources with the
+	//  original, so nothing is copied beyond the items themselves. Their
+	//  transforms are read once here and the client only writes back the
+	//  ones it actually changes.
+	obs_source_t* source2 = DuplicateScene(args, rval);
+	if (!source2) {
+		AUTO_DEBUG;
+		return;
+	}
+
+	std::vector<char> buffer;
+	if (!PackItemTransforms(obs_scene_from_source(source2), buffer)) {
+		// The destroy signal would do the same, but only once the last reference is gone.
+		osn::Source::Manager::GetInstance().free(source2);
+		obs_source_remove(source2);
+		obs_source_release(source2);
 		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
 		rval.push_back(ipc::value("Index list is full."));
 		AUTO_DEBUG;
@@ -304,7 +415,8 @@ void osn::Scene::Duplicate(
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(uid));
+	rval.push_back(ipc::value(osn::Source::Manager::GetInstance().find(source2)));
+	rval.push_back(ipc::value(buffer));
 	AUTO_DEBUG;
 }
 
@@ -340,14 +452,13 @@ void osn::Scene::AddSource(
 
 	obs_sceneitem_t* item = obs_scene_add(scene, added_source);
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(item);
 	if (uid == UINT64_MAX) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
 		rval.push_back(ipc::value("Index list is full."));
 		AUTO_DEBUG;
 		return;
 	}
-	obs_sceneitem_addref(item);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value((uint64_t)uid));
@@ -384,16 +495,12 @@ void osn::Scene::FindItemByName(
 		return;
 	}
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(item);
 	if (uid == UINT64_MAX) {
-		uid = osn::SceneItem::Manager::GetInstance().allocate(item);
-		if (uid == UINT64_MAX) {
-			rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
-			rval.push_back(ipc::value("Index list is full."));
-			AUTO_DEBUG;
-			return;
-		}
-		obs_sceneitem_addref(item);
+		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+		rval.push_back(ipc::value("Index list is full."));
+		AUTO_DEBUG;
+		return;
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -431,16 +538,12 @@ void osn::Scene::FindItemByItemId(
 		return;
 	}
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(item);
 	if (uid == UINT64_MAX) {
-		uid = osn::SceneItem::Manager::GetInstance().allocate(item);
-		if (uid == UINT64_MAX) {
-			rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
-			rval.push_back(ipc::value("Index list is full."));
-			AUTO_DEBUG;
-			return;
-		}
-		obs_sceneitem_addref(item);
+		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+		rval.push_back(ipc::value("Index list is full."));
+		AUTO_DEBUG;
+		return;
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -563,16 +666,12 @@ void osn::Scene::GetItem(
 		return;
 	}
 
-	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(ed.item);
+	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(ed.item);
 	if (uid == UINT64_MAX) {
-		uid = osn::SceneItem::Manager::GetInstance().allocate(ed.item);
-		if (uid == UINT64_MAX) {
-			rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
-			rval.push_back(ipc::value("Index list is full."));
-			AUTO_DEBUG;
-			return;
-		}
-		obs_sceneitem_addref(ed.item);
+		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+		rval.push_back(ipc::value("Index list is full."));
+		AUTO_DEBUG;
+		return;
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -612,16 +711,12 @@ void osn::Scene::GetItems(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	for (obs_sceneitem_t* item : items) {
-		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(item);
 		if (uid == UINT64_MAX) {
-			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
-			if (uid == UINT64_MAX) {
-				rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
-				rval.push_back(ipc::value("Index list is full."));
-				AUTO_DEBUG;
-				return;
-			}
-			obs_sceneitem_addref(item);
+			rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+			rval.push_back(ipc::value("Index list is full."));
+			AUTO_DEBUG;
+			return;
 		}
 		rval.push_back(ipc::value((uint64_t)uid));
 	}
@@ -673,22 +768,141 @@ void osn::Scene::GetItemsInRange(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	for (obs_sceneitem_t* item : ed.items) {
-		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().lease(item);
 		if (uid == UINT64_MAX) {
-			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
-			if (uid == UINT64_MAX) {
-				rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
-				rval.push_back(ipc::value("Index list is full."));
-				AUTO_DEBUG;
-				return;
-			}
-			obs_sceneitem_addref(item);
+			rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+			rval.push_back(ipc::value("Index list is full."));
+			AUTO_DEBUG;
+			return;
 		}
 		rval.push_back(ipc::value((uint64_t)uid));
 	}
 	AUTO_DEBUG;
 }
 
+void osn::Scene::GetItemsTransforms(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	obs_scene_t* scene = obs_scene_from_source(source);
+	if (!scene) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not a scene."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	std::vector<char> buffer;
+	if (!PackItemTransforms(scene, buffer)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::CriticalError));
+		rval.push_back(ipc::value("Index list is full."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buffer));
+	AUTO_DEBUG;
+}
+
+void osn::Scene::SetItemsTransforms(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	obs_scene_t* scene = obs_scene_from_source(source);
+	if (!scene) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not a scene."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	const std::vector<char>& buffer = args[1].value_bin;
+	if (buffer.size() % sizeof(osn::SceneItemTransform) != 0) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Transform buffer has an invalid size."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	// Resolve everything up front so that a bad reference rejects the whole
+	//  batch instead of leaving the scene half updated.
+	size_t count = buffer.size() / sizeof(osn::SceneItemTransform);
+	std::vector<std::pair<obs_sceneitem_t*, osn::SceneItemTransform>> batch(count);
+	for (size_t idx = 0; idx < count; idx++) {
+		osn::SceneItemTransform& record = batch[idx].second;
+		std::memcpy(&record, buffer.data() + idx * sizeof(osn::SceneItemTransform), sizeof(osn::SceneItemTransform));
+
+		obs_sceneitem_t* item = osn::SceneItem::Manager::GetInstance().find(record.uid);
+		if (!item || (obs_sceneitem_get_scene(item) != scene)) {
+			rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+			rval.push_back(ipc::value("Item reference is not valid or not part of this scene."));
+			AUTO_DEBUG;
+			return;
+		}
+		batch[idx].first = item;
+	}
+
+	for (auto& entry : batch) {
+		obs_sceneitem_defer_update_begin(entry.first);
+	}
+
+	for (auto& entry : batch) {
+		const osn::SceneItemTransform& record = entry.second;
+
+		obs_transform_info tf;
+		tf.pos.x            = record.pos_x;
+		tf.pos.y            = record.pos_y;
+		tf.rot              = record.rot;
+		tf.scale.x          = record.scale_x;
+		tf.scale.y          = record.scale_y;
+		tf.alignment        = record.alignment;
+		tf.bounds_type      = (obs_bounds_type)record.bounds_type;
+		tf.bounds_alignment = record.bounds_alignment;
+		tf.bounds.x         = record.bounds_x;
+		tf.bounds.y         = record.bounds_y;
+		obs_sceneitem_set_info(entry.first, &tf);
+
+		obs_sceneitem_crop crop;
+		crop.left   = record.crop_left;
+		crop.top    = record.crop_top;
+		crop.right  = record.crop_right;
+		crop.bottom = record.crop_bottom;
+		obs_sceneitem_set_crop(entry.first, &crop);
+
+		obs_sceneitem_set_visible(entry.first, record.visible != 0);
+		obs_sceneitem_select(entry.first, record.selected != 0);
+	}
+
+	for (auto& entry : batch) {
+		obs_sceneitem_defer_update_end(entry.first);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint64_t)count));
+	AUTO_DEBUG;
+}
+
 void osn::Scene::Connect(
     void*                          data,
     const int64_t                  id,
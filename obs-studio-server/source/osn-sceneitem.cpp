@@ -1,5 +1,8 @@
 #include "osn-sceneitem.hpp"
+#include <cstring>
 #include <error.hpp>
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -7,74 +10,80 @@ void osn::SceneItem::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("SceneItem");
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSource", std::vector<ipc::type>{ipc::type::UInt64}, GetSource));
+	    osn::CallStats::Function(cls, "GetSource", std::vector<ipc::type>{ipc::type::UInt64}, GetSource));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetScene", std::vector<ipc::type>{ipc::type::UInt64}, GetScene));
+	    osn::CallStats::Function(cls, "GetScene", std::vector<ipc::type>{ipc::type::UInt64}, GetScene));
+	cls->register_function(osn::CallStats::Function(cls, "Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
+	    osn::CallStats::Function(cls, "ReleaseLeases", std::vector<ipc::type>{ipc::type::Binary}, ReleaseLeases));
 	cls->register_function(
-	    std::make_shared<ipc::function>("IsVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsVisible));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetVisible));
+	    osn::CallStats::Function(cls, "GetLeaseCounters", std::vector<ipc::type>{}, GetLeaseCounters));
 	cls->register_function(
-	    std::make_shared<ipc::function>("IsSelected", std::vector<ipc::type>{ipc::type::UInt64}, IsSelected));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetSelected", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetSelected));
+	    osn::CallStats::Function(cls, "IsVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsVisible));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetVisible));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetPosition", std::vector<ipc::type>{ipc::type::UInt64}, GetPosition));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetPosition", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetPosition));
+	    osn::CallStats::Function(cls, "IsSelected", std::vector<ipc::type>{ipc::type::UInt64}, IsSelected));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetSelected", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetSelected));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetRotation", std::vector<ipc::type>{ipc::type::UInt64}, GetRotation));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetRotation", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetRotation));
+	    osn::CallStats::Function(cls, "GetPosition", std::vector<ipc::type>{ipc::type::UInt64}, GetPosition));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
+	    "SetPosition",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float},
+	    SetPosition));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetScale", std::vector<ipc::type>{ipc::type::UInt64}, GetScale));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetScale", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetScale));
+	    osn::CallStats::Function(cls, "GetRotation", std::vector<ipc::type>{ipc::type::UInt64}, GetRotation));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetRotation", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetRotation));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64}, GetScaleFilter));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetScaleFilter));
+	    osn::CallStats::Function(cls, "GetScale", std::vector<ipc::type>{ipc::type::UInt64}, GetScale));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetScale", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetScale));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetAlignment));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAlignment));
+	    osn::CallStats::Function(cls, "GetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64}, GetScaleFilter));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetScaleFilter));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetBounds", std::vector<ipc::type>{ipc::type::UInt64}, GetBounds));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetBounds", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetBounds));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsAlignment));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBoundsAlignment));
+	    osn::CallStats::Function(cls, "GetAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetAlignment));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAlignment));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetBoundsType", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsType));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetBoundsType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetBoundsType));
+	    osn::CallStats::Function(cls, "GetBounds", std::vector<ipc::type>{ipc::type::UInt64}, GetBounds));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetBounds", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetBounds));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsAlignment));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBoundsAlignment));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetCrop", std::vector<ipc::type>{ipc::type::UInt64}, GetCrop));
-	cls->register_function(std::make_shared<ipc::function>(
+	    osn::CallStats::Function(cls, "GetBoundsType", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsType));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetBoundsType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetBoundsType));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "GetCrop", std::vector<ipc::type>{ipc::type::UInt64}, GetCrop));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "SetCrop",
 	    std::vector<ipc::type>{
 	        ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32},
 	    SetCrop));
-	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
+	cls->register_function(osn::CallStats::Function(cls, "GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
+	cls->register_function(osn::CallStats::Function(cls, "MoveUp", std::vector<ipc::type>{ipc::type::UInt64}, MoveUp));
 	cls->register_function(
-	    std::make_shared<ipc::function>("MoveUp", std::vector<ipc::type>{ipc::type::UInt64}, MoveUp));
+	    osn::CallStats::Function(cls, "MoveDown", std::vector<ipc::type>{ipc::type::UInt64}, MoveDown));
 	cls->register_function(
-	    std::make_shared<ipc::function>("MoveDown", std::vector<ipc::type>{ipc::type::UInt64}, MoveDown));
+	    osn::CallStats::Function(cls, "MoveTop", std::vector<ipc::type>{ipc::type::UInt64}, MoveTop));
 	cls->register_function(
-	    std::make_shared<ipc::function>("MoveTop", std::vector<ipc::type>{ipc::type::UInt64}, MoveTop));
+	    osn::CallStats::Function(cls, "MoveBottom", std::vector<ipc::type>{ipc::type::UInt64}, MoveBottom));
 	cls->register_function(
-	    std::make_shared<ipc::function>("MoveBottom", std::vector<ipc::type>{ipc::type::UInt64}, MoveBottom));
+	    osn::CallStats::Function(cls, "Move", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Move));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Move", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Move));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
+	    osn::CallStats::Function(cls, "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
 	cls->register_function(
-	    std::make_shared<ipc::function>("DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::SceneItem::GetSource(
@@ -155,7 +164,7 @@ void osn::SceneItem::Remove(
 		return;
 	}
 
-	osn::SceneItem::Manager::GetInstance().free(args[0].value_union.ui64);
+	osn::SceneItem::Manager::GetInstance().revoke(args[0].value_union.ui64);
 	obs_sceneitem_release(item);
 	obs_sceneitem_remove(item);
 
@@ -163,6 +172,55 @@ void osn::SceneItem::Remove(
 	AUTO_DEBUG;
 }
 
+void osn::SceneItem::ReleaseLeases(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	const std::vector<char>& buffer = args[0].value_bin;
+	if (buffer.size() % sizeof(uint64_t) != 0) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Lease buffer has an invalid size."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	// Stale ids are expected here (the item may have been removed before its
+	//  wrapper was collected), so they are counted instead of rejected.
+	uint64_t released = 0;
+	for (size_t offset = 0; offset < buffer.size(); offset += sizeof(uint64_t)) {
+		uint64_t uid;
+		std::memcpy(&uid, buffer.data() + offset, sizeof(uint64_t));
+		if (osn::SceneItem::Manager::GetInstance().release(uid)) {
+			released++;
+		}
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(released));
+	AUTO_DEBUG;
+}
+
+void osn::SceneItem::GetLeaseCounters(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	osn::SceneItem::Manager::Counters counters = osn::SceneItem::Manager::GetInstance().counters();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(counters.live));
+	rval.push_back(ipc::value(counters.outstanding));
+	rval.push_back(ipc::value(counters.granted));
+	rval.push_back(ipc::value(counters.returned));
+	rval.push_back(ipc::value(counters.recycled));
+	rval.push_back(ipc::value(counters.revoked));
+	rval.push_back(ipc::value(counters.stale));
+	AUTO_DEBUG;
+}
+
 void osn::SceneItem::IsVisible(
     void*                          data,
     const int64_t                  id,
@@ -821,3 +879,73 @@ osn::SceneItem::Manager& osn::SceneItem::Manager::GetInstance()
 	static Manager instance;
 	return instance;
 }
+
+utility::unique_id::id_t osn::SceneItem::Manager::lease(obs_sceneitem_t* item)
+{
+	utility::unique_id::id_t uid = find(item);
+	if (uid == utility::unique_id::invalid_id) {
+		uid = allocate(item);
+		if (uid == utility::unique_id::invalid_id) {
+			return uid;
+		}
+		obs_sceneitem_addref(item);
+	}
+
+	leases[uid]++;
+	totals.granted++;
+	return uid;
+}
+
+bool osn::SceneItem::Manager::release(utility::unique_id::id_t uid)
+{
+	auto iter = leases.find(uid);
+	if ((iter == leases.end()) || !find(uid)) {
+		totals.stale++;
+		return false;
+	}
+
+	totals.returned++;
+	if (--iter->second > 0) {
+		return true;
+	}
+
+	leases.erase(iter);
+	obs_sceneitem_t* item = free(uid);
+	obs_sceneitem_release(item);
+	totals.recycled++;
+	return true;
+}
+
+obs_sceneitem_t* osn::SceneItem::Manager::revoke(utility::unique_id::id_t uid)
+{
+	obs_sceneitem_t* item = free(uid);
+	if (!item) {
+		return nullptr;
+	}
+
+	auto iter = leases.find(uid);
+	if (iter != leases.end()) {
+		totals.revoked++;
+		leases.erase(iter);
+	}
+	return item;
+}
+
+utility::unique_id::id_t osn::SceneItem::Manager::revoke(obs_sceneitem_t* item)
+{
+	utility::unique_id::id_t uid = find(item);
+	if (uid != utility::unique_id::invalid_id) {
+		revoke(uid);
+	}
+	return uid;
+}
+
+osn::SceneItem::Manager::Counters osn::SceneItem::Manager::counters()
+{
+	Counters result = totals;
+	result.live     = id_generator.count(false);
+	for (auto& kv : leases) {
+		result.outstanding += kv.second;
+	}
+	return result;
+}
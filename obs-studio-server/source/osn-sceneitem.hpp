@@ -1,6 +1,7 @@
 #pragma once
 #include <ipc-server.hpp>
 #include <obs.h>
+#include <unordered_map>
 #include <utility.hpp>
 
 namespace osn
@@ -22,6 +23,34 @@ namespace osn
 
 			public:
 			static Manager& GetInstance();
+
+			// Ids handed to the client are leased: every wrapper the client
+			//  builds holds one lease, and the client returns them in batches
+			//  once V8 collects the wrappers. The first lease allocates the id
+			//  and takes a reference, the last one frees both again.
+			utility::unique_id::id_t lease(obs_sceneitem_t* item);
+			bool                     release(utility::unique_id::id_t uid);
+
+			// Frees an id regardless of outstanding leases, for items that
+			//  have left their scene. Late releases of it count as stale.
+			obs_sceneitem_t*         revoke(utility::unique_id::id_t uid);
+			utility::unique_id::id_t revoke(obs_sceneitem_t* item);
+
+			struct Counters
+			{
+				uint64_t live        = 0; // Ids currently allocated.
+				uint64_t outstanding = 0; // Leases held by the client right now.
+				uint64_t granted     = 0; // Leases handed out in total.
+				uint64_t returned    = 0; // Leases returned in total.
+				uint64_t recycled    = 0; // Ids freed by their last lease.
+				uint64_t revoked     = 0; // Ids freed while still leased.
+				uint64_t stale       = 0; // Releases for ids that no longer resolve.
+			};
+			Counters counters();
+
+			private:
+			std::unordered_map<utility::unique_id::id_t, uint32_t> leases;
+			Counters                                               totals;
 		};
 
 		public:
@@ -34,6 +63,16 @@ namespace osn
 
 		static void
 		    Remove(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void ReleaseLeases(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void GetLeaseCounters(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 
 		static void
 		            IsVisible(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
@@ -0,0 +1,208 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "osn-settings-delta.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct PendingDelta
+{
+	// Weak, so that a queued delta never keeps a released source alive.
+	obs_weak_source_t*                                 weak = nullptr;
+	std::map<std::string, osn::settings_delta::entry> entries;
+};
+
+// Lock order is queue_lock, then apply_lock. Holding apply_lock while
+//  applying keeps a Flush from reading settings the worker is still writing.
+static std::map<obs_source_t*, PendingDelta> queue;
+static std::mutex                            queue_lock;
+static std::mutex                            apply_lock;
+static std::condition_variable               worker_cv;
+static std::thread                           worker;
+static bool                                  worker_running = false;
+
+static std::chrono::nanoseconds FrameInterval()
+{
+	obs_video_info ovi;
+	if (!obs_get_video_info(&ovi) || (ovi.fps_num == 0))
+		return std::chrono::milliseconds(16);
+	return std::chrono::nanoseconds(uint64_t(1000000000ull) * ovi.fps_den / ovi.fps_num);
+}
+
+static void ApplyPending(PendingDelta& pending)
+{
+	obs_source_t* source = obs_weak_source_get_source(pending.weak);
+	obs_weak_source_release(pending.weak);
+	pending.weak = nullptr;
+	if (!source)
+		return;
+
+	obs_data_t* settings = obs_source_get_settings(source);
+	for (auto& kv : pending.entries)
+		osn::SettingsDelta::Apply(settings, kv.second);
+	obs_data_release(settings);
+
+	// The values are in the live settings already, without settings this only
+	//  runs the update callback (deferred to the video tick for video sources).
+	obs_source_update(source, nullptr);
+	obs_source_release(source);
+}
+
+static void WorkerThread()
+{
+	auto last = std::chrono::steady_clock::now() - FrameInterval();
+
+	std::unique_lock<std::mutex> ul(queue_lock);
+	while (worker_running) {
+		worker_cv.wait(ul, []() { return !worker_running || !queue.empty(); });
+		if (!worker_running)
+			break;
+
+		// The first delta after a quiet period goes out immediately, anything
+		//  arriving within the same frame is merged into the next flush.
+		worker_cv.wait_until(ul, last + FrameInterval(), []() { return !worker_running; });
+
+		std::map<obs_source_t*, PendingDelta> batch;
+		batch.swap(queue);
+		std::unique_lock<std::mutex> al(apply_lock);
+		ul.unlock();
+
+		for (auto& kv : batch)
+			ApplyPending(kv.second);
+		last = std::chrono::steady_clock::now();
+
+		al.unlock();
+		ul.lock();
+	}
+}
+
+void osn::SettingsDelta::Start()
+{
+	std::unique_lock<std::mutex> ul(queue_lock);
+	if (worker_running)
+		return;
+
+	worker_running = true;
+	worker         = std::thread(WorkerThread);
+}
+
+void osn::SettingsDelta::Stop()
+{
+	{
+		std::unique_lock<std::mutex> ul(queue_lock);
+		if (!worker_running)
+			return;
+		worker_running = false;
+	}
+	worker_cv.notify_all();
+	worker.join();
+
+	FlushAll();
+}
+
+void osn::SettingsDelta::Queue(obs_source_t* source, std::vector<settings_delta::entry>& entries)
+{
+	std::unique_lock<std::mutex> ul(queue_lock);
+	if (!worker_running) {
+		// Nothing would ever pick it up, so apply it on the spot.
+		PendingDelta pending;
+		pending.weak = obs_source_get_weak_source(source);
+		for (settings_delta::entry& entry : entries)
+			pending.entries[entry.key] = std::move(entry);
+		std::unique_lock<std::mutex> al(apply_lock);
+		ul.unlock();
+		ApplyPending(pending);
+		return;
+	}
+
+	PendingDelta& pending = queue[source];
+	if (pending.weak && !obs_weak_source_references_source(pending.weak, source)) {
+		// Left behind by a destroyed source whose address was reused.
+		obs_weak_source_release(pending.weak);
+		pending.weak = nullptr;
+		pending.entries.clear();
+	}
+	if (!pending.weak)
+		pending.weak = obs_source_get_weak_source(source);
+
+	// Later values of a key replace earlier ones, only the latest is applied.
+	for (settings_delta::entry& entry : entries)
+		pending.entries[entry.key] = std::move(entry);
+
+	ul.unlock();
+	worker_cv.notify_all();
+}
+
+void osn::SettingsDelta::Flush(obs_source_t* source)
+{
+	std::unique_lock<std::mutex> ul(queue_lock);
+	auto                         iter = queue.find(source);
+	if (iter == queue.end()) {
+		// The worker may be applying a batch that contains this source.
+		std::unique_lock<std::mutex> al(apply_lock);
+		return;
+	}
+
+	PendingDelta pending = std::move(iter->second);
+	queue.erase(iter);
+	std::unique_lock<std::mutex> al(apply_lock);
+	ul.unlock();
+	ApplyPending(pending);
+}
+
+void osn::SettingsDelta::FlushAll()
+{
+	std::unique_lock<std::mutex>          ul(queue_lock);
+	std::map<obs_source_t*, PendingDelta> batch;
+	batch.swap(queue);
+	std::unique_lock<std::mutex> al(apply_lock);
+	ul.unlock();
+
+	for (auto& kv : batch)
+		ApplyPending(kv.second);
+}
+
+void osn::SettingsDelta::Apply(obs_data_t* data, const settings_delta::entry& entry)
+{
+	const char* key = entry.key.c_str();
+	switch (entry.kind) {
+	case settings_delta::type::Int:
+		obs_data_set_int(data, key, entry.i);
+		break;
+	case settings_delta::type::Double:
+		obs_data_set_double(data, key, entry.d);
+		break;
+	case settings_delta::type::Bool:
+		obs_data_set_bool(data, key, entry.b);
+		break;
+	case settings_delta::type::String:
+		obs_data_set_string(data, key, entry.s.c_str());
+		break;
+	case settings_delta::type::Object: {
+		obs_data_t* object = obs_data_create();
+		for (const settings_delta::entry& child : entry.object)
+			Apply(object, child);
+		obs_data_set_obj(data, key, object);
+		obs_data_release(object);
+		break;
+	}
+	}
+}
@@ -0,0 +1,47 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <obs.h>
+#include <vector>
+#include "settings-delta.hpp"
+
+namespace osn
+{
+	// Applies settings deltas (Source.UpdateDelta) straight into the settings
+	//  object of a source. Deltas are coalesced per source and key, and a worker
+	//  applies whatever accumulated at most once per video frame, so a slider
+	//  that sends dozens of updates per second costs one update per frame.
+	class SettingsDelta
+	{
+		public:
+		// The worker runs from OBS_API_initAPI until OBS_API_destroyOBS_API,
+		//  Stop applies whatever is still queued.
+		static void Start();
+		static void Stop();
+
+		static void Queue(obs_source_t* source, std::vector<settings_delta::entry>& entries);
+
+		// Applies the queued delta of 'source' right away. Call before anything
+		//  that reads or replaces the settings of a source, so that it never
+		//  observes (or is overwritten by) an older queued value.
+		static void Flush(obs_source_t* source);
+		static void FlushAll();
+
+		static void Apply(obs_data_t* data, const settings_delta::entry& entry);
+	};
+} // namespace osn
@@ -26,13 +26,16 @@
 #include <obs.h>
 #include <obs.hpp>
 #include "error.hpp"
+#include "nodeobs_api.h"
 #include "obs-property.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-common.hpp"
+#include "osn-events.hpp"
+#include "osn-properties.hpp"
+#include "osn-settings-delta.hpp"
 #include "shared.hpp"
 
-std::map<uint64_t, std::vector<std::tuple<std::string, std::string, obs_hotkey_id>>> pending_source_hotkeys;
-std::mutex                                                           source_hotkey_mtx;
-
 std::vector<std::tuple<std::string, std::string, obs_hotkey_id>> get_source_hotkeys(uint64_t sourceID)
 {
 	std::vector<std::tuple<std::string, std::string, obs_hotkey_id>> hotkeys;
@@ -130,9 +133,17 @@ void osn::Source::global_source_create_cb(void* ptr, calldata_t* cd)
 
 	auto sourceId      = osn::Source::Manager::GetInstance().find(source);
 	auto sourceHotkeys = get_source_hotkeys(sourceId);
+	if (sourceHotkeys.empty())
+		return;
 
-	std::unique_lock<std::mutex> ulock(source_hotkey_mtx);
-	pending_source_hotkeys.insert({sourceId, sourceHotkeys});
+	const char*             name = obs_source_get_name(source);
+	std::vector<ipc::value> payload{ipc::value(name ? name : "")};
+	for (auto& hotkeyTuple : sourceHotkeys) {
+		payload.push_back(ipc::value(std::get<0>(hotkeyTuple)));
+		payload.push_back(ipc::value(std::get<1>(hotkeyTuple)));
+		payload.push_back(ipc::value((uint64_t)std::get<2>(hotkeyTuple)));
+	}
+	osn::Events::Publish(EventType::SourceHotkeys, std::move(payload));
 }
 
 void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
@@ -142,15 +153,6 @@ void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
 		throw std::exception("calldata did not contain source pointer");
 	}
 
-	{
-		std::unique_lock<std::mutex> ulock(source_hotkey_mtx);
-
-		auto iter = pending_source_hotkeys.find(osn::Source::Manager::GetInstance().find(source));
-		if (iter != pending_source_hotkeys.end()) {
-			pending_source_hotkeys.erase(iter);
-		}
-	}
-
 	detach_source_signals(source);
 	osn::Source::Manager::GetInstance().free(source);
 }
@@ -159,55 +161,58 @@ void osn::Source::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Source");
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetDefaults", std::vector<ipc::type>{ipc::type::String}, GetTypeDefaults));
+	    osn::CallStats::Function(cls, "GetDefaults", std::vector<ipc::type>{ipc::type::String}, GetTypeDefaults));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "GetProperties", std::vector<ipc::type>{ipc::type::String}, GetTypeProperties));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::String}, GetTypeProperties));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetOutputFlags", std::vector<ipc::type>{ipc::type::String}, GetTypeOutputFlags));
+	    osn::CallStats::Function(cls, "GetOutputFlags", std::vector<ipc::type>{ipc::type::String}, GetTypeOutputFlags));
 
+	cls->register_function(osn::CallStats::Function(cls, "Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
+	    osn::CallStats::Function(cls, "Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
+	    osn::CallStats::Function(cls, "IsConfigurable", std::vector<ipc::type>{ipc::type::UInt64}, IsConfigurable));
 	cls->register_function(
-	    std::make_shared<ipc::function>("IsConfigurable", std::vector<ipc::type>{ipc::type::UInt64}, IsConfigurable));
+	    osn::CallStats::Function(cls, "GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetProperties", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, GetPropertiesCached));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
+	    osn::CallStats::Function(cls, "GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
+	cls->register_function(osn::CallStats::Function(cls, "Load", std::vector<ipc::type>{ipc::type::UInt64}, Load));
+	cls->register_function(osn::CallStats::Function(cls, "Save", std::vector<ipc::type>{ipc::type::UInt64}, Save));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
-	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::UInt64}, Load));
-	cls->register_function(std::make_shared<ipc::function>("Save", std::vector<ipc::type>{ipc::type::UInt64}, Save));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Update", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Update));
+	    osn::CallStats::Function(cls, "Update", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Update));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "UpdateDelta", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, UpdateDelta));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetType", std::vector<ipc::type>{ipc::type::UInt64}, GetType));
+	    osn::CallStats::Function(cls, "GetType", std::vector<ipc::type>{ipc::type::UInt64}, GetType));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
+	    osn::CallStats::Function(cls, "GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("SetName", std::vector<ipc::type>{ipc::type::UInt64}, SetName));
+	    osn::CallStats::Function(cls, "SetName", std::vector<ipc::type>{ipc::type::UInt64}, SetName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetOutputFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetOutputFlags));
+	    osn::CallStats::Function(cls, "GetOutputFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetOutputFlags));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetFlags));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetFlags", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetFlags));
+	    osn::CallStats::Function(cls, "GetFlags", std::vector<ipc::type>{ipc::type::UInt64}, GetFlags));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetFlags", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetFlags));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetStatus", std::vector<ipc::type>{ipc::type::UInt64}, GetStatus));
-	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, Query));
-	cls->register_function(std::make_shared<ipc::function>(
+	    osn::CallStats::Function(cls, "GetStatus", std::vector<ipc::type>{ipc::type::UInt64}, GetStatus));
+	cls->register_function(osn::CallStats::Function(cls, "GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "ProcessHotkeyStatus",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::String},
 	    ProcessHotkeyStatus));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetMuted", std::vector<ipc::type>{ipc::type::UInt64}, GetMuted));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
+	    osn::CallStats::Function(cls, "GetMuted", std::vector<ipc::type>{ipc::type::UInt64}, GetMuted));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Source::GetTypeProperties(
@@ -216,9 +221,21 @@ void osn::Source::GetTypeProperties(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	AUTO_DEBUG;
 	// Per Type Properties (doesn't have an object).
-	//obs_get_source_properties();
+	OBS_API::openModuleForType(args[0].value_str);
+
+	obs_properties_t* prp = obs_get_source_properties(args[0].value_str.c_str());
+	if (prp == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::NotFound));
+		rval.push_back(ipc::value("Source type has no properties."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	osn::Properties::Serialize(prp, rval);
+	obs_properties_destroy(prp);
+	AUTO_DEBUG;
 }
 
 void osn::Source::GetTypeDefaults(
@@ -227,9 +244,21 @@ void osn::Source::GetTypeDefaults(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	AUTO_DEBUG;
 	// Per Type Defaults (doesn't have an object)
-	//obs_get_source_defaults();
+	OBS_API::openModuleForType(args[0].value_str);
+
+	obs_data_t* defaults = obs_get_source_defaults(args[0].value_str.c_str());
+	if (defaults == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::NotFound));
+		rval.push_back(ipc::value("Source type not found."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs_data_get_full_json(defaults)));
+	obs_data_release(defaults);
+	AUTO_DEBUG;
 }
 
 void osn::Source::GetTypeOutputFlags(
@@ -320,138 +349,52 @@ void osn::Source::GetProperties(
 		return;
 	}
 
+	osn::SettingsDelta::Flush(src);
 	obs_properties_t* prp = obs_source_properties(src);
-	const char*       buf;
-
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	for (obs_property_t* p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p)) {
-		std::shared_ptr<obs::Property> prop;
-
-		switch (obs_property_get_type(p)) {
-		case OBS_PROPERTY_BOOL:
-			prop = std::make_shared<obs::BooleanProperty>();
-			break;
-		case OBS_PROPERTY_INT: {
-			auto prop2        = std::make_shared<obs::IntegerProperty>();
-			prop2->field_type = obs::NumberProperty::NumberType(obs_property_int_type(p));
-			prop2->minimum    = obs_property_int_min(p);
-			prop2->maximum    = obs_property_int_max(p);
-			prop2->step       = obs_property_int_step(p);
-			prop              = prop2;
-			break;
-		}
-		case OBS_PROPERTY_FLOAT: {
-			auto prop2        = std::make_shared<obs::FloatProperty>();
-			prop2->field_type = obs::NumberProperty::NumberType(obs_property_float_type(p));
-			prop2->minimum    = obs_property_float_min(p);
-			prop2->maximum    = obs_property_float_max(p);
-			prop2->step       = obs_property_float_step(p);
-			prop              = prop2;
-			break;
-		}
-		case OBS_PROPERTY_TEXT: {
-			auto prop2        = std::make_shared<obs::TextProperty>();
-			prop2->field_type = obs::TextProperty::TextType(obs_proprety_text_type(p));
-			prop              = prop2;
-			break;
-		}
-		case OBS_PROPERTY_PATH: {
-			auto prop2          = std::make_shared<obs::PathProperty>();
-			prop2->field_type   = obs::PathProperty::PathType(obs_property_path_type(p));
-			prop2->filter       = (buf = obs_property_path_filter(p)) != nullptr ? buf : "";
-			prop2->default_path = (buf = obs_property_path_default_path(p)) != nullptr ? buf : "";
-			prop                = prop2;
-			break;
-		}
-		case OBS_PROPERTY_LIST: {
-			auto prop2        = std::make_shared<obs::ListProperty>();
-			prop2->field_type = obs::ListProperty::ListType(obs_property_list_type(p));
-			prop2->format     = obs::ListProperty::Format(obs_property_list_format(p));
-			size_t items      = obs_property_list_item_count(p);
-			for (size_t idx = 0; idx < items; ++idx) {
-				obs::ListProperty::Item entry;
-				entry.name    = (buf = obs_property_list_item_name(p, idx)) != nullptr ? buf : "";
-				entry.enabled = !obs_property_list_item_disabled(p, idx);
-				switch (prop2->format) {
-				case obs::ListProperty::Format::Integer:
-					entry.value_int = obs_property_list_item_int(p, idx);
-					break;
-				case obs::ListProperty::Format::Float:
-					entry.value_float = obs_property_list_item_float(p, idx);
-					break;
-				case obs::ListProperty::Format::String:
-					entry.value_string = (buf = obs_property_list_item_string(p, idx)) != nullptr ? buf : "";
-					break;
-				}
-				prop2->items.push_back(std::move(entry));
-			}
-			prop = prop2;
-			break;
-		}
-		case OBS_PROPERTY_COLOR:
-			prop = std::make_shared<obs::ColorProperty>();
-			break;
-		case OBS_PROPERTY_BUTTON:
-			prop = std::make_shared<obs::ButtonProperty>();
-			break;
-		case OBS_PROPERTY_FONT:
-			prop = std::make_shared<obs::FontProperty>();
-			break;
-		case OBS_PROPERTY_EDITABLE_LIST: {
-			auto prop2          = std::make_shared<obs::EditableListProperty>();
-			prop2->field_type   = obs::EditableListProperty::ListType(obs_property_editable_list_type(p));
-			prop2->filter       = (buf = obs_property_editable_list_filter(p)) != nullptr ? buf : "";
-			prop2->default_path = (buf = obs_property_editable_list_default_path(p)) != nullptr ? buf : "";
-			prop                = prop2;
-			break;
-		}
-		case OBS_PROPERTY_FRAME_RATE: {
-			auto   prop2      = std::make_shared<obs::FrameRateProperty>();
-			size_t num_ranges = obs_property_frame_rate_fps_ranges_count(p);
-			for (size_t idx = 0; idx < num_ranges; idx++) {
-				auto min = obs_property_frame_rate_fps_range_min(p, idx),
-				     max = obs_property_frame_rate_fps_range_max(p, idx);
-
-				obs::FrameRateProperty::Range range;
-				range.minimum.first  = min.numerator;
-				range.minimum.second = min.denominator;
-				range.maximum.first  = max.numerator;
-				range.maximum.second = max.denominator;
-
-				prop2->ranges.push_back(std::move(range));
-			}
-
-			size_t num_options = obs_property_frame_rate_options_count(p);
-			for (size_t idx = 0; idx < num_options; idx++) {
-				auto min = obs_property_frame_rate_fps_range_min(p, idx),
-				     max = obs_property_frame_rate_fps_range_max(p, idx);
-
-				obs::FrameRateProperty::Option option;
-				option.name        = (buf = obs_property_frame_rate_option_name(p, idx)) != nullptr ? buf : "";
-				option.description = (buf = obs_property_frame_rate_option_description(p, idx)) != nullptr ? buf : "";
-
-				prop2->options.push_back(std::move(option));
-			}
-
-			prop = prop2;
-			break;
-		}
-		}
+	osn::Properties::Serialize(prp, rval);
+	obs_properties_destroy(prp);
+	AUTO_DEBUG;
+}
 
-		if (!prop) {
-			continue;
-		}
+void osn::Source::GetPropertiesCached(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Attempt to find the source asked to load.
+	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (src == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
 
-		prop->name             = obs_property_name(p);
-		prop->description      = obs_property_description(p) ? obs_property_description(p) : "";
-		prop->long_description = obs_property_long_description(p) ? obs_property_long_description(p) : "";
-		prop->enabled          = obs_property_enabled(p);
-		prop->visible          = obs_property_visible(p);
+	osn::SettingsDelta::Flush(src);
+	obs_properties_t*                        prp    = obs_source_properties(src);
+	std::shared_ptr<osn::Properties::Schema> schema = osn::Properties::GetSchema(src, prp);
 
-		std::vector<char> buf(prop->size());
-		if (prop->serialize(buf)) {
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(schema->id));
+	if (schema->id != args[1].value_union.ui64) {
+		// Client does not know this schema yet, send all of it.
+		// The cached lists hold the items from when the schema was built.
+		rval.push_back(ipc::value(int32_t(1)));
+		size_t first = rval.size();
+		for (const std::vector<char>& buf : schema->properties)
 			rval.push_back(ipc::value(buf));
+		for (size_t idx = 0; idx < schema->lists.size(); idx++) {
+			std::vector<char> buf = osn::Properties::SerializeProperty(prp, schema->lists[idx]);
+			if (buf.size())
+				rval[first + schema->list_slots[idx]] = ipc::value(buf);
 		}
+	} else {
+		// Only list items can change without changing the schema.
+		rval.push_back(ipc::value(int32_t(0)));
+		for (const std::string& name : schema->lists)
+			rval.push_back(ipc::value(osn::Properties::SerializeProperty(prp, name)));
 	}
 	obs_properties_destroy(prp);
 	AUTO_DEBUG;
@@ -472,6 +415,7 @@ void osn::Source::GetSettings(
 		return;
 	}
 
+	osn::SettingsDelta::Flush(src);
 	obs_data_t* sets = obs_source_get_settings(src);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(obs_data_get_full_json(sets)));
@@ -494,6 +438,7 @@ void osn::Source::Update(
 		return;
 	}
 
+	osn::SettingsDelta::Flush(src);
 	obs_data_t* sets = obs_data_create_from_json(args[1].value_str.c_str());
 	obs_source_update(src, sets);
 	obs_data_release(sets);
@@ -502,6 +447,35 @@ void osn::Source::Update(
 	AUTO_DEBUG;
 }
 
+void osn::Source::UpdateDelta(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Attempt to find the source asked to load.
+	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (src == nullptr) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::InvalidReference));
+		rval.push_back(ipc::value("Source reference is not valid."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	std::vector<osn::settings_delta::entry> entries;
+	if (!osn::settings_delta::decode(args[1].value_bin.data(), args[1].value_bin.size(), entries)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Settings delta is malformed."));
+		AUTO_DEBUG;
+		return;
+	}
+
+	osn::SettingsDelta::Queue(src, entries);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
 void osn::Source::Load(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 {
 	// Attempt to find the source asked to load.
@@ -530,6 +504,7 @@ void osn::Source::Save(void* data, const int64_t id, const std::vector<ipc::valu
 		return;
 	}
 
+	osn::SettingsDelta::Flush(src);
 	obs_source_save(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -701,38 +676,6 @@ void osn::Source::GetId(
 	AUTO_DEBUG;
 }
 
-void osn::Source::Query(
-    void*                          data,
-    const int64_t                  id,
-    const std::vector<ipc::value>& args,
-    std::vector<ipc::value>&       rval)
-{
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	std::unique_lock<std::mutex> ulock(source_hotkey_mtx);
-
-	// For each source entry
-	for (auto iter : pending_source_hotkeys) {
-		// Check for an invalid reference
-		obs_source_t* src = osn::Source::Manager::GetInstance().find(iter.first);
-		if (src == nullptr) {
-			continue;
-		}
-
-		// For each hotkey entry
-		for (auto& hotkeyTuple : iter.second) {
-			rval.push_back(ipc::value(obs_source_get_name(src)));
-			rval.push_back(ipc::value(std::get<0>(hotkeyTuple)));
-			rval.push_back(ipc::value(std::get<1>(hotkeyTuple)));
-			rval.push_back(ipc::value(std::get<2>(hotkeyTuple)));
-		}
-	}
-
-	pending_source_hotkeys.clear();
-
-	AUTO_DEBUG;
-}
-
 void osn::Source::ProcessHotkeyStatus(
     void*                          data,
     const int64_t                  id,
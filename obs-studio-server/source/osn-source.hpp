@@ -17,6 +17,7 @@
 
 #pragma once
 #include <ipc-server.hpp>
+#include <mutex>
 #include <obs.h>
 #include "utility.hpp"
 
@@ -39,6 +40,43 @@ namespace osn
 
 			public:
 			static Manager& GetInstance();
+
+			// Sources are created and destroyed on whatever thread libobs (or
+			//  the parallel collection loader) happens to be on, so unlike the
+			//  other managers every access is serialized.
+			utility::unique_id::id_t allocate(obs_source_t* obj)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return unique_object_manager::allocate(obj);
+			}
+			utility::unique_id::id_t find(obs_source_t* obj)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return unique_object_manager::find(obj);
+			}
+			obs_source_t* find(utility::unique_id::id_t id)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return unique_object_manager::find(id);
+			}
+			utility::unique_id::id_t free(obs_source_t* obj)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return unique_object_manager::free(obj);
+			}
+			obs_source_t* free(utility::unique_id::id_t id)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return unique_object_manager::free(id);
+			}
+			void for_each(std::function<void(utility::unique_id::id_t, obs_source_t*)> fn)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				unique_object_manager::for_each(fn);
+			}
+
+			private:
+			std::mutex lock;
 		};
 
 		static void initialize_global_signals();
@@ -86,6 +124,11 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+		static void GetPropertiesCached(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 		static void GetSettings(
 		    void*                          data,
 		    const int64_t                  id,
@@ -93,6 +136,11 @@ namespace osn
 		    std::vector<ipc::value>&       rval);
 		static void
 		    Update(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void UpdateDelta(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 		static void
 		    Load(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
@@ -117,8 +165,6 @@ namespace osn
 		    GetStatus(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
 		    GetId(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
-		static void
-		    Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
 		    ProcessHotkeyStatus(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 
@@ -20,37 +20,42 @@
 #include <memory>
 #include <obs.h>
 #include "error.hpp"
+#include "nodeobs_api.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
 void osn::Transition::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Transition");
-	cls->register_function(std::make_shared<ipc::function>("Types", std::vector<ipc::type>{}, Types));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(cls, "Types", std::vector<ipc::type>{}, Types));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "Create",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String, ipc::type::String},
 	    Create));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
-	cls->register_function(std::make_shared<ipc::function>(
+	cls->register_function(osn::CallStats::Function(
+	    cls, "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
+	cls->register_function(osn::CallStats::Function(
+	    cls,
 	    "CreatePrivate",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
 	    CreatePrivate));
 	cls->register_function(
-	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::UInt64}, FromName));
+	    osn::CallStats::Function(cls, "FromName", std::vector<ipc::type>{ipc::type::UInt64}, FromName));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetActiveSource", std::vector<ipc::type>{ipc::type::UInt64}, GetActiveSource));
-	cls->register_function(std::make_shared<ipc::function>("Clear", std::vector<ipc::type>{ipc::type::UInt64}, Clear));
+	    osn::CallStats::Function(cls, "GetActiveSource", std::vector<ipc::type>{ipc::type::UInt64}, GetActiveSource));
+	cls->register_function(osn::CallStats::Function(cls, "Clear", std::vector<ipc::type>{ipc::type::UInt64}, Clear));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Transition::Types(
@@ -64,6 +69,9 @@ void osn::Transition::Types(
 	for (size_t idx = 0; obs_enum_transition_types(idx, &typeId); idx++) {
 		rval.push_back(ipc::value(typeId ? typeId : ""));
 	}
+	for (const std::string& type : OBS_API::deferredTypes(OBS_API::ModuleTypes::Transition)) {
+		rval.push_back(ipc::value(type));
+	}
 	AUTO_DEBUG;
 }
 
@@ -87,6 +95,8 @@ void osn::Transition::Create(
 		break;
 	}
 
+	OBS_API::openModuleForType(sourceId);
+
 	obs_source_t* source = obs_source_create(sourceId.c_str(), name.c_str(), settings, hotkeys);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -127,6 +137,8 @@ void osn::Transition::CreatePrivate(
 		break;
 	}
 
+	OBS_API::openModuleForType(sourceId);
+
 	obs_source_t* source = obs_source_create_private(sourceId.c_str(), name.c_str(), settings);
 	if (!source) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
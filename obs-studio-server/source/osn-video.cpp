@@ -19,6 +19,8 @@
 #include <ipc-server.hpp>
 #include <obs.h>
 #include "error.hpp"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
 #include "shared.hpp"
 
 video_t* handler;
@@ -26,13 +28,13 @@ video_t* handler;
 void osn::Video::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Video");
-	cls->register_function(std::make_shared<ipc::function>("GetGlobal", std::vector<ipc::type>{}, GetGlobal));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetSkippedFrames", std::vector<ipc::type>{ipc::type::UInt64}, GetSkippedFrames));
+	cls->register_function(osn::CallStats::Function(cls, "GetGlobal", std::vector<ipc::type>{}, GetGlobal));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetTotalFrames", std::vector<ipc::type>{ipc::type::UInt64}, GetTotalFrames));
+	    osn::CallStats::Function(cls, "GetSkippedFrames", std::vector<ipc::type>{ipc::type::UInt64}, GetSkippedFrames));
+	cls->register_function(
+	    osn::CallStats::Function(cls, "GetTotalFrames", std::vector<ipc::type>{ipc::type::UInt64}, GetTotalFrames));
 
-	srv.register_collection(cls);
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::Video::GetGlobal(
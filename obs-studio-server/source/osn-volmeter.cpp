@@ -18,9 +18,16 @@
 #include "osn-volmeter.hpp"
 #include "error.hpp"
 #include "obs.h"
+#include "osn-batch.hpp"
+#include "osn-call-stats.hpp"
+#include "osn-events.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include "volmeter-frame.hpp"
+
+std::mutex                                   osn::VolMeter::pending_mtx;
+std::map<uint64_t, osn::VolMeter::AudioData> osn::VolMeter::pending_frames;
 
 osn::VolMeter::Manager& osn::VolMeter::Manager::GetInstance()
 {
@@ -43,23 +50,23 @@ osn::VolMeter::~VolMeter()
 void osn::VolMeter::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("VolMeter");
-	cls->register_function(std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
+	cls->register_function(osn::CallStats::Function(cls, "Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "GetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64}, GetUpdateInterval));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "SetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetUpdateInterval));
-	cls->register_function(std::make_shared<ipc::function>(
-	    "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
+	    osn::CallStats::Function(cls, "Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "GetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64}, GetUpdateInterval));
+	cls->register_function(osn::CallStats::Function(
+	    cls, "SetUpdateInterval", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetUpdateInterval));
 	cls->register_function(
-	    std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	    osn::CallStats::Function(cls, "Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
+	cls->register_function(osn::CallStats::Function(cls, "Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
 	cls->register_function(
-	    std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
+	    osn::CallStats::Function(cls, "AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
 	cls->register_function(
-	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
-	srv.register_collection(cls);
+	    osn::CallStats::Function(cls, "RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
+	cls->register_function(osn::CallStats::Function(cls, "Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
+	cls->register_function(osn::CallStats::Function(cls, "QueryAll", std::vector<ipc::type>{}, QueryAll));
+	osn::Batch::RegisterCollection(srv, cls);
 }
 
 void osn::VolMeter::Create(
@@ -118,6 +125,11 @@ void osn::VolMeter::Destroy(
 		meter->id2 = nullptr;
 	}
 
+	{
+		std::unique_lock<std::mutex> ulock(pending_mtx);
+		pending_frames.erase(uid);
+	}
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
@@ -271,6 +283,9 @@ void osn::VolMeter::RemoveCallback(
 		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
 		delete meter->id2;
 		meter->id2 = nullptr;
+
+		std::unique_lock<std::mutex> ulock(pending_mtx);
+		pending_frames.erase(uid);
 	}
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
@@ -310,6 +325,62 @@ void osn::VolMeter::Query(
 	AUTO_DEBUG;
 }
 
+void osn::VolMeter::serialize_frame(std::vector<char>& buf, uint64_t uid, const AudioData& data)
+{
+	VolMeterFrameHeader header = {};
+	header.uid                 = uid;
+	header.channels            = uint32_t(data.ch);
+
+	size_t offset = buf.size();
+	size_t plane  = sizeof(float) * header.channels;
+	buf.resize(offset + VolMeterFrameSize(header.channels));
+
+	char* ptr = buf.data() + offset;
+	memcpy(ptr, &header, sizeof(header));
+	ptr += sizeof(header);
+	memcpy(ptr, data.magnitude, plane);
+	ptr += plane;
+	memcpy(ptr, data.peak, plane);
+	ptr += plane;
+	memcpy(ptr, data.input_peak, plane);
+}
+
+void osn::VolMeter::QueryAll(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<char> buf;
+	Manager::GetInstance().for_each([&buf](uint64_t uid, std::shared_ptr<VolMeter> meter) {
+		if (!meter || !obs_volmeter_get_nr_channels(meter->self))
+			return;
+
+		std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+		serialize_frame(buf, uid, meter->current_data);
+	});
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buf));
+	AUTO_DEBUG;
+}
+
+std::vector<char> osn::VolMeter::TakePendingFrames()
+{
+	std::map<uint64_t, AudioData> frames;
+	{
+		std::unique_lock<std::mutex> ulock(pending_mtx);
+		pending_frames.swap(frames);
+	}
+
+	std::vector<char> buf;
+	buf.reserve(frames.size() * VolMeterFrameSize(MAX_AUDIO_CHANNELS));
+	for (auto& kv : frames) {
+		serialize_frame(buf, kv.first, kv.second);
+	}
+	return buf;
+}
+
 void osn::VolMeter::OBSCallback(
     void*       param,
     const float magnitude[MAX_AUDIO_CHANNELS],
@@ -333,5 +404,12 @@ void osn::VolMeter::OBSCallback(
 		meter->current_data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
 	}
 
+	// Publish to the event channel, only the latest frame per meter is kept.
+	{
+		std::unique_lock<std::mutex> plock(pending_mtx);
+		pending_frames[meter->id] = meter->current_data;
+	}
+	osn::Events::Wake();
+
 #undef MAKE_FLOAT_SANE
 }
@@ -17,7 +17,9 @@
 
 #pragma once
 #include <ipc-server.hpp>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include "obs.h"
 #include "utility.hpp"
@@ -41,6 +43,42 @@ namespace osn
 
 			public:
 			static Manager& GetInstance();
+
+			// OBSCallback looks meters up from the audio thread while the IPC
+			//  thread creates and destroys them, so every access is serialized.
+			utility::unique_id::id_t allocate(std::shared_ptr<VolMeter> obj)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return generic_object_manager::allocate(obj);
+			}
+			utility::unique_id::id_t find(std::shared_ptr<VolMeter> obj)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return generic_object_manager::find(obj);
+			}
+			std::shared_ptr<VolMeter> find(utility::unique_id::id_t id)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return generic_object_manager::find(id);
+			}
+			utility::unique_id::id_t free(std::shared_ptr<VolMeter> obj)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return generic_object_manager::free(obj);
+			}
+			std::shared_ptr<VolMeter> free(utility::unique_id::id_t id)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				return generic_object_manager::free(id);
+			}
+			void for_each(std::function<void(utility::unique_id::id_t, std::shared_ptr<VolMeter>)> fn)
+			{
+				std::unique_lock<std::mutex> ul(lock);
+				generic_object_manager::for_each(fn);
+			}
+
+			private:
+			std::mutex lock;
 		};
 
 		private:
@@ -60,6 +98,13 @@ namespace osn
 		AudioData current_data;
 		std::mutex                 current_data_mtx;
 
+		// OBSCallback keeps the latest frame of each meter here, Events.Poll
+		//  collects them all at once through TakePendingFrames.
+		static std::mutex                    pending_mtx;
+		static std::map<uint64_t, AudioData> pending_frames;
+
+		static void serialize_frame(std::vector<char>& buf, uint64_t uid, const AudioData& data);
+
 		public:
 		VolMeter(obs_fader_type type);
 		~VolMeter();
@@ -99,6 +144,15 @@ namespace osn
 
 		static void
 		            Query(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void QueryAll(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		// Packed frames of every meter that published since the last call.
+		static std::vector<char> TakePendingFrames();
+
 		static void OBSCallback(
 		    void*       param,
 		    const float magnitude[MAX_AUDIO_CHANNELS],
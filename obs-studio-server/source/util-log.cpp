@@ -0,0 +1,407 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "util-log.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <obs.h>
+#include <util/platform.h>
+
+#ifdef _WIN32
+#include <codecvt>
+#include <locale>
+#include <windows.h>
+#endif
+
+// How long the writer sleeps when there is nothing to write.
+#define LOGGER_IDLE_INTERVAL std::chrono::milliseconds(50)
+
+static const char* LevelName(int level)
+{
+	switch (level) {
+	case LOG_INFO:
+		return "Info";
+	case LOG_WARNING:
+		return "Warning";
+	case LOG_ERROR:
+		return "Error";
+	case LOG_DEBUG:
+		return "Debug";
+	}
+
+	if (level <= 50) {
+		return "Critical";
+	} else if (level < LOG_ERROR) {
+		return "Error";
+	} else if (level < LOG_WARNING) {
+		return "Alert";
+	} else if (level < LOG_INFO) {
+		return "Hint";
+	}
+	return "Notice";
+}
+
+static std::string GenerateTimeDateFilename(const char* extension)
+{
+	time_t     now       = time(0);
+	char       file[256] = {};
+	struct tm* cur_time;
+
+	cur_time = localtime(&now);
+	snprintf(
+	    file,
+	    sizeof(file),
+	    "%d-%02d-%02d %02d-%02d-%02d.%s",
+	    cur_time->tm_year + 1900,
+	    cur_time->tm_mon + 1,
+	    cur_time->tm_mday,
+	    cur_time->tm_hour,
+	    cur_time->tm_min,
+	    cur_time->tm_sec,
+	    extension);
+
+	return std::string(file);
+}
+
+// Matches the names produced by GenerateTimeDateFilename.
+static bool IsLogFilename(const char* name)
+{
+	const char* pattern = "0000-00-00 00-00-00.txt";
+	for (size_t idx = 0; pattern[idx] != '\0'; idx++) {
+		if (pattern[idx] == '0' ? !isdigit((unsigned char)name[idx]) : (name[idx] != pattern[idx]))
+			return false;
+	}
+	return true;
+}
+
+util::Logger::Logger() : m_enqueue(0), m_dequeue(0), m_dropped(0), m_written(0), m_running(false) {}
+
+util::Logger::~Logger()
+{
+	stop();
+}
+
+bool util::Logger::start(const std::string& directory, const Options& options)
+{
+	if (m_running)
+		return false;
+
+	m_options   = options;
+	m_directory = directory;
+
+	size_t wanted   = options.capacity > max_capacity ? max_capacity : std::max<size_t>(options.capacity, 2);
+	size_t capacity = 1;
+	while (capacity < wanted)
+		capacity <<= 1;
+
+	m_entries.reset(new Entry[capacity]);
+	m_mask = capacity - 1;
+	for (size_t idx = 0; idx < capacity; idx++) {
+		m_entries[idx].sequence.store(idx, std::memory_order_relaxed);
+	}
+	m_enqueue.store(0, std::memory_order_relaxed);
+	m_dequeue.store(0, std::memory_order_relaxed);
+	m_start = std::chrono::steady_clock::now();
+
+	rotate();
+	if (!m_file.is_open())
+		return false;
+
+	m_running = true;
+	m_worker  = std::thread(&util::Logger::worker, this);
+	return true;
+}
+
+void util::Logger::stop()
+{
+	if (!m_running)
+		return;
+
+	m_running = false;
+	m_wake.notify_all();
+	if (m_worker.joinable())
+		m_worker.join();
+	m_file.close();
+}
+
+void util::Logger::log(int level, const char* format, va_list args)
+{
+	if (!m_running)
+		return;
+
+	uint64_t timestamp =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+
+	// Formatting has to happen here since 'args' does not outlive the call,
+	//  a per thread buffer keeps it down to a single pass for most messages.
+	thread_local std::vector<char> buffer(4096);
+
+	va_list copy;
+	va_copy(copy, args);
+	int length = vsnprintf(buffer.data(), buffer.size(), format, copy);
+	va_end(copy);
+	if (length < 0)
+		return;
+	if (size_t(length) >= buffer.size()) {
+		buffer.resize(length + 1);
+		vsnprintf(buffer.data(), buffer.size(), format, args);
+	}
+
+	// Split by \n (new-line), each line becomes at least one entry.
+	const char* text = buffer.data();
+	size_t      last = 0;
+	for (size_t idx = 0; idx <= size_t(length); idx++) {
+		if ((idx != size_t(length)) && (text[idx] != '\n'))
+			continue;
+
+		size_t offset = last;
+		do {
+			size_t chunk = std::min(idx - offset, line_size);
+			push(level, timestamp, text + offset, chunk);
+			offset += chunk;
+		} while (offset < idx);
+		last = idx + 1;
+	}
+
+#if defined(_WIN32) && defined(OBS_DEBUGBREAK_ON_ERROR)
+	if (level <= LOG_ERROR && IsDebuggerPresent())
+		__debugbreak();
+#endif
+}
+
+uint64_t util::Logger::dropped()
+{
+	return m_dropped;
+}
+
+uint64_t util::Logger::written()
+{
+	return m_written;
+}
+
+void util::Logger::push(int level, uint64_t timestamp, const char* text, size_t length)
+{
+	while (!try_push(level, timestamp, text, length)) {
+		if ((m_options.overflow == Overflow::Drop) || !m_running) {
+			m_dropped++;
+			return;
+		}
+
+		m_wake.notify_one();
+		std::this_thread::yield();
+	}
+	m_wake.notify_one();
+}
+
+bool util::Logger::try_push(int level, uint64_t timestamp, const char* text, size_t length)
+{
+	// Bounded multi-producer queue: a slot belongs to whoever advances m_enqueue
+	//  past it, its sequence number tells whether the writer released it yet.
+	Entry* entry;
+	size_t position = m_enqueue.load(std::memory_order_relaxed);
+	for (;;) {
+		entry           = &m_entries[position & m_mask];
+		size_t   seq    = entry->sequence.load(std::memory_order_acquire);
+		intptr_t offset = intptr_t(seq) - intptr_t(position);
+		if (offset == 0) {
+			if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		} else if (offset < 0) {
+			return false;
+		} else {
+			position = m_enqueue.load(std::memory_order_relaxed);
+		}
+	}
+
+	entry->level     = level;
+	entry->timestamp = timestamp;
+	entry->length    = length;
+	memcpy(entry->text, text, length);
+	entry->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+bool util::Logger::pop(Entry*& entry, size_t& position)
+{
+	position = m_dequeue.load(std::memory_order_relaxed);
+	entry    = &m_entries[position & m_mask];
+	return entry->sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+void util::Logger::worker()
+{
+	std::string out, err;
+	out.reserve(64 * 1024);
+
+	for (;;) {
+		bool running = m_running;
+
+		Entry* entry;
+		size_t position;
+		size_t count = 0;
+		while (pop(entry, position)) {
+			append(out, entry->level, entry->timestamp, entry->text, entry->length);
+			if (entry->level <= LOG_WARNING) {
+				append(err, entry->level, entry->timestamp, entry->text, entry->length);
+			}
+
+			entry->sequence.store(position + m_mask + 1, std::memory_order_release);
+			m_dequeue.store(position + 1, std::memory_order_relaxed);
+			count++;
+		}
+
+		uint64_t dropped = m_dropped;
+		if (dropped != m_reported) {
+			std::string message = std::to_string(dropped - m_reported) + " log lines were dropped.";
+			uint64_t    timestamp =
+			    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start)
+			        .count();
+			append(out, LOG_WARNING, timestamp, message.data(), message.size());
+			append(err, LOG_WARNING, timestamp, message.data(), message.size());
+			m_reported = dropped;
+		}
+
+		if (!out.empty()) {
+			// File Log
+			m_file.write(out.data(), out.size());
+			m_file.flush();
+			m_file_size += out.size();
+
+			// Std Out / Std Err
+			/// Why fwrite and not std::cout and std::cerr?
+			/// Well, it seems that std::cout and std::cerr break if you click in the console window and paste.
+			/// Which is really bad, as nothing gets logged into the console anymore.
+			if (!err.empty()) {
+				fwrite(err.data(), sizeof(char), err.size(), stderr);
+			}
+			fwrite(out.data(), sizeof(char), out.size(), stdout);
+
+			// Debugger
+#ifdef _WIN32
+			if (IsDebuggerPresent()) {
+				int wNum = MultiByteToWideChar(CP_UTF8, 0, out.data(), int(out.size()), NULL, 0);
+				if (wNum > 0) {
+					std::wstring wide_buf(wNum, L'\0');
+					MultiByteToWideChar(CP_UTF8, 0, out.data(), int(out.size()), &wide_buf[0], wNum);
+					OutputDebugStringW(wide_buf.c_str());
+				}
+			}
+#endif
+
+			m_written += count;
+			out.clear();
+			err.clear();
+
+			if (m_file_size >= m_options.max_file_size)
+				rotate();
+		}
+
+		if (count == 0) {
+			if (!running)
+				break;
+
+			std::unique_lock<std::mutex> ul(m_wake_lock);
+			m_wake.wait_for(ul, LOGGER_IDLE_INTERVAL);
+		}
+	}
+}
+
+void util::Logger::append(std::string& buffer, int level, uint64_t timestamp, const char* text, size_t length)
+{
+	uint64_t nanoseconds  = timestamp % 1000;
+	uint64_t microseconds = (timestamp / 1000) % 1000;
+	uint64_t milliseconds = (timestamp / 1000000) % 1000;
+	uint64_t seconds      = (timestamp / 1000000000) % 60;
+	uint64_t minutes      = (timestamp / 60000000000) % 60;
+	uint64_t hours        = (timestamp / 3600000000000) % 24;
+	uint64_t days         = (timestamp / 86400000000000);
+
+	const char* levelname = LevelName(level);
+
+	char prefix[96];
+	int  prefix_length = snprintf(
+        prefix,
+        sizeof(prefix),
+        "[%.3d:%.2d:%.2d:%.2d.%.3d.%.3d.%.3d][%*s] ",
+        int(days),
+        int(hours),
+        int(minutes),
+        int(seconds),
+        int(milliseconds),
+        int(microseconds),
+        int(nanoseconds),
+        int(strlen(levelname)),
+        levelname);
+
+	buffer.append(prefix, std::min(size_t(prefix_length), sizeof(prefix) - 1));
+	buffer.append(text, length);
+	buffer.push_back('\n');
+}
+
+void util::Logger::rotate()
+{
+	// Names only have a resolution of one second, keep going rather than truncating ourselves.
+	std::string path = m_directory + GenerateTimeDateFilename("txt");
+	if (m_file.is_open() && (path == m_path))
+		return;
+
+	if (m_file.is_open())
+		m_file.close();
+
+	m_path = path;
+#ifdef _WIN32
+	std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+	m_file.open(converter.from_bytes(path).c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+#else
+	m_file.open(path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+#endif
+	m_file_size = 0;
+
+	if (!m_file.is_open()) {
+		fprintf(stderr, "Failed to open log file %s\n", path.c_str());
+	}
+
+	prune();
+}
+
+void util::Logger::prune()
+{
+	os_dir_t* dir = os_opendir(m_directory.c_str());
+	if (!dir) {
+		fprintf(stderr, "Failed to open log directory.\n");
+		return;
+	}
+
+	// Timestamped names sort chronologically.
+	std::vector<std::string> logs;
+	struct os_dirent*        entry;
+	while ((entry = os_readdir(dir)) != NULL) {
+		if (entry->directory || !IsLogFilename(entry->d_name))
+			continue;
+		logs.push_back(entry->d_name);
+	}
+	os_closedir(dir);
+
+	std::sort(logs.begin(), logs.end());
+	for (size_t idx = 0; idx + m_options.max_files < logs.size(); idx++) {
+		os_unlink((m_directory + logs[idx]).c_str());
+	}
+}
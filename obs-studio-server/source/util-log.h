@@ -0,0 +1,114 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace util
+{
+	// Log sink that keeps formatting and file I/O off the threads calling blog().
+	//  Producers only copy level, timestamp and the formatted lines into a bounded
+	//  ring buffer, a single writer thread batches them into the file and console.
+	class Logger
+	{
+		public:
+		enum class Overflow
+		{
+			Drop,  // Discard the line and count it.
+			Block, // Wait until the writer made room.
+		};
+
+		struct Options
+		{
+			size_t   capacity      = 4096; // In lines, rounded up to a power of two, at most max_capacity.
+			Overflow overflow      = Overflow::Drop;
+			size_t   max_file_size = 16 * 1024 * 1024; // Start a new file once exceeded.
+			size_t   max_files     = 3;                // Oldest files beyond this get deleted.
+		};
+
+		// Longer lines are split into several entries.
+		static const size_t line_size = 512;
+
+		// Larger capacities, e.g. straight from an IPC argument, are clamped to this.
+		static const size_t max_capacity = 65536;
+
+		private:
+		struct Entry
+		{
+			std::atomic<size_t> sequence;
+			int                 level;
+			uint64_t            timestamp;
+			size_t              length;
+			char                text[line_size];
+		};
+
+		Options                               m_options;
+		std::string                           m_directory;
+		std::unique_ptr<Entry[]>              m_entries;
+		size_t                                m_mask = 0;
+		std::atomic<size_t>                   m_enqueue;
+		std::atomic<size_t>                   m_dequeue;
+		std::atomic<uint64_t>                 m_dropped;
+		std::atomic<uint64_t>                 m_written;
+		std::atomic<bool>                     m_running;
+		std::chrono::steady_clock::time_point m_start;
+
+		std::thread             m_worker;
+		std::mutex              m_wake_lock;
+		std::condition_variable m_wake;
+
+		// Only touched by the writer thread.
+		std::ofstream m_file;
+		std::string   m_path;
+		size_t        m_file_size = 0;
+		uint64_t      m_reported  = 0;
+
+		public:
+		Logger();
+		~Logger();
+
+		// Open a new log file in 'directory' and start the writer thread.
+		bool start(const std::string& directory, const Options& options);
+		// Write out everything still queued and stop the writer thread.
+		void stop();
+
+		// Safe to call from any thread, the handler for base_set_log_handler.
+		void log(int level, const char* format, va_list args);
+
+		uint64_t dropped();
+		uint64_t written();
+
+		private:
+		void push(int level, uint64_t timestamp, const char* text, size_t length);
+		bool try_push(int level, uint64_t timestamp, const char* text, size_t length);
+		bool pop(Entry*& entry, size_t& position);
+
+		void worker();
+		void append(std::string& buffer, int level, uint64_t timestamp, const char* text, size_t length);
+		void rotate();
+		void prune();
+	};
+} // namespace util
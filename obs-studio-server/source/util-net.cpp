@@ -0,0 +1,153 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#include "util-net.h"
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+typedef int SOCKET;
+#define INVALID_SOCKET -1
+#define closesocket close
+#endif
+
+static bool SplitUrl(const std::string& url, std::string& host, std::string& port)
+{
+	std::string rest = url;
+	port             = "1935";
+
+	size_t scheme = rest.find("://");
+	if (scheme != std::string::npos) {
+		if (rest.compare(0, scheme, "rtmps") == 0)
+			port = "443";
+		rest = rest.substr(scheme + 3);
+	}
+	rest = rest.substr(0, rest.find('/'));
+
+	// [v6 address]:port
+	size_t colon = rest.rfind(':');
+	if (!rest.empty() && rest[0] == '[') {
+		size_t end = rest.find(']');
+		if (end == std::string::npos)
+			return false;
+		host  = rest.substr(1, end - 1);
+		colon = rest.find(':', end);
+	} else {
+		host = rest.substr(0, colon);
+	}
+	if (colon != std::string::npos && colon + 1 < rest.size())
+		port = rest.substr(colon + 1);
+
+	return !host.empty();
+}
+
+static bool SetNonBlocking(SOCKET sock)
+{
+#ifdef _WIN32
+	u_long mode = 1;
+	return ioctlsocket(sock, FIONBIO, &mode) == 0;
+#else
+	int flags = fcntl(sock, F_GETFL, 0);
+	return flags >= 0 && fcntl(sock, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+static bool ConnectPending()
+{
+#ifdef _WIN32
+	return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+	return errno == EINPROGRESS;
+#endif
+}
+
+static int Probe(const std::string& host, const std::string& port, std::chrono::milliseconds timeout)
+{
+	addrinfo hints    = {};
+	hints.ai_family   = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	addrinfo* addresses = nullptr;
+	if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0 || !addresses)
+		return -1;
+
+	int    result = -1;
+	SOCKET sock   = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+	if (sock != INVALID_SOCKET && SetNonBlocking(sock)) {
+		auto start = std::chrono::steady_clock::now();
+		bool done  = connect(sock, addresses->ai_addr, int(addresses->ai_addrlen)) == 0;
+		if (!done && ConnectPending()) {
+			fd_set writable, failed;
+			FD_ZERO(&writable);
+			FD_ZERO(&failed);
+			FD_SET(sock, &writable);
+			FD_SET(sock, &failed);
+
+			timeval tv;
+			tv.tv_sec  = long(timeout.count() / 1000);
+			tv.tv_usec = long(timeout.count() % 1000) * 1000;
+			if (select(int(sock + 1), nullptr, &writable, &failed, &tv) > 0 && FD_ISSET(sock, &writable)) {
+				int       error  = 0;
+				socklen_t length = sizeof(error);
+				done = getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) == 0
+				       && error == 0;
+			}
+		}
+		if (done) {
+			result = int(std::chrono::duration_cast<std::chrono::milliseconds>(
+			                 std::chrono::steady_clock::now() - start)
+			                 .count());
+		}
+	}
+
+	if (sock != INVALID_SOCKET)
+		closesocket(sock);
+	freeaddrinfo(addresses);
+	return result;
+}
+
+int util::ProbeConnectTime(const std::string& url, std::chrono::milliseconds timeout)
+{
+	std::string host, port;
+	if (!SplitUrl(url, host, port))
+		return -1;
+
+#ifdef _WIN32
+	WSADATA wsa;
+	if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+		return -1;
+	int result = Probe(host, port, timeout);
+	WSACleanup();
+	return result;
+#else
+	return Probe(host, port, timeout);
+#endif
+}
@@ -0,0 +1,28 @@
+// Client module for the OBS Studio node module.
+// Copyright(C) 2017 Streamlabs (General Workings Inc)
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
+
+#pragma once
+#include <chrono>
+#include <string>
+
+namespace util
+{
+	// Time in milliseconds to open a TCP connection to the host of an ingest
+	//  URL like rtmp://host[:port]/app, or -1 if that did not succeed within
+	//  'timeout'. Name resolution is not part of the measured time.
+	int ProbeConnectTime(const std::string& url, std::chrono::milliseconds timeout);
+} // namespace util
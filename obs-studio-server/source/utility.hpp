@@ -16,9 +16,13 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301, USA.
 
 #pragma once
+#include <functional>
+#include <inttypes.h>
 #include <limits>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #if defined(_MSC_VER)
 #define FORCE_INLINE __forceinline
@@ -29,11 +33,19 @@
 
 namespace utility
 {
+	// Generational slot allocator.
+	//
+	// An id is made of a slot index (lower 32 bits) and the generation of that
+	//  slot (upper bits). Freed slots are recycled, but with a new generation,
+	//  so an id that has been freed never resolves again. Generations wrap at
+	//  20 bits which keeps every id exactly representable as a JS Number.
 	class unique_id
 	{
 		public:
-		typedef uint64_t              id_t;
-		typedef std::pair<id_t, id_t> range_t;
+		typedef uint64_t id_t;
+
+		static const id_t     invalid_id      = std::numeric_limits<id_t>::max();
+		static const uint32_t generation_bits = 20;
 
 		public:
 		unique_id();
@@ -45,139 +57,127 @@ namespace utility
 		bool is_allocated(id_t);
 		id_t count(bool count_free);
 
-		protected:
-		bool mark_used(id_t);
-		void mark_used_range(id_t, id_t);
-		bool mark_free(id_t);
-		void mark_free_range(id_t, id_t);
-
-		private:
-		std::list<range_t> allocated;
-	};
-
-	template<typename T>
-	class unique_object_manager
-	{
-		protected:
-		utility::unique_id                     id_generator;
-		std::map<utility::unique_id::id_t, T*> object_map;
-
-		public:
-		unique_object_manager() {}
-		~unique_object_manager() {}
-
-		utility::unique_id::id_t allocate(T* obj)
+		static inline uint32_t index_of(id_t id)
 		{
-			utility::unique_id::id_t uid = id_generator.allocate();
-			if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
-				return uid;
-			}
-			object_map.insert_or_assign(uid, obj);
-			return uid;
+			return uint32_t(id & 0xFFFFFFFFull);
 		}
 
-		utility::unique_id::id_t find(T* obj)
+		static inline uint32_t generation_of(id_t id)
 		{
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					return kv.first;
-				}
-			}
-			return std::numeric_limits<utility::unique_id::id_t>::max();
-		}
-		T* find(utility::unique_id::id_t id)
-		{
-			auto iter = object_map.find(id);
-			if (iter != object_map.end()) {
-				return iter->second;
-			}
-			return nullptr;
+			return uint32_t(id >> 32);
 		}
 
-		utility::unique_id::id_t free(T* obj)
-		{
-			utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					uid = kv.first;
-					object_map.erase(kv.first);
-					break;
-				}
-			}
-			return uid;
-		}
-		T* free(utility::unique_id::id_t id)
+		private:
+		struct slot_t
 		{
-			auto iter = object_map.find(id);
-			if (iter == object_map.end()) {
-				return nullptr;
-			}
-			T* obj = iter->second;
-			object_map.erase(iter);
-			return obj;
-		}
+			uint32_t generation = 0;
+			bool     used       = false;
+		};
+
+		std::vector<slot_t>   slots;
+		std::vector<uint32_t> free_slots;
+		id_t                  used_count = 0;
 	};
 
+	// Maps ids to objects and objects back to ids, both in O(1).
 	template<typename T>
 	class generic_object_manager
 	{
 		protected:
-		utility::unique_id                    id_generator;
-		std::map<utility::unique_id::id_t, T> object_map;
+		struct slot_t
+		{
+			utility::unique_id::id_t id  = utility::unique_id::invalid_id;
+			T                        obj = nullptr;
+		};
+
+		utility::unique_id                              id_generator;
+		std::vector<slot_t>                             object_slots;
+		std::unordered_map<T, utility::unique_id::id_t> object_index;
 
 		public:
 		generic_object_manager() {}
 		~generic_object_manager() {}
 
+		// An object has at most one id, allocating it again returns that id.
+		//  This keeps free(obj) from the destroy signal able to find the slot.
 		utility::unique_id::id_t allocate(T obj)
 		{
+			auto iter = object_index.find(obj);
+			if (iter != object_index.end()) {
+				return iter->second;
+			}
+
 			utility::unique_id::id_t uid = id_generator.allocate();
-			if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
+			if (uid == utility::unique_id::invalid_id) {
 				return uid;
 			}
-			object_map.insert_or_assign(uid, obj);
+
+			uint32_t idx = utility::unique_id::index_of(uid);
+			if (idx >= object_slots.size()) {
+				object_slots.resize(size_t(idx) + 1);
+			}
+			object_slots[idx].id  = uid;
+			object_slots[idx].obj = obj;
+			object_index[obj]     = uid;
 			return uid;
 		}
 
 		utility::unique_id::id_t find(T obj)
 		{
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					return kv.first;
-				}
+			auto iter = object_index.find(obj);
+			if (iter != object_index.end()) {
+				return iter->second;
 			}
-			return std::numeric_limits<utility::unique_id::id_t>::max();
+			return utility::unique_id::invalid_id;
 		}
 		T find(utility::unique_id::id_t id)
 		{
-			auto iter = object_map.find(id);
-			if (iter != object_map.end()) {
-				return iter->second;
+			uint32_t idx = utility::unique_id::index_of(id);
+			if ((idx < object_slots.size()) && (object_slots[idx].id == id)) {
+				return object_slots[idx].obj;
 			}
 			return nullptr;
 		}
 
 		utility::unique_id::id_t free(T obj)
 		{
-			utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-			for (auto kv : object_map) {
-				if (kv.second == obj) {
-					uid = kv.first;
-					object_map.erase(kv.first);
-					break;
-				}
+			utility::unique_id::id_t uid = find(obj);
+			if (uid != utility::unique_id::invalid_id) {
+				free(uid);
 			}
 			return uid;
 		}
 		T free(utility::unique_id::id_t id)
 		{
-			auto iter = object_map.find(id);
-			if (iter == object_map.end()) {
+			uint32_t idx = utility::unique_id::index_of(id);
+			if ((idx >= object_slots.size()) || (object_slots[idx].id != id)) {
 				return nullptr;
 			}
-			T obj = iter->second;
-			object_map.erase(iter);
+
+			T obj                 = object_slots[idx].obj;
+			object_slots[idx].id  = utility::unique_id::invalid_id;
+			object_slots[idx].obj = nullptr;
+			id_generator.free(id);
+
+			object_index.erase(obj);
 			return obj;
 		}
+
+		void for_each(std::function<void(utility::unique_id::id_t, T)> fn)
+		{
+			for (auto& slot : object_slots) {
+				if (slot.id != utility::unique_id::invalid_id) {
+					fn(slot.id, slot.obj);
+				}
+			}
+		}
+	};
+
+	template<typename T>
+	class unique_object_manager : public generic_object_manager<T*>
+	{
+		public:
+		unique_object_manager() {}
+		~unique_object_manager() {}
 	};
 } // namespace utility
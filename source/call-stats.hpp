@@ -0,0 +1,356 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <deque>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ipc-batch.hpp"
+
+namespace osn
+{
+	namespace callstats
+	{
+		// Histogram bucket n counts values in [2^n, 2^(n+1)), microseconds for
+		//  latency and bytes for payload size. The first and the last bucket are
+		//  open ended.
+		static const uint32_t buckets = 24;
+
+		// Number of sampled calls kept for the trace dump.
+		static const size_t sample_capacity = 4096;
+
+		inline uint32_t bucket_for(uint64_t value)
+		{
+			uint32_t bucket = 0;
+			while (value > 1 && bucket < buckets - 1) {
+				value >>= 1;
+				bucket++;
+			}
+			return bucket;
+		}
+
+		// Approximate wire size of a call's arguments or results.
+		inline uint64_t payload_size(const std::vector<ipc::value>& values)
+		{
+			uint64_t size = 0;
+			for (const ipc::value& v : values)
+				size += 1 + sizeof(v.value_union) + v.value_str.size() + v.value_bin.size();
+			return size;
+		}
+
+		struct snapshot
+		{
+			std::string collection;
+			std::string function;
+			uint64_t    calls;
+			uint64_t    errors;
+			uint64_t    total_ns;
+			uint64_t    max_ns;
+			uint64_t    bytes_in;
+			uint64_t    bytes_out;
+			uint64_t    latency[buckets];
+			uint64_t    size[buckets];
+		};
+
+		struct sample
+		{
+			uint64_t    timestamp;
+			std::string collection;
+			std::string function;
+			uint64_t    duration_ns;
+			uint64_t    bytes_in;
+			uint64_t    bytes_out;
+		};
+
+		// Counters of a single function, only relaxed atomics on the hot path.
+		struct counters
+		{
+			std::atomic<uint64_t> calls{0};
+			std::atomic<uint64_t> errors{0};
+			std::atomic<uint64_t> total_ns{0};
+			std::atomic<uint64_t> max_ns{0};
+			std::atomic<uint64_t> bytes_in{0};
+			std::atomic<uint64_t> bytes_out{0};
+			std::atomic<uint64_t> latency[buckets];
+			std::atomic<uint64_t> size[buckets];
+
+			counters()
+			{
+				clear();
+			}
+
+			// Returns the call number, starting at 1.
+			uint64_t record(uint64_t duration_ns, uint64_t in, uint64_t out, bool error)
+			{
+				uint64_t call = calls.fetch_add(1, std::memory_order_relaxed) + 1;
+				if (error)
+					errors.fetch_add(1, std::memory_order_relaxed);
+				total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+				bytes_in.fetch_add(in, std::memory_order_relaxed);
+				bytes_out.fetch_add(out, std::memory_order_relaxed);
+				latency[bucket_for(duration_ns / 1000)].fetch_add(1, std::memory_order_relaxed);
+				size[bucket_for(in + out)].fetch_add(1, std::memory_order_relaxed);
+
+				uint64_t max = max_ns.load(std::memory_order_relaxed);
+				while (duration_ns > max
+				       && !max_ns.compare_exchange_weak(max, duration_ns, std::memory_order_relaxed)) {
+				}
+				return call;
+			}
+
+			void clear()
+			{
+				calls.store(0, std::memory_order_relaxed);
+				errors.store(0, std::memory_order_relaxed);
+				total_ns.store(0, std::memory_order_relaxed);
+				max_ns.store(0, std::memory_order_relaxed);
+				bytes_in.store(0, std::memory_order_relaxed);
+				bytes_out.store(0, std::memory_order_relaxed);
+				for (uint32_t idx = 0; idx < buckets; idx++) {
+					latency[idx].store(0, std::memory_order_relaxed);
+					size[idx].store(0, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		// Per function counters plus an optional sampled call trace. Entries are
+		//  never removed, so a reference from find() stays valid for the lifetime
+		//  of the registry.
+		class registry
+		{
+			struct entry
+			{
+				std::string collection;
+				std::string function;
+				counters    stats;
+			};
+
+			std::mutex                                    m_lock;
+			std::map<std::string, std::unique_ptr<entry>> m_entries;
+			std::atomic<uint32_t>                         m_sample_every{0};
+			std::mutex                                    m_samples_lock;
+			std::deque<sample>                            m_samples;
+
+			public:
+			counters& find(const std::string& collection, const std::string& function)
+			{
+				std::string                  key = collection + "." + function;
+				std::unique_lock<std::mutex> ul(m_lock);
+				std::unique_ptr<entry>&      e = m_entries[key];
+				if (!e) {
+					e.reset(new entry);
+					e->collection = collection;
+					e->function   = function;
+				}
+				return e->stats;
+			}
+
+			// Same as above for names that outlive the call, such as string
+			//  literals. Each thread remembers the entry by the addresses of the
+			//  names, so a repeated call site skips the lock and the map lookup
+			//  and only compares the names to be sure.
+			counters& find(const char* collection, const char* function)
+			{
+				struct slot
+				{
+					const registry* owner      = nullptr;
+					const char*     collection = nullptr;
+					const char*     function   = nullptr;
+					entry*          cached     = nullptr;
+				};
+				static thread_local slot cache[256];
+
+				uintptr_t hash = (reinterpret_cast<uintptr_t>(collection) >> 3)
+				                 ^ (reinterpret_cast<uintptr_t>(function) >> 3) * 31;
+				slot& s = cache[hash % 256];
+				if (s.owner == this && s.collection == collection && s.function == function
+				    && s.cached->collection == collection && s.cached->function == function)
+					return s.cached->stats;
+
+				std::string                  key = std::string(collection) + "." + function;
+				std::unique_lock<std::mutex> ul(m_lock);
+				std::unique_ptr<entry>&      e = m_entries[key];
+				if (!e) {
+					e.reset(new entry);
+					e->collection = collection;
+					e->function   = function;
+				}
+				s = slot{this, collection, function, e.get()};
+				return e->stats;
+			}
+
+			// Record every n-th call of each function in the trace, 0 disables it.
+			void set_sample_every(uint32_t n)
+			{
+				m_sample_every.store(n, std::memory_order_relaxed);
+			}
+
+			void record(
+			    counters&          stats,
+			    const std::string& collection,
+			    const std::string& function,
+			    uint64_t           timestamp,
+			    uint64_t           duration_ns,
+			    uint64_t           in,
+			    uint64_t           out,
+			    bool               error)
+			{
+				uint64_t call  = stats.record(duration_ns, in, out, error);
+				uint32_t every = m_sample_every.load(std::memory_order_relaxed);
+				if (every == 0 || (call % every) != 0)
+					return;
+
+				std::unique_lock<std::mutex> ul(m_samples_lock);
+				if (m_samples.size() == sample_capacity)
+					m_samples.pop_front();
+				m_samples.push_back(sample{timestamp, collection, function, duration_ns, in, out});
+			}
+
+			std::vector<snapshot> collect()
+			{
+				std::vector<snapshot>        result;
+				std::unique_lock<std::mutex> ul(m_lock);
+				result.reserve(m_entries.size());
+				for (auto& kv : m_entries) {
+					counters& c = kv.second->stats;
+					if (c.calls.load(std::memory_order_relaxed) == 0)
+						continue;
+
+					snapshot s;
+					s.collection = kv.second->collection;
+					s.function   = kv.second->function;
+					s.calls      = c.calls.load(std::memory_order_relaxed);
+					s.errors     = c.errors.load(std::memory_order_relaxed);
+					s.total_ns   = c.total_ns.load(std::memory_order_relaxed);
+					s.max_ns     = c.max_ns.load(std::memory_order_relaxed);
+					s.bytes_in   = c.bytes_in.load(std::memory_order_relaxed);
+					s.bytes_out  = c.bytes_out.load(std::memory_order_relaxed);
+					for (uint32_t idx = 0; idx < buckets; idx++) {
+						s.latency[idx] = c.latency[idx].load(std::memory_order_relaxed);
+						s.size[idx]    = c.size[idx].load(std::memory_order_relaxed);
+					}
+					result.push_back(s);
+				}
+				return result;
+			}
+
+			std::vector<sample> samples()
+			{
+				std::unique_lock<std::mutex> ul(m_samples_lock);
+				return std::vector<sample>(m_samples.begin(), m_samples.end());
+			}
+
+			void reset()
+			{
+				{
+					std::unique_lock<std::mutex> ul(m_lock);
+					for (auto& kv : m_entries)
+						kv.second->stats.clear();
+				}
+				std::unique_lock<std::mutex> ul(m_samples_lock);
+				m_samples.clear();
+			}
+		};
+
+		// Wire format: uint32 count, then per function: string collection,
+		//  string function, 6 uint64 counters, 'buckets' latency and 'buckets'
+		//  size counts.
+		inline std::vector<char> serialize_snapshots(const std::vector<snapshot>& snapshots)
+		{
+			std::vector<char> buffer;
+			batch::writer     w(buffer);
+			w.put_u32(uint32_t(snapshots.size()));
+			for (const snapshot& s : snapshots) {
+				w.put_string(s.collection.data(), s.collection.size());
+				w.put_string(s.function.data(), s.function.size());
+				for (uint64_t v : {s.calls, s.errors, s.total_ns, s.max_ns, s.bytes_in, s.bytes_out})
+					w.put(&v, sizeof(v));
+				w.put(s.latency, sizeof(s.latency));
+				w.put(s.size, sizeof(s.size));
+			}
+			return buffer;
+		}
+
+		inline bool deserialize_snapshots(const std::vector<char>& buffer, std::vector<snapshot>& snapshots)
+		{
+			batch::reader r(buffer);
+			uint32_t      count = 0;
+			if (!r.get_u32(count))
+				return false;
+
+			snapshots.clear();
+			for (uint32_t idx = 0; idx < count; idx++) {
+				snapshot s;
+				if (!r.get_string(s.collection) || !r.get_string(s.function))
+					return false;
+				for (uint64_t* v : {&s.calls, &s.errors, &s.total_ns, &s.max_ns, &s.bytes_in, &s.bytes_out}) {
+					if (!r.get(v, sizeof(*v)))
+						return false;
+				}
+				if (!r.get(s.latency, sizeof(s.latency)) || !r.get(s.size, sizeof(s.size)))
+					return false;
+				snapshots.push_back(s);
+			}
+			return true;
+		}
+
+		// Wire format: uint32 count, then per sample: uint64 timestamp, string
+		//  collection, string function, uint64 duration, bytes in and bytes out.
+		inline std::vector<char> serialize_samples(const std::vector<sample>& samples)
+		{
+			std::vector<char> buffer;
+			batch::writer     w(buffer);
+			w.put_u32(uint32_t(samples.size()));
+			for (const sample& s : samples) {
+				w.put(&s.timestamp, sizeof(s.timestamp));
+				w.put_string(s.collection.data(), s.collection.size());
+				w.put_string(s.function.data(), s.function.size());
+				w.put(&s.duration_ns, sizeof(s.duration_ns));
+				w.put(&s.bytes_in, sizeof(s.bytes_in));
+				w.put(&s.bytes_out, sizeof(s.bytes_out));
+			}
+			return buffer;
+		}
+
+		inline bool deserialize_samples(const std::vector<char>& buffer, std::vector<sample>& samples)
+		{
+			batch::reader r(buffer);
+			uint32_t      count = 0;
+			if (!r.get_u32(count))
+				return false;
+
+			samples.clear();
+			for (uint32_t idx = 0; idx < count; idx++) {
+				sample s;
+				if (!r.get(&s.timestamp, sizeof(s.timestamp)) || !r.get_string(s.collection)
+				    || !r.get_string(s.function) || !r.get(&s.duration_ns, sizeof(s.duration_ns))
+				    || !r.get(&s.bytes_in, sizeof(s.bytes_in)) || !r.get(&s.bytes_out, sizeof(s.bytes_out)))
+					return false;
+				samples.push_back(s);
+			}
+			return true;
+		}
+	} // namespace callstats
+} // namespace osn
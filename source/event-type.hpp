@@ -0,0 +1,43 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <inttypes.h>
+
+// Type tag of every event delivered by Events.Poll. Each event is a list of
+//  ipc::value with the tag as UInt32 in front, followed by the payload below.
+//  Poll also returns, as UInt64, how many events the server dropped so far.
+enum class EventType : uint32_t
+{
+	// String source name, then String name, String description, UInt64 id for
+	//  every hotkey the source registered.
+	SourceHotkeys,
+
+	// String output type, String signal, Int32 code, String error message.
+	OutputSignal,
+
+	// String event, String description, Double percentage.
+	AutoConfig,
+
+	// Binary packed level frames, see volmeter-frame.hpp.
+	VolMeter,
+
+	// Add new items at the end, not in between.
+};
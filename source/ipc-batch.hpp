@@ -0,0 +1,264 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include "ipc-value.hpp"
+
+namespace osn
+{
+	namespace batch
+	{
+		// Wire format of Batch.Execute, all integers are fixed width and in host
+		//  (little) endian order.
+		//
+		// Request:  uint32 count, then per call: string collection, string
+		//           function, uint32 argc, argc values.
+		// Response: uint32 count, then per call: uint32 valc, valc values.
+		//
+		// A value is a uint8 ipc::type followed by its payload: nothing for Null,
+		//  4 or 8 bytes for numbers and a uint32 length plus the raw bytes for
+		//  String and Binary.
+		struct call
+		{
+			std::string             collection;
+			std::string             function;
+			std::vector<ipc::value> args;
+		};
+
+		class writer
+		{
+			std::vector<char>& m_buffer;
+
+			public:
+			writer(std::vector<char>& buffer) : m_buffer(buffer) {}
+
+			void put(const void* data, size_t size)
+			{
+				size_t offset = m_buffer.size();
+				m_buffer.resize(offset + size);
+				if (size)
+					std::memcpy(m_buffer.data() + offset, data, size);
+			}
+
+			void put_u32(uint32_t v)
+			{
+				put(&v, sizeof(v));
+			}
+
+			void put_string(const char* data, size_t size)
+			{
+				put_u32(uint32_t(size));
+				put(data, size);
+			}
+
+			void put_value(const ipc::value& v)
+			{
+				uint8_t t = uint8_t(v.type);
+				put(&t, sizeof(t));
+				switch (v.type) {
+				case ipc::type::Null:
+					break;
+				case ipc::type::Float:
+					put(&v.value_union.fp32, sizeof(v.value_union.fp32));
+					break;
+				case ipc::type::Double:
+					put(&v.value_union.fp64, sizeof(v.value_union.fp64));
+					break;
+				case ipc::type::Int32:
+					put(&v.value_union.i32, sizeof(v.value_union.i32));
+					break;
+				case ipc::type::Int64:
+					put(&v.value_union.i64, sizeof(v.value_union.i64));
+					break;
+				case ipc::type::UInt32:
+					put(&v.value_union.ui32, sizeof(v.value_union.ui32));
+					break;
+				case ipc::type::UInt64:
+					put(&v.value_union.ui64, sizeof(v.value_union.ui64));
+					break;
+				case ipc::type::String:
+					put_string(v.value_str.data(), v.value_str.size());
+					break;
+				case ipc::type::Binary:
+					put_string(v.value_bin.data(), v.value_bin.size());
+					break;
+				}
+			}
+
+			void put_values(const std::vector<ipc::value>& values)
+			{
+				put_u32(uint32_t(values.size()));
+				for (const ipc::value& v : values)
+					put_value(v);
+			}
+		};
+
+		class reader
+		{
+			const char* m_cursor;
+			const char* m_end;
+
+			public:
+			reader(const std::vector<char>& buffer) : m_cursor(buffer.data()), m_end(buffer.data() + buffer.size())
+			{}
+
+			bool get(void* data, size_t size)
+			{
+				if (size_t(m_end - m_cursor) < size)
+					return false;
+				if (size)
+					std::memcpy(data, m_cursor, size);
+				m_cursor += size;
+				return true;
+			}
+
+			bool get_u32(uint32_t& v)
+			{
+				return get(&v, sizeof(v));
+			}
+
+			size_t remaining() const
+			{
+				return size_t(m_end - m_cursor);
+			}
+
+			// Reads an element count and rejects it if 'count' records of at
+			//  least 'min_record_size' bytes cannot fit in what is left, so a
+			//  corrupt count never drives a huge allocation.
+			bool get_count(uint32_t& count, size_t min_record_size)
+			{
+				if (!get_u32(count))
+					return false;
+				return uint64_t(count) * min_record_size <= uint64_t(remaining());
+			}
+
+			template<typename T>
+			bool get_string(T& v)
+			{
+				uint32_t size = 0;
+				if (!get_u32(size) || (size_t(m_end - m_cursor) < size))
+					return false;
+				v.assign(m_cursor, m_cursor + size);
+				m_cursor += size;
+				return true;
+			}
+
+			bool get_value(ipc::value& v)
+			{
+				uint8_t t = 0;
+				if (!get(&t, sizeof(t)))
+					return false;
+
+				v.type = ipc::type(t);
+				switch (v.type) {
+				case ipc::type::Null:
+					return true;
+				case ipc::type::Float:
+					return get(&v.value_union.fp32, sizeof(v.value_union.fp32));
+				case ipc::type::Double:
+					return get(&v.value_union.fp64, sizeof(v.value_union.fp64));
+				case ipc::type::Int32:
+					return get(&v.value_union.i32, sizeof(v.value_union.i32));
+				case ipc::type::Int64:
+					return get(&v.value_union.i64, sizeof(v.value_union.i64));
+				case ipc::type::UInt32:
+					return get(&v.value_union.ui32, sizeof(v.value_union.ui32));
+				case ipc::type::UInt64:
+					return get(&v.value_union.ui64, sizeof(v.value_union.ui64));
+				case ipc::type::String:
+					return get_string(v.value_str);
+				case ipc::type::Binary:
+					return get_string(v.value_bin);
+				}
+				return false;
+			}
+
+			bool get_values(std::vector<ipc::value>& values)
+			{
+				// Every value carries at least its type byte.
+				uint32_t count = 0;
+				if (!get_count(count, sizeof(uint8_t)))
+					return false;
+				values.resize(count);
+				for (ipc::value& v : values) {
+					if (!get_value(v))
+						return false;
+				}
+				return true;
+			}
+		};
+
+		inline std::vector<char> serialize_calls(const std::vector<call>& calls)
+		{
+			std::vector<char> buffer;
+			writer            w(buffer);
+			w.put_u32(uint32_t(calls.size()));
+			for (const call& c : calls) {
+				w.put_string(c.collection.data(), c.collection.size());
+				w.put_string(c.function.data(), c.function.size());
+				w.put_values(c.args);
+			}
+			return buffer;
+		}
+
+		inline bool deserialize_calls(const std::vector<char>& buffer, std::vector<call>& calls)
+		{
+			reader   r(buffer);
+			uint32_t count = 0;
+			// Collection, function and argument count are 4 bytes each at least.
+			if (!r.get_count(count, 3 * sizeof(uint32_t)))
+				return false;
+			calls.resize(count);
+			for (call& c : calls) {
+				if (!r.get_string(c.collection) || !r.get_string(c.function) || !r.get_values(c.args))
+					return false;
+			}
+			return true;
+		}
+
+		inline std::vector<char> serialize_results(const std::vector<std::vector<ipc::value>>& results)
+		{
+			std::vector<char> buffer;
+			writer            w(buffer);
+			w.put_u32(uint32_t(results.size()));
+			for (const std::vector<ipc::value>& rval : results)
+				w.put_values(rval);
+			return buffer;
+		}
+
+		inline bool deserialize_results(const std::vector<char>& buffer, std::vector<std::vector<ipc::value>>& results)
+		{
+			reader   r(buffer);
+			uint32_t count = 0;
+			if (!r.get_count(count, sizeof(uint32_t)))
+				return false;
+			results.resize(count);
+			for (std::vector<ipc::value>& rval : results) {
+				if (!r.get_values(rval))
+					return false;
+			}
+			return true;
+		}
+	} // namespace batch
+} // namespace osn
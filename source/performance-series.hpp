@@ -0,0 +1,92 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <inttypes.h>
+#include <stddef.h>
+
+namespace osn
+{
+	// Metrics recorded by the server side performance sampler, in series order.
+	enum class PerformanceMetric : uint32_t
+	{
+		CPU,                 // Process CPU usage in percent.
+		DroppedFrames,       // Frames dropped by the streaming output so far.
+		DroppedPercentage,   // Share of streaming frames dropped, in percent.
+		Bandwidth,           // Streaming output bitrate in kbit/s.
+		FrameRate,           // Active render frame rate.
+		LaggedFrames,        // Frames the renderer lagged behind during the interval.
+		SkippedFrames,       // Frames the video output skipped during the interval.
+		RecordingBytes,      // Bytes written by the recording output so far.
+		StreamingCongestion, // Streaming output congestion, 0 to 1.
+		RecordingCongestion, // Recording output congestion, 0 to 1.
+
+		Count
+	};
+
+	// Payload of Performance.Query:
+	//  PerformanceSeriesHeader
+	//  uint64 timestamps[samples], milliseconds since sampling started
+	//  for each of 'metrics': PerformanceSummary, then double values[samples]
+	struct PerformanceSeriesHeader
+	{
+		uint32_t metrics;
+		uint32_t samples;
+		uint32_t interval; // Sampling interval in milliseconds.
+		uint32_t reserved;
+	};
+	static_assert(sizeof(PerformanceSeriesHeader) == 16, "PerformanceSeriesHeader must be tightly packed.");
+
+	struct PerformanceSummary
+	{
+		double min, avg, p95, p99, max;
+	};
+	static_assert(sizeof(PerformanceSummary) == 40, "PerformanceSummary must be tightly packed.");
+
+	inline size_t PerformanceSeriesSize(uint32_t metrics, uint32_t samples)
+	{
+		return sizeof(PerformanceSeriesHeader) + (sizeof(uint64_t) * samples)
+		       + (metrics * (sizeof(PerformanceSummary) + (sizeof(double) * samples)));
+	}
+
+	// Nearest-rank percentiles, sorts 'values' in place.
+	inline PerformanceSummary SummarizePerformance(double* values, size_t count)
+	{
+		PerformanceSummary summary = {0, 0, 0, 0, 0};
+		if (count == 0)
+			return summary;
+
+		std::sort(values, values + count);
+		double sum = 0;
+		for (size_t idx = 0; idx < count; idx++)
+			sum += values[idx];
+
+		auto rank = [count](double p) { return std::min(count, size_t(std::ceil(p * count))) - 1; };
+
+		summary.min = values[0];
+		summary.avg = sum / count;
+		summary.p95 = values[rank(0.95)];
+		summary.p99 = values[rank(0.99)];
+		summary.max = values[count - 1];
+		return summary;
+	}
+} // namespace osn
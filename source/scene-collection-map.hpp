@@ -0,0 +1,51 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <inttypes.h>
+
+namespace osn
+{
+	// Id map returned by SceneCollection.Load.
+	//
+	// The buffer holds a uint32 source count and that many source records,
+	//  each followed by 'name_size' bytes of name, then a uint32 item count
+	//  and that many item records. Filters are listed right after the source
+	//  they belong to and carry its uid in 'parent_uid', every other source
+	//  has an invalid (all ones) parent.
+	struct SceneCollectionSource
+	{
+		uint64_t uid;
+		uint64_t parent_uid;
+		uint32_t type; // obs_source_type
+		uint32_t name_size;
+	};
+	static_assert(sizeof(SceneCollectionSource) == 24, "SceneCollectionSource must be tightly packed.");
+
+	// 'uid' is a leased scene item id, 'item_id' the libobs scene item id.
+	struct SceneCollectionItem
+	{
+		uint64_t uid;
+		uint64_t scene_uid;
+		uint64_t source_uid;
+		int64_t  item_id;
+	};
+	static_assert(sizeof(SceneCollectionItem) == 32, "SceneCollectionItem must be tightly packed.");
+} // namespace osn
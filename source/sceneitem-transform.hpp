@@ -0,0 +1,55 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <inttypes.h>
+
+namespace osn
+{
+	// Packed transform record as produced by Scene.GetItemsTransforms and
+	//  consumed by Scene.SetItemsTransforms.
+	//
+	// The buffer is a plain array of these records, one per scene item. The
+	//  fields mirror obs_transform_info plus obs_sceneitem_crop, visibility and
+	//  selection. 'item_id' is the libobs scene item id and is ignored on write.
+	struct SceneItemTransform
+	{
+		uint64_t uid;
+		int64_t  item_id;
+		float    pos_x;
+		float    pos_y;
+		float    rot;
+		float    scale_x;
+		float    scale_y;
+		uint32_t alignment;
+		uint32_t bounds_type;
+		uint32_t bounds_alignment;
+		float    bounds_x;
+		float    bounds_y;
+		int32_t  crop_left;
+		int32_t  crop_top;
+		int32_t  crop_right;
+		int32_t  crop_bottom;
+		uint8_t  visible;
+		uint8_t  selected;
+		uint8_t  reserved[6];
+	};
+	static_assert(sizeof(SceneItemTransform) == 80, "SceneItemTransform must be tightly packed.");
+} // namespace osn
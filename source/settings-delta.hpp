@@ -0,0 +1,253 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+namespace osn
+{
+	namespace settings_delta
+	{
+		// Wire format of Source.UpdateDelta, a partial settings object that is
+		//  applied key by key instead of going through JSON.
+		//
+		// All integers are fixed width and in host (little) endian order:
+		//
+		// Header: uint32 magic, uint32 version, then an object.
+		// Object: uint32 entry count, entries.
+		// Entry:  uint8 type, string key, then the value: int64 for Int, double
+		//         for Double, uint8 for Bool, a string for String and another
+		//         object for Object.
+		//
+		// A string is a uint32 length followed by the raw bytes. A nested object
+		//  replaces the previous value of its key as a whole, the same way
+		//  obs_source_update treats objects.
+		static const uint32_t magic   = 0x544C4453; // "SDLT"
+		static const uint32_t version = 1;
+
+		// Deeper nesting than this is rejected instead of recursing on it.
+		static const uint32_t max_depth = 32;
+
+		enum class type : uint8_t
+		{
+			Int    = 0,
+			Double = 1,
+			Bool   = 2,
+			String = 3,
+			Object = 4,
+		};
+
+		struct entry
+		{
+			type               kind = type::Int;
+			std::string        key;
+			int64_t            i    = 0;
+			double             d    = 0;
+			bool               b    = false;
+			std::string        s;
+			std::vector<entry> object;
+		};
+
+		class writer
+		{
+			std::vector<char>& m_buffer;
+
+			void put(const void* data, size_t size)
+			{
+				size_t offset = m_buffer.size();
+				m_buffer.resize(offset + size);
+				if (size)
+					std::memcpy(m_buffer.data() + offset, data, size);
+			}
+
+			void put_u32(uint32_t v)
+			{
+				put(&v, sizeof(v));
+			}
+
+			void put_string(const char* data, size_t size)
+			{
+				put_u32(uint32_t(size));
+				put(data, size);
+			}
+
+			void put_key(type kind, const std::string& key)
+			{
+				uint8_t t = uint8_t(kind);
+				put(&t, sizeof(t));
+				put_string(key.data(), key.size());
+			}
+
+			public:
+			writer(std::vector<char>& buffer) : m_buffer(buffer) {}
+
+			void put_header()
+			{
+				put_u32(magic);
+				put_u32(version);
+			}
+
+			// Objects are written count first, but the count is only known once
+			//  all entries are in. Keep the returned offset for end_object.
+			size_t begin_object()
+			{
+				size_t offset = m_buffer.size();
+				put_u32(0);
+				return offset;
+			}
+
+			void end_object(size_t offset, uint32_t count)
+			{
+				std::memcpy(m_buffer.data() + offset, &count, sizeof(count));
+			}
+
+			void put_int(const std::string& key, int64_t v)
+			{
+				put_key(type::Int, key);
+				put(&v, sizeof(v));
+			}
+
+			void put_double(const std::string& key, double v)
+			{
+				put_key(type::Double, key);
+				put(&v, sizeof(v));
+			}
+
+			void put_bool(const std::string& key, bool v)
+			{
+				uint8_t b = v ? 1 : 0;
+				put_key(type::Bool, key);
+				put(&b, sizeof(b));
+			}
+
+			void put_string(const std::string& key, const char* data, size_t size)
+			{
+				put_key(type::String, key);
+				put_string(data, size);
+			}
+
+			// Follow with the entries of the object and end_object.
+			size_t begin_object(const std::string& key)
+			{
+				put_key(type::Object, key);
+				return begin_object();
+			}
+		};
+
+		class reader
+		{
+			const char* m_cursor;
+			const char* m_end;
+
+			bool get(void* data, size_t size)
+			{
+				if (size_t(m_end - m_cursor) < size)
+					return false;
+				std::memcpy(data, m_cursor, size);
+				m_cursor += size;
+				return true;
+			}
+
+			bool get_string(std::string& v)
+			{
+				uint32_t size = 0;
+				if (!get(&size, sizeof(size)) || (size_t(m_end - m_cursor) < size))
+					return false;
+				v.assign(m_cursor, size);
+				m_cursor += size;
+				return true;
+			}
+
+			public:
+			reader(const char* data, size_t size) : m_cursor(data), m_end(data + size) {}
+
+			bool at_end() const
+			{
+				return m_cursor == m_end;
+			}
+
+			bool get_header()
+			{
+				uint32_t m = 0, v = 0;
+				return get(&m, sizeof(m)) && (m == magic) && get(&v, sizeof(v)) && (v == version);
+			}
+
+			bool get_object(std::vector<entry>& entries, uint32_t depth = 0)
+			{
+				uint32_t count = 0;
+				if ((depth >= max_depth) || !get(&count, sizeof(count)))
+					return false;
+
+				// Every entry needs at least a type and a key length, which bounds
+				//  the reservation by what the buffer can actually hold.
+				size_t left = size_t(m_end - m_cursor);
+				if (count > left / (sizeof(uint8_t) + sizeof(uint32_t)))
+					return false;
+
+				entries.resize(count);
+				for (entry& e : entries) {
+					uint8_t t = 0;
+					if (!get(&t, sizeof(t)) || !get_string(e.key))
+						return false;
+
+					e.kind = type(t);
+					switch (e.kind) {
+					case type::Int:
+						if (!get(&e.i, sizeof(e.i)))
+							return false;
+						break;
+					case type::Double:
+						if (!get(&e.d, sizeof(e.d)))
+							return false;
+						break;
+					case type::Bool: {
+						uint8_t b = 0;
+						if (!get(&b, sizeof(b)))
+							return false;
+						e.b = (b != 0);
+						break;
+					}
+					case type::String:
+						if (!get_string(e.s))
+							return false;
+						break;
+					case type::Object:
+						if (!get_object(e.object, depth + 1))
+							return false;
+						break;
+					default:
+						return false;
+					}
+				}
+				return true;
+			}
+		};
+
+		// Returns false if the buffer is not a complete delta of this version.
+		inline bool decode(const char* data, size_t size, std::vector<entry>& entries)
+		{
+			reader r(data, size);
+			return r.get_header() && r.get_object(entries) && r.at_end();
+		}
+	} // namespace settings_delta
+} // namespace osn
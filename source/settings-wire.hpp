@@ -0,0 +1,336 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+namespace osn
+{
+	namespace settings_wire
+	{
+		// Wire format of OBS_settings_getSettings and OBS_settings_saveSettings.
+		//
+		// All integers are fixed width and little endian, so the layout does not
+		//  depend on the size_t of either process:
+		//
+		// Header:      uint32 magic, uint32 version, uint32 subcategory count.
+		// Subcategory: string name, uint32 parameter count, parameters.
+		// Parameter:   string name, string description, string type, string
+		//              subType, uint8 flags, string currentValue, uint32 value
+		//              count, string values.
+		//
+		// A string is a uint32 length followed by the raw bytes. The values blob
+		//  keeps its list encoding: per item a uint64 length and the name, then an
+		//  int64, a double or another uint64 length and string depending on the
+		//  subType of the parameter.
+		static const uint32_t magic   = 0x4E534F53; // "SOSN"
+		static const uint32_t version = 1;
+
+		// Smallest encoded subcategory and parameter, all strings empty.
+		static const size_t min_subcategory_size = 2 * sizeof(uint32_t);
+		static const size_t min_parameter_size   = 7 * sizeof(uint32_t) + sizeof(uint8_t);
+
+		enum flags : uint8_t
+		{
+			Enabled = 1 << 0,
+			Masked  = 1 << 1,
+			Visible = 1 << 2,
+		};
+
+		// Subsystems reported back by OBS_settings_saveSettingsPatch when a patch
+		//  had to reset or reload them.
+		enum reset : uint32_t
+		{
+			Video   = 1 << 0,
+			Audio   = 1 << 1,
+			Encoder = 1 << 2,
+			Service = 1 << 3,
+		};
+
+		// Non-owning reference into a received buffer.
+		struct view
+		{
+			const char* data = nullptr;
+			uint32_t    size = 0;
+
+			std::string str() const
+			{
+				return std::string(data, size);
+			}
+
+			bool operator==(const char* other) const
+			{
+				return (std::strlen(other) == size) && (std::memcmp(data, other, size) == 0);
+			}
+		};
+
+		struct parameter_view
+		{
+			view     name;
+			view     description;
+			view     type;
+			view     subType;
+			uint8_t  flags = 0;
+			view     currentValue;
+			uint32_t countValues = 0;
+			view     values;
+		};
+
+		// Writes into a buffer that was sized with measure(), no reallocation.
+		class writer
+		{
+			char* m_cursor;
+
+			public:
+			writer(char* data) : m_cursor(data) {}
+
+			void put(const void* data, size_t size)
+			{
+				if (size)
+					std::memcpy(m_cursor, data, size);
+				m_cursor += size;
+			}
+
+			void put_u8(uint8_t v)
+			{
+				*m_cursor++ = char(v);
+			}
+
+			void put_u32(uint32_t v)
+			{
+				m_cursor[0] = char(v);
+				m_cursor[1] = char(v >> 8);
+				m_cursor[2] = char(v >> 16);
+				m_cursor[3] = char(v >> 24);
+				m_cursor += sizeof(v);
+			}
+
+			void put_string(const char* data, size_t size)
+			{
+				put_u32(uint32_t(size));
+				put(data, size);
+			}
+		};
+
+		class reader
+		{
+			const char* m_cursor;
+			const char* m_end;
+
+			public:
+			reader(const char* data, size_t size) : m_cursor(data), m_end(data + size) {}
+			reader(const view& v) : reader(v.data, v.size) {}
+
+			bool at_end() const
+			{
+				return m_cursor == m_end;
+			}
+
+			size_t remaining() const
+			{
+				return size_t(m_end - m_cursor);
+			}
+
+			// Reads an element count and rejects it if 'count' records of at
+			//  least 'min_record_size' bytes cannot fit in what is left.
+			bool get_count(uint32_t& count, size_t min_record_size)
+			{
+				if (!get_u32(count))
+					return false;
+				return uint64_t(count) * min_record_size <= uint64_t(remaining());
+			}
+
+			bool get_u8(uint8_t& v)
+			{
+				if (m_cursor == m_end)
+					return false;
+				v = uint8_t(*m_cursor++);
+				return true;
+			}
+
+			bool get_u32(uint32_t& v)
+			{
+				if (size_t(m_end - m_cursor) < sizeof(v))
+					return false;
+				const uint8_t* p = reinterpret_cast<const uint8_t*>(m_cursor);
+				v = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+				m_cursor += sizeof(v);
+				return true;
+			}
+
+			bool get_u64(uint64_t& v)
+			{
+				uint32_t lo = 0, hi = 0;
+				if (!get_u32(lo) || !get_u32(hi))
+					return false;
+				v = uint64_t(lo) | (uint64_t(hi) << 32);
+				return true;
+			}
+
+			bool get_i64(int64_t& v)
+			{
+				uint64_t u = 0;
+				if (!get_u64(u))
+					return false;
+				v = int64_t(u);
+				return true;
+			}
+
+			bool get_f64(double& v)
+			{
+				uint64_t u = 0;
+				if (!get_u64(u))
+					return false;
+				std::memcpy(&v, &u, sizeof(v));
+				return true;
+			}
+
+			// Reference the next 'size' bytes without copying them.
+			bool get_view(view& v, uint64_t size)
+			{
+				if (uint64_t(m_end - m_cursor) < size)
+					return false;
+				v.data = m_cursor;
+				v.size = uint32_t(size);
+				m_cursor += size;
+				return true;
+			}
+
+			bool get_string(view& v)
+			{
+				uint32_t size = 0;
+				return get_u32(size) && get_view(v, size);
+			}
+		};
+
+		template<typename ParameterT>
+		inline size_t measure_parameter(const ParameterT& param)
+		{
+			return sizeof(uint32_t) * 7 + sizeof(uint8_t) + param.name.size() + param.description.size()
+			       + param.type.size() + param.subType.size() + param.currentValue.size() + param.values.size();
+		}
+
+		template<typename SubCategoryT>
+		inline size_t measure(const std::vector<SubCategoryT>& categories)
+		{
+			size_t size = sizeof(uint32_t) * 3;
+			for (const SubCategoryT& sc : categories) {
+				size += sizeof(uint32_t) * 2 + sc.name.size();
+				for (const auto& param : sc.params)
+					size += measure_parameter(param);
+			}
+			return size;
+		}
+
+		// Serializes 'categories' into 'buffer' in a single pass.
+		template<typename SubCategoryT>
+		inline void encode(const std::vector<SubCategoryT>& categories, std::vector<char>& buffer)
+		{
+			buffer.resize(measure(categories));
+
+			writer w(buffer.data());
+			w.put_u32(magic);
+			w.put_u32(version);
+			w.put_u32(uint32_t(categories.size()));
+			for (const SubCategoryT& sc : categories) {
+				w.put_string(sc.name.data(), sc.name.size());
+				w.put_u32(uint32_t(sc.params.size()));
+				for (const auto& param : sc.params) {
+					w.put_string(param.name.data(), param.name.size());
+					w.put_string(param.description.data(), param.description.size());
+					w.put_string(param.type.data(), param.type.size());
+					w.put_string(param.subType.data(), param.subType.size());
+					w.put_u8(uint8_t(
+					    (param.enabled ? flags::Enabled : 0) | (param.masked ? flags::Masked : 0)
+					    | (param.visible ? flags::Visible : 0)));
+					w.put_string(param.currentValue.data(), param.currentValue.size());
+					w.put_u32(uint32_t(param.countValues));
+					w.put_string(param.values.data(), param.values.size());
+				}
+			}
+		}
+
+		// Returns false if the buffer is not a settings buffer of this version.
+		inline bool read_header(reader& r, uint32_t& count)
+		{
+			uint32_t m = 0, v = 0;
+			return r.get_u32(m) && (m == magic) && r.get_u32(v) && (v == version)
+			       && r.get_count(count, min_subcategory_size);
+		}
+
+		inline bool read_subcategory(reader& r, view& name, uint32_t& count)
+		{
+			return r.get_string(name) && r.get_count(count, min_parameter_size);
+		}
+
+		inline bool read_parameter(reader& r, parameter_view& param)
+		{
+			return r.get_string(param.name) && r.get_string(param.description) && r.get_string(param.type)
+			       && r.get_string(param.subType) && r.get_u8(param.flags) && r.get_string(param.currentValue)
+			       && r.get_u32(param.countValues) && r.get_string(param.values);
+		}
+
+		// Copies a whole buffer into owning structures, for code paths that keep
+		//  the settings around after the buffer is gone.
+		template<typename SubCategoryT>
+		inline bool decode(const char* data, size_t size, std::vector<SubCategoryT>& categories)
+		{
+			reader   r(data, size);
+			uint32_t count = 0;
+			if (!read_header(r, count))
+				return false;
+
+			categories.resize(count);
+			for (SubCategoryT& sc : categories) {
+				view     name;
+				uint32_t params = 0;
+				if (!read_subcategory(r, name, params))
+					return false;
+
+				sc.name        = name.str();
+				sc.paramsCount = params;
+				sc.params.resize(params);
+				for (auto& param : sc.params) {
+					parameter_view pv;
+					if (!read_parameter(r, pv))
+						return false;
+
+					param.name        = pv.name.str();
+					param.description = pv.description.str();
+					param.type        = pv.type.str();
+					param.subType     = pv.subType.str();
+					param.enabled     = (pv.flags & flags::Enabled) != 0;
+					param.masked      = (pv.flags & flags::Masked) != 0;
+					param.visible     = (pv.flags & flags::Visible) != 0;
+					param.currentValue.assign(pv.currentValue.data, pv.currentValue.data + pv.currentValue.size);
+					param.sizeOfCurrentValue = pv.currentValue.size;
+					param.values.assign(pv.values.data, pv.values.data + pv.values.size);
+					param.sizeOfValues = pv.values.size;
+					param.countValues  = pv.countValues;
+				}
+			}
+			return r.at_end();
+		}
+	} // namespace settings_wire
+} // namespace osn
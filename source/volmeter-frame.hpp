@@ -0,0 +1,46 @@
+// Copyright (c) 2017 - 2018 Streamlabs
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+
+namespace osn
+{
+	// Packed level frames, delivered as VolMeter events through Events.Poll and
+	//  returned by VolMeter.QueryAll.
+	//
+	// The buffer is a sequence of records, each record being a header followed
+	//  by three planar float32 arrays (magnitude, peak, input_peak) holding
+	//  'channels' entries each. Every record is a multiple of 4 bytes long so
+	//  the float arrays can be viewed in place.
+	struct VolMeterFrameHeader
+	{
+		uint64_t uid;
+		uint32_t channels;
+		uint32_t reserved;
+	};
+	static_assert(sizeof(VolMeterFrameHeader) == 16, "VolMeterFrameHeader must be tightly packed.");
+
+	inline size_t VolMeterFrameSize(uint32_t channels)
+	{
+		return sizeof(VolMeterFrameHeader) + (sizeof(float) * channels * 3);
+	}
+} // namespace osn
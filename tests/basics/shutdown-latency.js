@@ -0,0 +1,50 @@
+// Measures how long it takes from the Shutdown call until the server process is gone.
+
+const { uuid, obs, TestGroup } = require("../helpers/bootstrap.js");
+
+// disconnect() kills the server itself after 500ms, stay well below that.
+const maximumLatency = 250;
+const iterations = 5;
+
+let tg = new TestGroup();
+
+tg.addTest("Shutdown latency", (resolve, reject) => {
+	let latencies = [];
+
+	for (let i = 0; i < iterations; i++) {
+		let ipc_name = "obs" + uuid();
+
+		try {
+			obs.IPC.host(ipc_name);
+		} catch (e) {
+			reject("Failed to host server, " + e);
+			resolve(false);
+			return;
+		}
+
+		let begin = process.hrtime();
+		try {
+			obs.IPC.disconnect();
+		} catch (e) {
+			reject("Failed to disconnect, " + e);
+			resolve(false);
+			return;
+		}
+		let elapsed = process.hrtime(begin);
+		latencies.push(elapsed[0] * 1000 + elapsed[1] / 1000000);
+	}
+
+	let average = latencies.reduce((a, b) => a + b, 0) / latencies.length;
+	let worst = Math.max(...latencies);
+	console.log(">> Shutdown latency: average " + average.toFixed(2) + "ms, worst " + worst.toFixed(2) + "ms");
+
+	if (worst >= maximumLatency) {
+		reject("Server took " + worst.toFixed(2) + "ms to exit.");
+		resolve(false);
+		return;
+	}
+
+	resolve(true);
+});
+
+tg.run();